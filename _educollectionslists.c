@@ -10,6 +10,9 @@
 #include <Python.h>
 #include <structmember.h>
 #include "_educollectionsmodule.h"
+#ifdef MS_WINDOWS
+#include <malloc.h>
+#endif
 
 
 PyDoc_STRVAR(List_append_doc,
@@ -18,6 +21,12 @@ PyDoc_STRVAR(List_append_doc,
 PyDoc_STRVAR(List_clear_doc,
   "Clears this List.");
 
+PyDoc_STRVAR(List_extend_doc,
+  "Adds the items of the given iterable to the end of this List.");
+
+PyDoc_STRVAR(List_from_iterable_doc,
+  "Returns a new List holding the items of the given iterable.");
+
 PyDoc_STRVAR(List_get_doc,
   "Returns the item at the given index in this List.");
 
@@ -30,6 +39,23 @@ PyDoc_STRVAR(List_prepend_doc,
 PyDoc_STRVAR(List_remove_doc,
   "Removes and returns the item at the given index in this List.");
 
+PyDoc_STRVAR(List_remove_if_doc,
+  "Removes the items of this List for which the given predicate returns a\n"
+  "true value and returns how many were removed.  The predicate is called\n"
+  "once per item, in order, before anything is removed.  If it raises, the\n"
+  "items it picked so far are still removed; if it modifies this List,\n"
+  "RuntimeError is raised and nothing is removed.");
+
+PyDoc_STRVAR(List_retain_doc,
+  "Removes the items of this List for which the given predicate returns a\n"
+  "false value and returns how many were removed.  The predicate is called\n"
+  "once per item, in order, before anything is removed.  If it raises, the\n"
+  "items it picked so far are still removed; if it modifies this List,\n"
+  "RuntimeError is raised and nothing is removed.");
+
+PyDoc_STRVAR(List_reverse_doc,
+  "Reverses the order of the items of this List in place.");
+
 PyDoc_STRVAR(List_set_doc,
   "Assigns the given item at the given index in this List.");
 
@@ -37,407 +63,9299 @@ PyDoc_STRVAR(List_size_doc,
   "Returns the size of this List.");
 
 
-/* ArrayList
- * Fixed-size-array-based implementation of the List interface. */
-
+#if EDUCOLLECTIONS_STATS
+/* ListStats
+ * Per-instance operation counters for attributing latency to traversal,
+ * shifting and allocation cost.  Lists that keep them embed a ListStats
+ * named stats; it starts zeroed because tp_alloc zeroes the instance. */
 typedef struct {
-  PyObject_HEAD
-  Py_ssize_t capacity;
-  Py_ssize_t size;
-  PyObject   **data;
-} ArrayList;
+  Py_ssize_t walked;
+  Py_ssize_t shifted;
+  Py_ssize_t allocs;
+  Py_ssize_t frees;
+  Py_ssize_t peak_size;
+} ListStats;
 
-PyDoc_STRVAR(ArrayList_doc,
-  "Fixed-size-array-based implementation of the List interface.");
+#define LISTSTATS_ADD(self, field, n) ((self)->stats.field += (n))
+#define LISTSTATS_PEAK(self)                                              \
+  do {                                                                    \
+    if ((self)->size > (self)->stats.peak_size) {                         \
+      (self)->stats.peak_size = (self)->size;                             \
+    }                                                                     \
+  } while (0)
+
+PyDoc_STRVAR(List_stats_doc,
+  "Returns a dict of this List's operation counters: nodes walked to reach\n"
+  "an index, items shifted to open or close a gap, nodes (or data arrays)\n"
+  "allocated and freed, and the peak size.");
+
+PyDoc_STRVAR(List_reset_stats_doc,
+  "Zeroes this List's operation counters; the peak size restarts at the\n"
+  "current size.");
 
-/* ArrayListType.tp_new */
 static PyObject *
-ArrayList_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+ListStats_dict(ListStats *stats)
 {
-  ArrayList *self;
+  return Py_BuildValue("{s:n,s:n,s:n,s:n,s:n}",
+                       "walked", stats->walked,
+                       "shifted", stats->shifted,
+                       "allocs", stats->allocs,
+                       "frees", stats->frees,
+                       "peak_size", stats->peak_size);
+}
 
-  self = (ArrayList *)type->tp_alloc(type, 0);
-  if (self == NULL) {
-    return NULL;
-  }
-  self->capacity = -1;
-  self->size = -1;
-  self->data = NULL;
-  return (PyObject *)self;
+static void
+ListStats_reset(ListStats *stats, Py_ssize_t size)
+{
+  memset(stats, 0, sizeof(*stats));
+  stats->peak_size = size;
 }
+#else
+#define LISTSTATS_ADD(self, field, n) ((void)0)
+#define LISTSTATS_PEAK(self) ((void)0)
+#endif
 
-/* ArrayListType.tp_init */
+
+/* Calling conventions */
+
+/* Checks that a METH_FASTCALL method taking exactly n positional arguments
+ * received n. */
 static int
-ArrayList_init(ArrayList *self, PyObject *args, PyObject *kwds)
+List_check_nargs(const char *name, Py_ssize_t nargs, Py_ssize_t n)
 {
-  PyObject *capacityobj = NULL;
-  PyObject **data = NULL;
-  PyObject **tmp = NULL;
-  Py_ssize_t capacity = -1;
-  static char *kwlist[] = {"capacity", NULL};
-  int i;
-
-  if (! PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &capacityobj)) {
-    return -1;
-  }
-  if (capacityobj != NULL && capacityobj != Py_None) {
-    capacity = PyLong_AsSsize_t(capacityobj);
-    if (capacity == -1 && PyErr_Occurred()) {
-      return -1;
-    }
+  if (nargs != n) {
+    PyErr_Format(PyExc_TypeError, "%s expected %zd arguments, got %zd",
+                 name, n, nargs);
+    return 0;
   }
-  if (capacity < 1) {
-    PyErr_SetString(PyExc_ValueError, "capacity must be greater than zero");
-    return -1;
+  return 1;
+}
+
+/* Constructs type through the generic tp_new/tp_init path.  Vectorcall
+ * constructors hand off here for subclasses and for any argument list they
+ * do not parse themselves, so those cases keep their usual behaviour and
+ * error messages. */
+static PyObject *
+List_vectorcall_fallback(PyObject *type, PyObject *const *args,
+                         size_t nargsf, PyObject *kwnames)
+{
+  PyObject *argstuple, *kwargs = NULL, *result;
+  Py_ssize_t nargs, i;
+
+  nargs = PyVectorcall_NARGS(nargsf);
+  argstuple = PyTuple_New(nargs);
+  if (argstuple == NULL) {
+    return NULL;
   }
-  self->capacity = capacity;
-  self->size = 0;
-  data = PyMem_New(PyObject *, self->capacity);
-  if (data == NULL) {
-    PyErr_SetString(PyExc_MemoryError, "memory allocation request failed");
-    return -1;
+  for (i = 0; i < nargs; ++i) {
+    Py_INCREF(args[i]);
+    PyTuple_SET_ITEM(argstuple, i, args[i]);
   }
-  tmp = self->data;
-  Py_INCREF(data);
-  self->data = data;
-  Py_XDECREF(tmp);
-  for (i = 0; i < self->capacity; ++i) {
-    Py_INCREF(Py_None);
-    self->data[i] = Py_None;
+  if (kwnames != NULL && PyTuple_GET_SIZE(kwnames) > 0) {
+    kwargs = PyDict_New();
+    if (kwargs == NULL) {
+      Py_DECREF(argstuple);
+      return NULL;
+    }
+    for (i = 0; i < PyTuple_GET_SIZE(kwnames); ++i) {
+      if (PyDict_SetItem(kwargs, PyTuple_GET_ITEM(kwnames, i),
+                         args[nargs + i]) < 0) {
+        Py_DECREF(argstuple);
+        Py_DECREF(kwargs);
+        return NULL;
+      }
+    }
   }
-  return 0;
+  result = PyType_Type.tp_call(type, argstuple, kwargs);
+  Py_DECREF(argstuple);
+  Py_XDECREF(kwargs);
+  return result;
 }
 
-/* ArrayListType.tp_dealloc */
-static void
-ArrayList_dealloc(ArrayList *self)
+
+/* Sorting
+ * Shared by the sort() methods.  Items are compared through an lt function
+ * picked by a scan of the keys before sorting: when every key is a float,
+ * a str, or an int that fits in a C long, keys are compared directly
+ * instead of through rich comparison.  Any lt returns 1 if a < b, 0 if
+ * not, and -1 on error. */
+
+PyDoc_STRVAR(List_sort_doc,
+  "Sorts this List in place, stably and in ascending order of key(item),\n"
+  "or of the items themselves if key is None.  The keyword-only arguments\n"
+  "key and reverse work as in list.sort().");
+
+#define LISTSORT_MIN_RUN 32
+
+typedef int (*ListSort_lt)(PyObject *, PyObject *);
+
+typedef struct {
+  PyObject *key;
+  PyObject *value;
+} ListSortItem;
+
+static int
+ListSort_lt_generic(PyObject *a, PyObject *b)
 {
-  Py_XDECREF(self->data);
-  PyMem_Del(self->data);
-  Py_TYPE(self)->tp_free((PyObject*)self);
+  return PyObject_RichCompareBool(a, b, Py_LT);
 }
 
-/* ArrayList.append(item) */
-static PyObject *
-ArrayList_append(ArrayList *self, PyObject *item)
+static int
+ListSort_lt_float(PyObject *a, PyObject *b)
 {
-#if defined(NDEBUG)
-  if (self->size == self->capacity) {
-    PyErr_SetString(PyExc_RuntimeError, "ArrayList is full (capacity == size)");
-    return NULL;
-  }
-  if (item == NULL) {
-    PyErr_SetString(PyExc_ValueError, "item == NULL");
-    return NULL;
-  }
-#endif
-  Py_XDECREF(Py_None);
-  Py_INCREF(item);
-  self->data[self->size] = item;
-  self->size += 1;
-  Py_RETURN_NONE;
+  return PyFloat_AS_DOUBLE(a) < PyFloat_AS_DOUBLE(b);
 }
 
-PyDoc_STRVAR(ArrayList_capacity_doc,
-  "Returns the capacity of this ArrayList.");
+static int
+ListSort_lt_long(PyObject *a, PyObject *b)
+{
+  int overflow;
 
-/* ArrayList.capacity() */
-static PyObject *
-ArrayList_capacity(ArrayList *self)
+  return PyLong_AsLongAndOverflow(a, &overflow) <
+         PyLong_AsLongAndOverflow(b, &overflow);
+}
+
+static int
+ListSort_lt_str(PyObject *a, PyObject *b)
 {
-  return PyLong_FromSsize_t(self->capacity);
+  return PyUnicode_Compare(a, b) < 0;
 }
 
-/* ArrayList.clear() */
-static PyObject *
-ArrayList_clear(ArrayList *self)
+/* Returns the lt suited to key alone. */
+static ListSort_lt
+ListSort_lt_for(PyObject *key)
 {
-  PyObject *item;
-  int i;
+  long value;
+  int overflow;
 
-  for (i = 0; i < self->size; ++i) {
-      item = self->data[i];
-      Py_INCREF(Py_None);
-      self->data[i] = Py_None;
-      Py_XDECREF(item);
+  if (PyFloat_CheckExact(key)) {
+    return ListSort_lt_float;
   }
-  self->size = 0;
-  Py_RETURN_NONE;
+  if (PyUnicode_CheckExact(key)) {
+    return ListSort_lt_str;
+  }
+  if (PyLong_CheckExact(key)) {
+    value = PyLong_AsLongAndOverflow(key, &overflow);
+    if (!overflow && !(value == -1 && PyErr_Occurred())) {
+      return ListSort_lt_long;
+    }
+    PyErr_Clear();
+  }
+  return ListSort_lt_generic;
 }
 
-/* ArrayList.get(index) */
-static PyObject *
-ArrayList_get(ArrayList *self, PyObject *indexobj)
+/* Reverses items[0:n]. */
+static void
+ListSort_reverse(ListSortItem *items, Py_ssize_t n)
 {
-  Py_ssize_t index = -1;
-  PyObject *item;
+  ListSortItem tmp, *lo = items, *hi = items + n - 1;
 
-  if (indexobj != NULL && indexobj != Py_None) {
-  index = PyLong_AsSsize_t(indexobj);
-  if (index == -1 && PyErr_Occurred())
-    return NULL;
+  for (; lo < hi; ++lo, --hi) {
+    tmp = *lo;
+    *lo = *hi;
+    *hi = tmp;
   }
-#if defined(NDEBUG)
-  if (index < 0 || index >= self->capacity || index > self->size - 1) {
-    PyErr_SetString(PyExc_IndexError, "ArrayList index out of range");
-    return NULL;
+}
+
+/* Sorts items[lo:hi] by binary insertion, given that items[lo:start] is
+ * already sorted. */
+static int
+ListSort_binary_insertion(ListSortItem *items, Py_ssize_t lo, Py_ssize_t start,
+                          Py_ssize_t hi, ListSort_lt lt)
+{
+  ListSortItem pivot;
+  Py_ssize_t l, r, m;
+  int c;
+
+  for (; start < hi; ++start) {
+    pivot = items[start];
+    l = lo;
+    r = start;
+    while (l < r) {
+      m = l + (r - l) / 2;
+      c = lt(pivot.key, items[m].key);
+      if (c < 0) {
+        return -1;
+      }
+      if (c) {
+        r = m;
+      }
+      else {
+        l = m + 1;
+      }
+    }
+    memmove(items + l + 1, items + l, (start - l) * sizeof(ListSortItem));
+    items[l] = pivot;
   }
-#endif
-  item = self->data[index];
-  Py_INCREF(item);
-  return item;
+  return 0;
 }
 
-/* ArrayList.insert(index, item) */
-static PyObject *
-ArrayList_insert(ArrayList *self, PyObject *args)
+/* Returns the length of the run starting at items[lo], at most hi - lo,
+ * reversing it in place first if it is strictly descending, or -1 on
+ * error. */
+static Py_ssize_t
+ListSort_count_run(ListSortItem *items, Py_ssize_t lo, Py_ssize_t hi,
+                   ListSort_lt lt)
 {
-  PyObject *indexobj = NULL, *itemobj = NULL;
-  Py_ssize_t index = -1;
-  int i;
+  Py_ssize_t k = lo + 1;
+  int c;
 
-  if (self->size == self->capacity) {
-    PyErr_SetString(PyExc_RuntimeError, "ArrayList is full (capacity == size)");
-    return NULL;
+  if (k == hi) {
+    return 1;
   }
-  if (!PyArg_ParseTuple(args, "OO", &indexobj, &itemobj)) {
-    PyErr_SetString(PyExc_RuntimeError, "WTF");
-    return NULL;
+  c = lt(items[k].key, items[lo].key);
+  if (c < 0) {
+    return -1;
   }
-  if (indexobj != NULL && indexobj != Py_None) {
-    index = PyLong_AsSsize_t(indexobj);
-    if (index == -1 && PyErr_Occurred()) {
-      PyErr_SetString(PyExc_RuntimeError, "WTF");
-      return NULL;
+  if (c) {
+    for (++k; k < hi; ++k) {
+      c = lt(items[k].key, items[k - 1].key);
+      if (c < 0) {
+        return -1;
+      }
+      if (!c) {
+        break;
+      }
     }
+    ListSort_reverse(items + lo, k - lo);
   }
-  if (index < 0 || index >= self->capacity || index > self->size - 1) {
-    PyErr_SetString(PyExc_IndexError, "ArrayList index out of range");
-    return NULL;
-  }
-  if (itemobj == NULL) {
-    PyErr_SetString(PyExc_ValueError, "item == NULL");
-    return NULL;
-  }
-
-  Py_XDECREF(Py_None);
-  for (i = self->size; i > index; --i) {
-  self->data[i] = self->data[i-1];
+  else {
+    for (++k; k < hi; ++k) {
+      c = lt(items[k].key, items[k - 1].key);
+      if (c < 0) {
+        return -1;
+      }
+      if (c) {
+        break;
+      }
+    }
   }
-  Py_INCREF(itemobj);
-  self->data[index] = itemobj;
-  self->size += 1;
-  Py_RETURN_NONE;
+  return k - lo;
 }
 
-/* ArrayList.prepend(item) */
-static PyObject *
-ArrayList_prepend(ArrayList *self, PyObject *item)
+/* Merges the sorted runs items[lo:mid] and items[mid:hi], copying the left
+ * run out to tmp.  On error the unmerged part of the left run is copied
+ * back into the gap, so items stays a permutation. */
+static int
+ListSort_merge(ListSortItem *items, Py_ssize_t lo, Py_ssize_t mid,
+               Py_ssize_t hi, ListSortItem *tmp, ListSort_lt lt)
 {
-  int i;
-
-  if (self->size == self->capacity) {
-    PyErr_SetString(PyExc_RuntimeError, "ArrayList is full (capacity == size)");
-    return NULL;
-  }
+  Py_ssize_t i = 0, j = mid, k = lo, n = mid - lo;
+  int c;
 
-  if (item == NULL) {
-    PyErr_SetString(PyExc_ValueError, "item == NULL");
-    return NULL;
+  c = lt(items[mid].key, items[mid - 1].key);
+  if (c <= 0) {
+    return c;
   }
-
-  Py_XDECREF(Py_None);
-  for (i = self->size; i > 0; --i) {
-  self->data[i] = self->data[i-1];
+  memcpy(tmp, items + lo, n * sizeof(ListSortItem));
+  while (i < n && j < hi) {
+    c = lt(items[j].key, tmp[i].key);
+    if (c < 0) {
+      break;
+    }
+    items[k++] = c ? items[j++] : tmp[i++];
   }
-  Py_INCREF(item);
-  self->data[0] = item;
-  self->size += 1;
-  Py_RETURN_NONE;
+  memcpy(items + k, tmp + i, (n - i) * sizeof(ListSortItem));
+  return c < 0 ? -1 : 0;
 }
 
-/* ArrayList.remove(index) */
-static PyObject *
-ArrayList_remove(ArrayList *self, PyObject *indexobj)
+/* Sorts items[0:n] stably by key with a natural merge sort: existing runs
+ * are found and short ones extended to LISTSORT_MIN_RUN by binary
+ * insertion, then neighbouring runs are merged pairwise until one is
+ * left, so sorted or reversed input takes a single pass.  On error items
+ * is left as some permutation of its original contents. */
+static int
+ListSort_sort_items(ListSortItem *items, Py_ssize_t n)
 {
-  PyObject *old_item;
-  Py_ssize_t index = -1;
-  int j;
+  ListSortItem *tmp = NULL;
+  ListSort_lt lt;
+  Py_ssize_t *starts, nruns = 0, lo, len, force, i, r;
+  int result = -1;
 
-  if (indexobj != NULL && indexobj != Py_None) {
-    index = PyLong_AsSsize_t(indexobj);
-    if (index == -1 && PyErr_Occurred()) {
-      PyErr_SetString(PyExc_RuntimeError, "WTF");
-      return NULL;
+  if (n < 2) {
+    return 0;
+  }
+  lt = ListSort_lt_for(items[0].key);
+  for (i = 1; i < n && lt != ListSort_lt_generic; ++i) {
+    if (ListSort_lt_for(items[i].key) != lt) {
+      lt = ListSort_lt_generic;
     }
   }
-  if (index < 0 || index >= self->capacity || index > self->size - 1) {
-    PyErr_SetString(PyExc_IndexError, "ArrayList index out of range");
-    return NULL;
+  starts = PyMem_New(Py_ssize_t, n / LISTSORT_MIN_RUN + 2);
+  if (starts == NULL) {
+    PyErr_NoMemory();
+    return -1;
   }
-
-  old_item = self->data[index];
-  for (j = index; j < self->size - 1; ++j) {
-  self->data[j] = self->data[j+1];
+  for (lo = 0; lo < n; lo += len) {
+    len = ListSort_count_run(items, lo, n, lt);
+    if (len < 0) {
+      goto done;
+    }
+    if (len < LISTSORT_MIN_RUN) {
+      force = n - lo < LISTSORT_MIN_RUN ? n - lo : LISTSORT_MIN_RUN;
+      if (ListSort_binary_insertion(items, lo, lo + len, lo + force, lt) < 0) {
+        goto done;
+      }
+      len = force;
+    }
+    starts[nruns++] = lo;
   }
-  Py_INCREF(Py_None);
-  self->data[self->size-1] = Py_None;
-  self->size -= 1;
+  starts[nruns] = n;
+  if (nruns > 1) {
+    tmp = PyMem_New(ListSortItem, n);
+    if (tmp == NULL) {
+      PyErr_NoMemory();
+      goto done;
+    }
+  }
+  while (nruns > 1) {
+    for (i = 0, r = 0; i + 1 < nruns; i += 2, ++r) {
+      if (ListSort_merge(items, starts[i], starts[i + 1], starts[i + 2], tmp,
+                         lt) < 0) {
+        goto done;
+      }
+      starts[r] = starts[i];
+    }
+    if (i < nruns) {
+      starts[r++] = starts[i];
+    }
+    starts[r] = n;
+    nruns = r;
+  }
+  result = 0;
 
-  return old_item;
+done:
+  PyMem_Del(tmp);
+  PyMem_Del(starts);
+  return result;
 }
 
-/* ArrayList.set(index, item) */
-static PyObject *
-ArrayList_set(ArrayList *self, PyObject *args)
+/* Sorts values[0:n] in place by keyfunc(value), or by value if keyfunc is
+ * None, optionally in descending order.  As in list.sort, reverse sorting
+ * reverses, sorts and reverses again so equal items keep their order.  On
+ * error values is left as some permutation of its original contents. */
+static int
+ListSort_sort_values(PyObject **values, Py_ssize_t n, PyObject *keyfunc,
+                     int reverse)
 {
-  PyObject *indexobj = NULL;
-  PyObject *itemobj = NULL;
-  Py_ssize_t index = -1;
-  PyObject *old_value;
+  ListSortItem *items;
+  Py_ssize_t i, j;
+  int result;
 
-  if (!PyArg_ParseTuple(args, "OO", &indexobj, &itemobj)) {
-    PyErr_SetString(PyExc_IndexError, "WTF");
-    return NULL;
+  items = PyMem_New(ListSortItem, n > 0 ? n : 1);
+  if (items == NULL) {
+    PyErr_NoMemory();
+    return -1;
   }
-  if (indexobj != NULL && indexobj != Py_None) {
-    index = PyLong_AsSsize_t(indexobj);
-    if (index == -1 && PyErr_Occurred()) {
-      PyErr_SetString(PyExc_IndexError, "WTF");
-      return NULL;
+  for (i = 0; i < n; ++i) {
+    items[i].value = values[i];
+    if (keyfunc == Py_None) {
+      items[i].key = values[i];
+      continue;
+    }
+    items[i].key = PyObject_CallOneArg(keyfunc, values[i]);
+    if (items[i].key == NULL) {
+      for (j = 0; j < i; ++j) {
+        Py_DECREF(items[j].key);
+      }
+      PyMem_Del(items);
+      return -1;
     }
   }
-#if defined(NDEBUG)
-  if (index < 0 || index >= self->capacity || index > self->size - 1) {
-    PyErr_SetString(PyExc_IndexError, "ArrayList index out of range");
-    return NULL;
+  if (reverse) {
+    ListSort_reverse(items, n);
   }
-  if (itemobj == NULL) {
-    /* TODO(nkraft): del the item instead of error? */
-    PyErr_SetString(PyExc_ValueError, "item == NULL");
-    return NULL;
+  result = ListSort_sort_items(items, n);
+  if (reverse) {
+    ListSort_reverse(items, n);
   }
-#endif
-  Py_INCREF(itemobj);
-  old_value = self->data[index];
-  self->data[index] = itemobj;
-  Py_DECREF(old_value);
-  Py_RETURN_NONE;
+  for (i = 0; i < n; ++i) {
+    values[i] = items[i].value;
+    if (keyfunc != Py_None) {
+      Py_DECREF(items[i].key);
+    }
+  }
+  PyMem_Del(items);
+  return result;
 }
 
-/* ArrayList.size() */
-static PyObject *
-ArrayList_size(ArrayList *self)
+/* Parses the keyword-only key and reverse arguments of sort(). */
+static int
+ListSort_parse_args(PyObject *args, PyObject *kwds, PyObject **keyfuncp,
+                    int *reversep)
 {
-  return PyLong_FromSsize_t(self->size);
+  static char *kwlist[] = {"key", "reverse", NULL};
+
+  *keyfuncp = Py_None;
+  *reversep = 0;
+  return PyArg_ParseTupleAndKeywords(args, kwds, "|$Op:sort", kwlist,
+                                     keyfuncp, reversep);
 }
 
-/* ArrayListType.tp_repr */
-static PyObject *
-ArrayList_repr(PyObject *self)
-{
-  /* PyObject *aslist; */
+
+/* Searching
+ * Shared by the index_of(), contains() and count() methods.  Items are
+ * compared by identity before falling back to __eq__, as list does. */
+
+PyDoc_STRVAR(List_index_of_doc,
+  "Returns the index of the first item equal to the given item in this List,\n"
+  "searching from index start up to, but not including, index stop.  Raises\n"
+  "ValueError if there is no such item.");
+
+PyDoc_STRVAR(List_contains_doc,
+  "Returns whether this List holds an item equal to the given item.");
+
+PyDoc_STRVAR(List_count_doc,
+  "Returns the number of items in this List equal to the given item.");
+
+/* Returns 1 if a equals b, 0 if not, and -1 on error.  a is held for the
+ * comparison, since __eq__ may drop the List's reference to it. */
+static int
+List_item_eq(PyObject *a, PyObject *b)
+{
+  int cmp;
+
+  if (a == b) {
+    return 1;
+  }
+  Py_INCREF(a);
+  cmp = PyObject_RichCompareBool(a, b, Py_EQ);
+  Py_DECREF(a);
+  return cmp;
+}
+
+/* Returns 1 if predicate(item) is true, 0 if not, and -1 on error.  item is
+ * held for the call, since the predicate may drop the List's reference to
+ * it. */
+static int
+List_call_predicate(PyObject *predicate, PyObject *item)
+{
+  PyObject *result;
+  int truth;
+
+  Py_INCREF(item);
+  result = PyObject_CallOneArg(predicate, item);
+  Py_DECREF(item);
+  if (result == NULL) {
+    return -1;
+  }
+  truth = PyObject_IsTrue(result);
+  Py_DECREF(result);
+  return truth;
+}
+
+/* Parses the (item[, start[, stop]]) arguments of index_of() and clips
+ * start and stop to a List of the given size as list.index() does. */
+static int
+List_parse_index_of_args(PyObject *args, Py_ssize_t size, PyObject **itemp,
+                         Py_ssize_t *startp, Py_ssize_t *stopp)
+{
+  *startp = 0;
+  *stopp = PY_SSIZE_T_MAX;
+  if (!PyArg_ParseTuple(args, "O|nn:index_of", itemp, startp, stopp)) {
+    return 0;
+  }
+  if (*startp < 0) {
+    *startp += size;
+    if (*startp < 0) {
+      *startp = 0;
+    }
+  }
+  if (*stopp < 0) {
+    *stopp += size;
+    if (*stopp < 0) {
+      *stopp = 0;
+    }
+  }
+  else if (*stopp > size) {
+    *stopp = size;
+  }
+  return 1;
+}
+
+
+/* ArrayList
+ * Fixed-size-array-based implementation of the List interface.
+ * A growable ArrayList reallocates data geometrically when it is full and,
+ * given a shrink threshold, gives memory back when it becomes sparse.
+ * Capacities of up to ARRAYLIST_INLINE_CAPACITY slots are kept in a buffer
+ * inside the object, so a small ArrayList takes a single allocation, and
+ * deallocated ArrayLists are kept on a free list for reuse.  Slots at or
+ * beyond size are never read and are left uninitialized, so reserving
+ * capacity costs nothing until the slots are used. */
+
+#define ARRAYLIST_GROWTH_FACTOR 2
+#define ARRAYLIST_INLINE_CAPACITY 8
+#define ARRAYLIST_MAXFREELIST 80
+
+typedef struct {
+  PyObject_HEAD
+  Py_ssize_t capacity;
+  Py_ssize_t size;
+  PyObject   **data;
+  int        growable;
+  double     shrink_threshold;
+  long       state;
+  PyObject   *inline_data[ARRAYLIST_INLINE_CAPACITY];
+#if EDUCOLLECTIONS_STATS
+  ListStats  stats;
+#endif
+} ArrayList;
+
+static ArrayList *ArrayList_free_list[ARRAYLIST_MAXFREELIST];
+static int ArrayList_numfree = 0;
+
+/* Counters reported by array_list_alloc_stats(). */
+static struct {
+  Py_ssize_t free_list_hits;
+  Py_ssize_t free_list_misses;
+  Py_ssize_t inline_buffers;
+  Py_ssize_t heap_buffers;
+} ArrayList_alloc_counts;
+
+PyDoc_STRVAR(ArrayList_doc,
+  "ArrayList(capacity, growable=False, shrink_threshold=0.0)\n"
+  "\n"
+  "Fixed-size-array-based implementation of the List interface.\n"
+  "If growable is true, the array grows geometrically instead of raising\n"
+  "when full, and shrinks after remove() or clear() once fewer than\n"
+  "shrink_threshold * capacity slots are in use.");
+
+/* Reallocates data to hold exactly capacity slots, moving it into or out of
+ * the inline buffer as capacity crosses ARRAYLIST_INLINE_CAPACITY.  Only the
+ * size items are carried over. */
+static int
+ArrayList_resize(ArrayList *self, Py_ssize_t capacity)
+{
+  PyObject **data;
+
+  assert(capacity >= self->size && capacity > 0);
+  if (capacity <= ARRAYLIST_INLINE_CAPACITY) {
+    data = self->inline_data;
+    if (self->data != data && self->data != NULL) {
+      memcpy(data, self->data, self->size * sizeof(PyObject *));
+      PyMem_Del(self->data);
+      LISTSTATS_ADD(self, frees, 1);
+    }
+  }
+  else {
+    if (self->data == self->inline_data) {
+      data = PyMem_New(PyObject *, capacity);
+      if (data != NULL) {
+        memcpy(data, self->data, self->size * sizeof(PyObject *));
+      }
+    }
+    else {
+      data = self->data;
+      PyMem_Resize(data, PyObject *, capacity);
+    }
+    if (data == NULL) {
+      PyErr_NoMemory();
+      return -1;
+    }
+    LISTSTATS_ADD(self, allocs, 1);
+    LISTSTATS_ADD(self, frees, self->data != NULL &&
+                               self->data != self->inline_data);
+    ++ArrayList_alloc_counts.heap_buffers;
+  }
+  self->data = data;
+  self->capacity = capacity;
+  return 0;
+}
+
+/* Makes room for needed items, growing data geometrically if this ArrayList
+ * is growable. */
+static int
+ArrayList_make_room(ArrayList *self, Py_ssize_t needed)
+{
+  Py_ssize_t capacity;
+
+  if (needed <= self->capacity) {
+    return 0;
+  }
+  if (!self->growable) {
+    PyErr_SetString(PyExc_RuntimeError, "ArrayList is full (capacity == size)");
+    return -1;
+  }
+  capacity = self->capacity;
+  while (capacity < needed) {
+    if (capacity > PY_SSIZE_T_MAX / ARRAYLIST_GROWTH_FACTOR) {
+      capacity = needed;
+      break;
+    }
+    capacity *= ARRAYLIST_GROWTH_FACTOR;
+  }
+  return ArrayList_resize(self, capacity);
+}
+
+/* Gives memory back once a growable ArrayList drops below its shrink
+ * threshold.  The new capacity leaves room to grow by the growth factor, so
+ * alternating appends and removes cannot thrash.  Shrinking is only an
+ * optimization, so a failed reallocation keeps the current data. */
+static void
+ArrayList_maybe_shrink(ArrayList *self)
+{
+  Py_ssize_t capacity;
+
+  if (!self->growable || self->shrink_threshold <= 0.0 ||
+      self->size >= self->capacity * self->shrink_threshold) {
+    return;
+  }
+  capacity = self->size * ARRAYLIST_GROWTH_FACTOR;
+  if (capacity < 1) {
+    capacity = 1;
+  }
+  if (capacity < self->capacity && ArrayList_resize(self, capacity) < 0) {
+    PyErr_Clear();
+  }
+}
+
+/* ArrayListType.tp_new
+ * Exact ArrayLists are taken from the free list when it is not empty; the
+ * recycled object is zeroed as tp_alloc would zero a new one. */
+static PyObject *
+ArrayList_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  ArrayList *self;
+
+  if (type == &ArrayListType && ArrayList_numfree > 0) {
+    self = ArrayList_free_list[--ArrayList_numfree];
+    memset((char *)self + sizeof(PyObject), 0,
+           sizeof(ArrayList) - sizeof(PyObject));
+    PyObject_Init((PyObject *)self, type);
+    PyObject_GC_Track(self);
+    ++ArrayList_alloc_counts.free_list_hits;
+  }
+  else {
+    self = (ArrayList *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+      return NULL;
+    }
+    ++ArrayList_alloc_counts.free_list_misses;
+  }
+  self->capacity = 0;
+  self->size = 0;
+  self->data = NULL;
+  self->growable = 0;
+  self->shrink_threshold = 0.0;
+  self->state = 0;
+  return (PyObject *)self;
+}
+
+/* Validates the constructor arguments and (re)allocates data for them;
+ * shared by tp_init and the vectorcall constructor. */
+static int
+ArrayList_setup(ArrayList *self, PyObject *capacityobj, int growable,
+                double shrink_threshold)
+{
+  PyObject **data = NULL;
+  PyObject **tmp = NULL;
+  Py_ssize_t capacity = -1;
+  Py_ssize_t tmp_size;
+  Py_ssize_t i;
+
+  if (capacityobj != NULL && capacityobj != Py_None) {
+    capacity = PyLong_AsSsize_t(capacityobj);
+    if (capacity == -1 && PyErr_Occurred()) {
+      return -1;
+    }
+  }
+  if (capacity < 1) {
+    PyErr_SetString(PyExc_ValueError, "capacity must be greater than zero");
+    return -1;
+  }
+  if (!(shrink_threshold >= 0.0 &&
+        shrink_threshold < 1.0 / ARRAYLIST_GROWTH_FACTOR)) {
+    PyErr_SetString(PyExc_ValueError,
+                    "shrink_threshold must be in [0.0, 0.5)");
+    return -1;
+  }
+  /* A second __init__ on a small ArrayList goes to the heap, since the old
+   * items still occupy the inline buffer until they are released. */
+  if (capacity <= ARRAYLIST_INLINE_CAPACITY &&
+      self->data != self->inline_data) {
+    data = self->inline_data;
+    ++ArrayList_alloc_counts.inline_buffers;
+  }
+  else {
+    data = PyMem_New(PyObject *, capacity);
+    if (data == NULL) {
+      PyErr_SetString(PyExc_MemoryError, "memory allocation request failed");
+      return -1;
+    }
+    ++ArrayList_alloc_counts.heap_buffers;
+  }
+  tmp = self->data;
+  tmp_size = self->size;
+  self->data = data;
+  self->capacity = capacity;
+  self->size = 0;
+  ++self->state;
+  self->growable = growable;
+  self->shrink_threshold = shrink_threshold;
+  for (i = 0; i < tmp_size; ++i) {
+    Py_DECREF(tmp[i]);
+  }
+  if (tmp != self->inline_data) {
+    PyMem_Del(tmp);
+  }
+  return 0;
+}
+
+/* ArrayListType.tp_init */
+static int
+ArrayList_init(ArrayList *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *capacityobj = NULL;
+  int growable = 0;
+  double shrink_threshold = 0.0;
+  static char *kwlist[] = {"capacity", "growable", "shrink_threshold", NULL};
+
+  if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|pd", kwlist, &capacityobj,
+                                    &growable, &shrink_threshold)) {
+    return -1;
+  }
+  return ArrayList_setup(self, capacityobj, growable, shrink_threshold);
+}
+
+/* ArrayListType.tp_vectorcall
+ * Parses ArrayList(capacity, growable=False, shrink_threshold=0.0) straight
+ * from the argument vector, skipping the argument tuple and kwargs dict. */
+static PyObject *
+ArrayList_vectorcall(PyObject *type, PyObject *const *args, size_t nargsf,
+                     PyObject *kwnames)
+{
+  PyObject *self, *argv[3] = {NULL, NULL, NULL}, *name;
+  Py_ssize_t nargs, nkw, i;
+  int growable = 0;
+  double shrink_threshold = 0.0;
+
+  nargs = PyVectorcall_NARGS(nargsf);
+  nkw = kwnames != NULL ? PyTuple_GET_SIZE(kwnames) : 0;
+  if (type != (PyObject *)&ArrayListType || nargs < 1 || nargs + nkw > 3) {
+    return List_vectorcall_fallback(type, args, nargsf, kwnames);
+  }
+  for (i = 0; i < nargs; ++i) {
+    argv[i] = args[i];
+  }
+  for (i = 0; i < nkw; ++i) {
+    name = PyTuple_GET_ITEM(kwnames, i);
+    if (nargs <= 1 && argv[1] == NULL &&
+        PyUnicode_CompareWithASCIIString(name, "growable") == 0) {
+      argv[1] = args[nargs + i];
+    }
+    else if (nargs <= 2 && argv[2] == NULL &&
+             PyUnicode_CompareWithASCIIString(name, "shrink_threshold") == 0) {
+      argv[2] = args[nargs + i];
+    }
+    else {
+      return List_vectorcall_fallback(type, args, nargsf, kwnames);
+    }
+  }
+  if (argv[1] != NULL) {
+    growable = PyObject_IsTrue(argv[1]);
+    if (growable < 0) {
+      return NULL;
+    }
+  }
+  if (argv[2] != NULL) {
+    shrink_threshold = PyFloat_AsDouble(argv[2]);
+    if (shrink_threshold == -1.0 && PyErr_Occurred()) {
+      return NULL;
+    }
+  }
+  self = ArrayList_new((PyTypeObject *)type, NULL, NULL);
+  if (self == NULL) {
+    return NULL;
+  }
+  if (ArrayList_setup((ArrayList *)self, argv[0], growable,
+                      shrink_threshold) < 0) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  return self;
+}
+
+/* ArrayListType.tp_traverse */
+static int
+ArrayList_traverse(ArrayList *self, visitproc visit, void *arg)
+{
+  Py_ssize_t i;
+
+  for (i = 0; i < self->size; ++i) {
+    Py_VISIT(self->data[i]);
+  }
+  return 0;
+}
+
+/* ArrayListType.tp_clear
+ * Releases the items from the end one at a time, keeping this ArrayList
+ * consistent whatever code releasing an item runs. */
+static int
+ArrayList_tp_clear(ArrayList *self)
+{
+  PyObject *item;
+
+  while (self->size > 0) {
+    self->size -= 1;
+    item = self->data[self->size];
+    ++self->state;
+    Py_DECREF(item);
+  }
+  return 0;
+}
+
+/* ArrayListType.tp_dealloc */
+static void
+ArrayList_dealloc(ArrayList *self)
+{
+  Py_ssize_t i;
+
+  PyObject_GC_UnTrack(self);
+  for (i = 0; i < self->size; ++i) {
+    Py_DECREF(self->data[i]);
+  }
+  if (self->data != self->inline_data) {
+    PyMem_Del(self->data);
+  }
+  if (Py_IS_TYPE(self, &ArrayListType) &&
+      ArrayList_numfree < ARRAYLIST_MAXFREELIST) {
+    ArrayList_free_list[ArrayList_numfree++] = self;
+    return;
+  }
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* _educollections.array_list_alloc_stats() */
+PyObject *
+ArrayList_alloc_stats(PyObject *module, PyObject *unused)
+{
+  return Py_BuildValue("{sn,sn,sn,sn,sn}",
+                       "free_list_size", (Py_ssize_t)ArrayList_numfree,
+                       "free_list_hits", ArrayList_alloc_counts.free_list_hits,
+                       "free_list_misses",
+                         ArrayList_alloc_counts.free_list_misses,
+                       "inline_buffers", ArrayList_alloc_counts.inline_buffers,
+                       "heap_buffers", ArrayList_alloc_counts.heap_buffers);
+}
+
+/* ArrayList.append(item) */
+static PyObject *
+ArrayList_append(ArrayList *self, PyObject *item)
+{
+#if defined(NDEBUG)
+  if (item == NULL) {
+    PyErr_SetString(PyExc_ValueError, "item == NULL");
+    return NULL;
+  }
+#endif
+  if (ArrayList_make_room(self, self->size + 1) < 0) {
+    return NULL;
+  }
+  Py_INCREF(item);
+  self->data[self->size] = item;
+  self->size += 1;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(ArrayList_capacity_doc,
+  "Returns the capacity of this ArrayList.");
+
+/* ArrayList.capacity() */
+static PyObject *
+ArrayList_capacity(ArrayList *self)
+{
+  return PyLong_FromSsize_t(self->capacity);
+}
+
+static int ArrayList_tp_clear(ArrayList *self);
+
+/* ArrayList.clear()
+ * Only the items are released; the slots themselves are left as they are. */
+static PyObject *
+ArrayList_clear(ArrayList *self)
+{
+  ArrayList_tp_clear(self);
+  ++self->state;
+  ArrayList_maybe_shrink(self);
+  Py_RETURN_NONE;
+}
+
+/* ArrayListType.tp_as_sequence->sq_item */
+static PyObject *
+ArrayList_item(ArrayList *self, Py_ssize_t index)
+{
+  PyObject *item;
+
+  if (index < 0 || index >= self->capacity || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "ArrayList index out of range");
+    return NULL;
+  }
+  item = self->data[index];
+  Py_INCREF(item);
+  return item;
+}
+
+/* ArrayList.extend(iterable)
+ * Lists and tuples are copied straight from their item arrays after a single
+ * capacity check; any other iterable is gathered into a list first. */
+static PyObject *
+ArrayList_extend(ArrayList *self, PyObject *iterable)
+{
+  PyObject *seq, **items;
+  Py_ssize_t n, i;
+
+  seq = PySequence_Fast(iterable,
+                        "ArrayList.extend() argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  if (ArrayList_make_room(self, self->size + n) < 0) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  items = PySequence_Fast_ITEMS(seq);
+  for (i = 0; i < n; ++i) {
+    Py_INCREF(items[i]);
+    self->data[self->size + i] = items[i];
+  }
+  self->size += n;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  Py_DECREF(seq);
+  Py_RETURN_NONE;
+}
+
+/* ArrayList.from_iterable(iterable, **kwds)
+ * The new ArrayList is sized to fit; kwds are passed to the constructor. */
+static PyObject *
+ArrayList_from_iterable(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  PyObject *iterable, *seq, *self, *result;
+  Py_ssize_t n;
+
+  if (!PyArg_UnpackTuple(args, "from_iterable", 1, 1, &iterable)) {
+    return NULL;
+  }
+  seq = PySequence_Fast(iterable,
+                        "ArrayList.from_iterable() argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  args = Py_BuildValue("(n)", n > 0 ? n : 1);
+  if (args == NULL) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  self = PyObject_Call((PyObject *)type, args, kwds);
+  Py_DECREF(args);
+  if (self == NULL) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  result = ArrayList_extend((ArrayList *)self, seq);
+  Py_DECREF(seq);
+  if (result == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  Py_DECREF(result);
+  return self;
+}
+
+/* ArrayList.get(index) */
+static PyObject *
+ArrayList_get(ArrayList *self, PyObject *indexobj)
+{
+  Py_ssize_t index = -1;
+
+  if (indexobj != NULL && indexobj != Py_None) {
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred())
+    return NULL;
+  }
+  return ArrayList_item(self, index);
+}
+
+/* ArrayList.insert(index, item) */
+static PyObject *
+ArrayList_insert(ArrayList *self, PyObject *const *args, Py_ssize_t nargs)
+{
+  PyObject *indexobj = NULL, *itemobj = NULL;
+  Py_ssize_t index = -1;
+
+  if (!List_check_nargs("insert", nargs, 2)) {
+    return NULL;
+  }
+  indexobj = args[0];
+  itemobj = args[1];
+  if (indexobj != NULL && indexobj != Py_None) {
+    index = PyLong_AsSsize_t(indexobj);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+  }
+  if (index < 0 || index >= self->capacity || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "ArrayList index out of range");
+    return NULL;
+  }
+  if (itemobj == NULL) {
+    PyErr_SetString(PyExc_ValueError, "item == NULL");
+    return NULL;
+  }
+  if (ArrayList_make_room(self, self->size + 1) < 0) {
+    return NULL;
+  }
+
+  memmove(self->data + index + 1, self->data + index,
+          (self->size - index) * sizeof(PyObject *));
+  LISTSTATS_ADD(self, shifted, self->size - index);
+  Py_INCREF(itemobj);
+  self->data[index] = itemobj;
+  self->size += 1;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(ArrayList_insert_many_doc,
+  "Inserts the items of the given iterable at the given index in this\n"
+  "ArrayList.  The index may equal the size of this ArrayList.");
+
+/* ArrayList.insert_many(index, iterable)
+ * The tail is moved once for the whole batch. */
+static PyObject *
+ArrayList_insert_many(ArrayList *self, PyObject *args)
+{
+  PyObject *iterable, *seq, **items;
+  Py_ssize_t index, n, i;
+
+  if (!PyArg_ParseTuple(args, "nO:insert_many", &index, &iterable)) {
+    return NULL;
+  }
+  /* Consuming iterable can run arbitrary code, so the index is checked
+   * after it. */
+  seq = PySequence_Fast(iterable,
+                        "ArrayList.insert_many() argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  if (index < 0 || index > self->size) {
+    PyErr_SetString(PyExc_IndexError, "ArrayList index out of range");
+    Py_DECREF(seq);
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  if (ArrayList_make_room(self, self->size + n) < 0) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  memmove(self->data + index + n, self->data + index,
+          (self->size - index) * sizeof(PyObject *));
+  LISTSTATS_ADD(self, shifted, self->size - index);
+  items = PySequence_Fast_ITEMS(seq);
+  for (i = 0; i < n; ++i) {
+    Py_INCREF(items[i]);
+    self->data[index + i] = items[i];
+  }
+  self->size += n;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  Py_DECREF(seq);
+  Py_RETURN_NONE;
+}
+
+/* ArrayList.prepend(item) */
+static PyObject *
+ArrayList_prepend(ArrayList *self, PyObject *item)
+{
+  if (item == NULL) {
+    PyErr_SetString(PyExc_ValueError, "item == NULL");
+    return NULL;
+  }
+  if (ArrayList_make_room(self, self->size + 1) < 0) {
+    return NULL;
+  }
+
+  memmove(self->data + 1, self->data, self->size * sizeof(PyObject *));
+  LISTSTATS_ADD(self, shifted, self->size);
+  Py_INCREF(item);
+  self->data[0] = item;
+  self->size += 1;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  Py_RETURN_NONE;
+}
+
+/* Removes and returns the item at index, which must be in range. */
+static PyObject *
+ArrayList_remove_index(ArrayList *self, Py_ssize_t index)
+{
+  PyObject *old_item;
+
+  old_item = self->data[index];
+  memmove(self->data + index, self->data + index + 1,
+          (self->size - index - 1) * sizeof(PyObject *));
+  LISTSTATS_ADD(self, shifted, self->size - index - 1);
+  self->size -= 1;
+  ++self->state;
+  ArrayList_maybe_shrink(self);
+
+  return old_item;
+}
+
+PyDoc_STRVAR(ArrayList_remove_range_doc,
+  "Removes the items from index start up to, but not including, index stop\n"
+  "in this ArrayList.");
+
+/* ArrayList.remove_range(start, stop)
+ * The tail is moved once for the whole batch.  The removed items are
+ * released only after the ArrayList is consistent again, since releasing
+ * an item can run arbitrary code. */
+static PyObject *
+ArrayList_remove_range(ArrayList *self, PyObject *args)
+{
+  PyObject **removed;
+  Py_ssize_t start, stop, n, i;
+
+  if (!PyArg_ParseTuple(args, "nn:remove_range", &start, &stop)) {
+    return NULL;
+  }
+  if (start < 0 || stop > self->size || start > stop) {
+    PyErr_SetString(PyExc_IndexError, "ArrayList index out of range");
+    return NULL;
+  }
+  n = stop - start;
+  if (n == 0) {
+    Py_RETURN_NONE;
+  }
+  removed = PyMem_New(PyObject *, n);
+  if (removed == NULL) {
+    return PyErr_NoMemory();
+  }
+  memcpy(removed, self->data + start, n * sizeof(PyObject *));
+  memmove(self->data + start, self->data + stop,
+          (self->size - stop) * sizeof(PyObject *));
+  LISTSTATS_ADD(self, shifted, self->size - stop);
+  self->size -= n;
+  ++self->state;
+  ArrayList_maybe_shrink(self);
+  for (i = 0; i < n; ++i) {
+    Py_DECREF(removed[i]);
+  }
+  PyMem_Del(removed);
+  Py_RETURN_NONE;
+}
+
+/* Implements remove_if() and retain(), which remove the items for which
+ * predicate returns remove_matches.  The predicate is called for every item
+ * before anything is moved, so it always sees a consistent ArrayList; the
+ * survivors are then compacted in one pass and the removed items released
+ * last.  If the predicate raises, the items it already picked are still
+ * removed. */
+static PyObject *
+ArrayList_filter(ArrayList *self, PyObject *predicate, int remove_matches,
+                 const char *name)
+{
+  PyObject **removed;
+  char *picked;
+  Py_ssize_t n, judged, count = 0, i, w, k;
+  long state;
+  int truth = 0;
+
+  n = self->size;
+  picked = PyMem_Malloc(n > 0 ? n : 1);
+  if (picked == NULL) {
+    return PyErr_NoMemory();
+  }
+  state = self->state;
+  for (judged = 0; judged < n; ++judged) {
+    truth = List_call_predicate(predicate, self->data[judged]);
+    if (truth < 0 || self->state != state) {
+      break;
+    }
+    picked[judged] = truth == remove_matches;
+    count += picked[judged];
+  }
+  if (self->state != state) {
+    PyMem_Free(picked);
+    if (truth >= 0) {
+      PyErr_Format(PyExc_RuntimeError, "ArrayList mutated during %s", name);
+    }
+    return NULL;
+  }
+  if (count > 0) {
+    removed = PyMem_New(PyObject *, count);
+    if (removed == NULL) {
+      PyMem_Free(picked);
+      return truth < 0 ? NULL : PyErr_NoMemory();
+    }
+    for (i = w = k = 0; i < n; ++i) {
+      if (i < judged && picked[i]) {
+        removed[k++] = self->data[i];
+      }
+      else {
+        self->data[w++] = self->data[i];
+        LISTSTATS_ADD(self, shifted, k > 0);
+      }
+    }
+    self->size = w;
+    ++self->state;
+    ArrayList_maybe_shrink(self);
+    for (k = 0; k < count; ++k) {
+      Py_DECREF(removed[k]);
+    }
+    PyMem_Del(removed);
+  }
+  PyMem_Free(picked);
+  if (truth < 0) {
+    return NULL;
+  }
+  return PyLong_FromSsize_t(count);
+}
+
+/* ArrayList.remove_if(predicate) */
+static PyObject *
+ArrayList_remove_if(ArrayList *self, PyObject *predicate)
+{
+  return ArrayList_filter(self, predicate, 1, "remove_if");
+}
+
+/* ArrayList.retain(predicate) */
+static PyObject *
+ArrayList_retain(ArrayList *self, PyObject *predicate)
+{
+  return ArrayList_filter(self, predicate, 0, "retain");
+}
+
+/* ArrayList.remove(index) */
+static PyObject *
+ArrayList_remove(ArrayList *self, PyObject *indexobj)
+{
+  Py_ssize_t index = -1;
+
+  if (indexobj != NULL && indexobj != Py_None) {
+    index = PyLong_AsSsize_t(indexobj);
+    if (index == -1 && PyErr_Occurred()) {
+      PyErr_SetString(PyExc_RuntimeError, "WTF");
+      return NULL;
+    }
+  }
+  if (index < 0 || index >= self->capacity || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "ArrayList index out of range");
+    return NULL;
+  }
+  return ArrayList_remove_index(self, index);
+}
+
+/* ArrayListType.tp_as_sequence->sq_ass_item
+ * Assigns item at index, or deletes the item at index if item is NULL. */
+static int
+ArrayList_ass_item(ArrayList *self, Py_ssize_t index, PyObject *item)
+{
+  PyObject *old_item;
+
+  if (index < 0 || index >= self->capacity || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "ArrayList index out of range");
+    return -1;
+  }
+  if (item == NULL) {
+    old_item = ArrayList_remove_index(self, index);
+    Py_DECREF(old_item);
+    return 0;
+  }
+  ++self->state;
+  Py_INCREF(item);
+  old_item = self->data[index];
+  self->data[index] = item;
+  Py_DECREF(old_item);
+  return 0;
+}
+
+/* ArrayList.reverse() */
+static PyObject *
+ArrayList_reverse(ArrayList *self)
+{
+  PyObject **lo, **hi, *tmp;
+
+  if (self->size > 1) {
+    for (lo = self->data, hi = self->data + self->size - 1; lo < hi;
+         ++lo, --hi) {
+      tmp = *lo;
+      *lo = *hi;
+      *hi = tmp;
+    }
+  }
+  ++self->state;
+  Py_RETURN_NONE;
+}
+
+/* ArrayList.set(index, item) */
+static PyObject *
+ArrayList_set(ArrayList *self, PyObject *const *args, Py_ssize_t nargs)
+{
+  PyObject *indexobj = NULL;
+  PyObject *itemobj = NULL;
+  Py_ssize_t index = -1;
+
+  if (!List_check_nargs("set", nargs, 2)) {
+    return NULL;
+  }
+  indexobj = args[0];
+  itemobj = args[1];
+  if (indexobj != NULL && indexobj != Py_None) {
+    index = PyLong_AsSsize_t(indexobj);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+  }
+#if defined(NDEBUG)
+  if (itemobj == NULL) {
+    PyErr_SetString(PyExc_ValueError, "item == NULL");
+    return NULL;
+  }
+#endif
+  if (ArrayList_ass_item(self, index, itemobj) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(ArrayList_reserve_doc,
+  "Ensures this ArrayList can hold at least n items without reallocating.");
+
+/* ArrayList.reserve(n) */
+static PyObject *
+ArrayList_reserve(ArrayList *self, PyObject *nobj)
+{
+  Py_ssize_t n;
+
+  n = PyLong_AsSsize_t(nobj);
+  if (n == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (n > self->capacity && ArrayList_resize(self, n) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(ArrayList_shrink_to_fit_doc,
+  "Reduces the capacity of this ArrayList to its size.");
+
+/* ArrayList.shrink_to_fit() */
+static PyObject *
+ArrayList_shrink_to_fit(ArrayList *self)
+{
+  Py_ssize_t capacity;
+
+  capacity = self->size > 0 ? self->size : 1;
+  if (capacity < self->capacity && ArrayList_resize(self, capacity) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* ArrayList.sort(*, key=None, reverse=False)
+ * Sorts a copy of the item pointers holding its own references, so a key
+ * function or comparison that mutates this ArrayList cannot free an item
+ * mid-sort; the result is written back only if no mutation happened. */
+static PyObject *
+ArrayList_sort(ArrayList *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *keyfunc, **values;
+  Py_ssize_t n, i;
+  long state;
+  int reverse, result;
+
+  if (!ListSort_parse_args(args, kwds, &keyfunc, &reverse)) {
+    return NULL;
+  }
+  n = self->size;
+  values = PyMem_New(PyObject *, n > 0 ? n : 1);
+  if (values == NULL) {
+    return PyErr_NoMemory();
+  }
+  for (i = 0; i < n; ++i) {
+    values[i] = self->data[i];
+    Py_INCREF(values[i]);
+  }
+  state = self->state;
+  result = ListSort_sort_values(values, n, keyfunc, reverse);
+  if (self->state == state) {
+    memcpy(self->data, values, n * sizeof(PyObject *));
+    ++self->state;
+  }
+  else if (result == 0) {
+    PyErr_SetString(PyExc_ValueError, "ArrayList modified during sort");
+    result = -1;
+  }
+  for (i = 0; i < n; ++i) {
+    Py_DECREF(values[i]);
+  }
+  PyMem_Del(values);
+  if (result < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* ArrayList.index_of(item[, start[, stop]])
+ * The bound is checked against size on every step, as a comparison may
+ * shrink this ArrayList. */
+static PyObject *
+ArrayList_index_of(ArrayList *self, PyObject *args)
+{
+  PyObject *item;
+  Py_ssize_t start, stop, i;
+  int cmp;
+
+  if (!List_parse_index_of_args(args, self->size, &item, &start, &stop)) {
+    return NULL;
+  }
+  for (i = start; i < stop && i < self->size; ++i) {
+    cmp = List_item_eq(self->data[i], item);
+    if (cmp > 0) {
+      return PyLong_FromSsize_t(i);
+    }
+    if (cmp < 0) {
+      return NULL;
+    }
+  }
+  PyErr_Format(PyExc_ValueError, "%R is not in ArrayList", item);
+  return NULL;
+}
+
+static int ArrayList_contains(ArrayList *self, PyObject *item);
+
+/* ArrayList.contains(item) */
+static PyObject *
+ArrayList_contains_method(ArrayList *self, PyObject *item)
+{
+  int cmp;
+
+  cmp = ArrayList_contains(self, item);
+  if (cmp < 0) {
+    return NULL;
+  }
+  return PyBool_FromLong(cmp);
+}
+
+/* ArrayList.count(item) */
+static PyObject *
+ArrayList_count(ArrayList *self, PyObject *item)
+{
+  Py_ssize_t i, count = 0;
+  int cmp;
+
+  for (i = 0; i < self->size; ++i) {
+    cmp = List_item_eq(self->data[i], item);
+    if (cmp < 0) {
+      return NULL;
+    }
+    count += cmp;
+  }
+  return PyLong_FromSsize_t(count);
+}
+
+PyDoc_STRVAR(ArrayList_bisect_left_doc,
+  "Returns the index at which the given item would be inserted into this\n"
+  "ArrayList, which must be sorted, to keep it sorted, before any equal\n"
+  "items.  Only indexes lo up to hi are considered.");
+
+PyDoc_STRVAR(ArrayList_bisect_right_doc,
+  "Returns the index at which the given item would be inserted into this\n"
+  "ArrayList, which must be sorted, to keep it sorted, after any equal\n"
+  "items.  Only indexes lo up to hi are considered.");
+
+/* Implements bisect_left() and bisect_right(), which differ only in which
+ * side of a run of equal items they settle on.  Probes whose type matches
+ * the item's are compared with the same direct lt that sort() uses. */
+static PyObject *
+ArrayList_bisect(ArrayList *self, PyObject *args, int right,
+                 const char *format)
+{
+  PyObject *item, *probe;
+  Py_ssize_t lo = 0, hi = -1, mid;
+  ListSort_lt lt, item_lt;
+  int cmp;
+
+  if (!PyArg_ParseTuple(args, format, &item, &lo, &hi)) {
+    return NULL;
+  }
+  if (lo < 0) {
+    PyErr_SetString(PyExc_ValueError, "lo must be non-negative");
+    return NULL;
+  }
+  if (hi < 0 || hi > self->size) {
+    hi = self->size;
+  }
+  item_lt = ListSort_lt_for(item);
+  while (lo < hi) {
+    mid = lo + (hi - lo) / 2;
+    probe = self->data[mid];
+    lt = ListSort_lt_for(probe) == item_lt ? item_lt : ListSort_lt_generic;
+    Py_INCREF(probe);
+    cmp = right ? lt(item, probe) : lt(probe, item);
+    Py_DECREF(probe);
+    if (cmp < 0) {
+      return NULL;
+    }
+    if (cmp == right) {
+      hi = mid;
+    }
+    else {
+      lo = mid + 1;
+    }
+    if (hi > self->size) {
+      hi = self->size;
+    }
+  }
+  return PyLong_FromSsize_t(lo);
+}
+
+/* ArrayList.bisect_left(item[, lo[, hi]]) */
+static PyObject *
+ArrayList_bisect_left(ArrayList *self, PyObject *args)
+{
+  return ArrayList_bisect(self, args, 0, "O|nn:bisect_left");
+}
+
+/* ArrayList.bisect_right(item[, lo[, hi]]) */
+static PyObject *
+ArrayList_bisect_right(ArrayList *self, PyObject *args)
+{
+  return ArrayList_bisect(self, args, 1, "O|nn:bisect_right");
+}
+
+/* ArrayList.size() */
+static PyObject *
+ArrayList_size(ArrayList *self)
+{
+  return PyLong_FromSsize_t(self->size);
+}
+
+#if EDUCOLLECTIONS_STATS
+/* ArrayList.stats() */
+static PyObject *
+ArrayList_stats(ArrayList *self)
+{
+  return ListStats_dict(&self->stats);
+}
+
+/* ArrayList.reset_stats() */
+static PyObject *
+ArrayList_reset_stats(ArrayList *self)
+{
+  ListStats_reset(&self->stats, self->size);
+  Py_RETURN_NONE;
+}
+#endif
+
+/* ArrayListType.tp_as_sequence->sq_length */
+static Py_ssize_t
+ArrayList_length(ArrayList *self)
+{
+  return self->size;
+}
+
+/* ArrayListType.tp_as_sequence->sq_contains */
+static int
+ArrayList_contains(ArrayList *self, PyObject *item)
+{
+  Py_ssize_t i;
+  int cmp;
+
+  for (i = 0, cmp = 0; cmp == 0 && i < self->size; ++i) {
+    cmp = List_item_eq(self->data[i], item);
+  }
+  return cmp;
+}
+
+/* ArrayListType.tp_as_mapping->mp_subscript
+ * Slicing returns a new ArrayList with the same growth settings. */
+static PyObject *
+ArrayList_subscript(ArrayList *self, PyObject *key)
+{
+  ArrayList *result;
+  Py_ssize_t index, start, stop, step, slicelength, i, j;
+  PyObject *item;
+
+  if (PyIndex_Check(key)) {
+    index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+    if (index < 0) {
+      index += self->size;
+    }
+    return ArrayList_item(self, index);
+  }
+  if (!PySlice_Check(key)) {
+    PyErr_Format(PyExc_TypeError,
+                 "ArrayList indices must be integers or slices, not %.200s",
+                 Py_TYPE(key)->tp_name);
+    return NULL;
+  }
+  if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+    return NULL;
+  }
+  slicelength = PySlice_AdjustIndices(self->size, &start, &stop, step);
+  result = (ArrayList *)PyObject_CallFunction((PyObject *)Py_TYPE(self), "n",
+                                              slicelength > 0 ? slicelength : 1);
+  if (result == NULL) {
+    return NULL;
+  }
+  result->growable = self->growable;
+  result->shrink_threshold = self->shrink_threshold;
+  for (i = start, j = 0; j < slicelength; i += step, ++j) {
+    item = self->data[i];
+    Py_INCREF(item);
+    result->data[j] = item;
+  }
+  result->size = slicelength;
+  LISTSTATS_PEAK(result);
+  return (PyObject *)result;
+}
+
+/* ArrayListType.tp_as_sequence->sq_inplace_concat */
+static PyObject *
+ArrayList_inplace_concat(ArrayList *self, PyObject *other)
+{
+  PyObject *result;
+
+  result = ArrayList_extend(self, other);
+  if (result == NULL) {
+    return NULL;
+  }
+  Py_DECREF(result);
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
+
+/* ArrayListType.tp_repr */
+static PyObject *
+ArrayList_repr(PyObject *self)
+{
+  /* PyObject *aslist; */
+  /* PyObject *result; */
+  /* int i; */
+
+  /* i = Py_ReprEnter(self); */
+  /* if (i != 0) { */
+  /*   if (i < 0) { */
+  /*     return NULL; */
+  /*   } */
+  /*   return PyUnicode_FromString("[...]"); */
+  /* } */
+  /* aslist = PySequence_List(self); */
+  /* if (aslist == NULL) { */
+  /*   Py_ReprLeave(self); */
+  /*   return NULL; */
+  /* } */
+  /* result = PyUnicode_FromFormat("%R", aslist); */
+  /* Py_DECREF(aslist); */
+  /* Py_ReprLeave(self); */
+  /* return result; */
+  return PyUnicode_FromString("[...]");
+}
+
+/* ArrayListType.tp_str */
+static PyObject *
+ArrayList_str(PyObject *self)
+{
+  /* PyObject *aslist; */
   /* PyObject *result; */
   /* int i; */
 
-  /* i = Py_ReprEnter(self); */
-  /* if (i != 0) { */
-  /*   if (i < 0) { */
-  /*     return NULL; */
-  /*   } */
-  /*   return PyUnicode_FromString("[...]"); */
-  /* } */
-  /* aslist = PySequence_List(self); */
-  /* if (aslist == NULL) { */
-  /*   Py_ReprLeave(self); */
-  /*   return NULL; */
-  /* } */
-  /* result = PyUnicode_FromFormat("%R", aslist); */
-  /* Py_DECREF(aslist); */
-  /* Py_ReprLeave(self); */
-  /* return result; */
-  return PyUnicode_FromString("[...]");
+  /* i = Py_ReprEnter(self); */
+  /* if (i != 0) { */
+  /*     if (i < 0) */
+  /*         return NULL; */
+  /*     return PyUnicode_FromString("[...]"); */
+  /* } */
+  /* aslist = PySequence_List(self); */
+  /* if (aslist == NULL) { */
+  /*     Py_ReprLeave(self); */
+  /*     return NULL; */
+  /* } */
+  /* result = PyUnicode_FromFormat("%R", aslist); */
+  /* Py_DECREF(aslist); */
+  /* Py_ReprLeave(self); */
+  /* return result; */
+  return PyUnicode_FromString("[...]");
+}
+
+/* ArrayListIterator
+ * Iterates over an ArrayList by index, raising if the ArrayList is mutated
+ * before iteration ends. */
+typedef struct {
+  PyObject_HEAD
+  ArrayList  *list;
+  Py_ssize_t index;
+  long       state;
+} ArrayListIterator;
+
+/* ArrayListType.tp_iter */
+static PyObject *
+ArrayList_iter(ArrayList *self)
+{
+  ArrayListIterator *it;
+
+  it = PyObject_GC_New(ArrayListIterator, &ArrayListIteratorType);
+  if (it == NULL) {
+    return NULL;
+  }
+  Py_INCREF(self);
+  it->list = self;
+  it->index = 0;
+  it->state = self->state;
+  PyObject_GC_Track(it);
+  return (PyObject *)it;
+}
+
+/* ArrayListIteratorType.tp_dealloc */
+static void
+ArrayListIterator_dealloc(ArrayListIterator *self)
+{
+  PyObject_GC_UnTrack(self);
+  Py_XDECREF(self->list);
+  PyObject_GC_Del(self);
+}
+
+/* ArrayListIteratorType.tp_traverse */
+static int
+ArrayListIterator_traverse(ArrayListIterator *self, visitproc visit,
+                           void *arg)
+{
+  Py_VISIT(self->list);
+  return 0;
+}
+
+/* ArrayListIteratorType.tp_clear */
+static int
+ArrayListIterator_clear(ArrayListIterator *self)
+{
+  Py_CLEAR(self->list);
+  return 0;
+}
+
+/* ArrayListIteratorType.tp_iternext */
+static PyObject *
+ArrayListIterator_next(ArrayListIterator *self)
+{
+  PyObject *item;
+
+  if (self->list == NULL) {
+    return NULL;
+  }
+  if (self->list->state != self->state) {
+    PyErr_SetString(PyExc_RuntimeError, "ArrayList mutated during iteration");
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  if (self->index >= self->list->size) {
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  item = self->list->data[self->index];
+  ++self->index;
+  Py_INCREF(item);
+  return item;
+}
+
+PyTypeObject ArrayListIteratorType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.ArrayListIterator",  /* tp_name */
+  sizeof(ArrayListIterator),            /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)ArrayListIterator_dealloc,/* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  0,                                    /* tp_repr */
+  0,                                    /* tp_as_number */
+  0,                                    /* tp_as_sequence */
+  0,                                    /* tp_as_mapping */
+  0,                                    /* tp_hash  */
+  0,                                    /* tp_call */
+  0,                                    /* tp_str */
+  PyObject_GenericGetAttr,              /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  0,                                    /* tp_doc */
+  (traverseproc)ArrayListIterator_traverse,
+                                        /* tp_traverse */
+  (inquiry)ArrayListIterator_clear,     /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  PyObject_SelfIter,                    /* tp_iter */
+  (iternextfunc)ArrayListIterator_next, /* tp_iternext */
+};
+
+/* ArrayListType.tp_methods */
+static PyMethodDef ArrayList_methods[] = {
+  {"append",                  (PyCFunction)ArrayList_append,
+      METH_O,                  List_append_doc},
+  {"bisect_left",             (PyCFunction)ArrayList_bisect_left,
+      METH_VARARGS,            ArrayList_bisect_left_doc},
+  {"bisect_right",            (PyCFunction)ArrayList_bisect_right,
+      METH_VARARGS,            ArrayList_bisect_right_doc},
+  {"capacity",                (PyCFunction)ArrayList_capacity,
+      METH_NOARGS,             ArrayList_capacity_doc},
+  {"clear",                   (PyCFunction)ArrayList_clear,
+      METH_NOARGS,             List_clear_doc},
+  {"contains",                (PyCFunction)ArrayList_contains_method,
+      METH_O,                  List_contains_doc},
+  {"count",                   (PyCFunction)ArrayList_count,
+      METH_O,                  List_count_doc},
+  {"extend",                  (PyCFunction)ArrayList_extend,
+      METH_O,                  List_extend_doc},
+  {"from_iterable",           (PyCFunction)ArrayList_from_iterable,
+      METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+                               List_from_iterable_doc},
+  {"get",                     (PyCFunction)ArrayList_get,
+      METH_O,                  List_get_doc},
+  {"index_of",                (PyCFunction)ArrayList_index_of,
+      METH_VARARGS,            List_index_of_doc},
+  {"insert",                  (PyCFunction)ArrayList_insert,
+      METH_FASTCALL,           List_insert_doc},
+  {"insert_many",             (PyCFunction)ArrayList_insert_many,
+      METH_VARARGS,            ArrayList_insert_many_doc},
+  {"prepend",                 (PyCFunction)ArrayList_prepend,
+      METH_O,                  List_prepend_doc},
+  {"remove",                  (PyCFunction)ArrayList_remove,
+      METH_O,                  List_remove_doc},
+  {"remove_if",               (PyCFunction)ArrayList_remove_if,
+      METH_O,                  List_remove_if_doc},
+  {"remove_range",            (PyCFunction)ArrayList_remove_range,
+      METH_VARARGS,            ArrayList_remove_range_doc},
+  {"reserve",                 (PyCFunction)ArrayList_reserve,
+      METH_O,                  ArrayList_reserve_doc},
+#if EDUCOLLECTIONS_STATS
+  {"reset_stats",             (PyCFunction)ArrayList_reset_stats,
+      METH_NOARGS,             List_reset_stats_doc},
+#endif
+  {"retain",                  (PyCFunction)ArrayList_retain,
+      METH_O,                  List_retain_doc},
+  {"reverse",                 (PyCFunction)ArrayList_reverse,
+      METH_NOARGS,             List_reverse_doc},
+  {"set",                     (PyCFunction)ArrayList_set,
+      METH_FASTCALL,           List_set_doc},
+  {"shrink_to_fit",           (PyCFunction)ArrayList_shrink_to_fit,
+      METH_NOARGS,             ArrayList_shrink_to_fit_doc},
+  {"size",                    (PyCFunction)ArrayList_size,
+      METH_NOARGS,             List_size_doc},
+  {"sort",                    (PyCFunction)ArrayList_sort,
+      METH_VARARGS | METH_KEYWORDS,
+                               List_sort_doc},
+#if EDUCOLLECTIONS_STATS
+  {"stats",                   (PyCFunction)ArrayList_stats,
+      METH_NOARGS,             List_stats_doc},
+#endif
+  {NULL,                      NULL}
+};
+
+static PySequenceMethods ArrayList_as_sequence = {
+  (lenfunc)ArrayList_length,            /* sq_length */
+  0,                                    /* sq_concat */
+  0,                                    /* sq_repeat */
+  (ssizeargfunc)ArrayList_item,         /* sq_item */
+  0,                                    /* was_sq_slice */
+  (ssizeobjargproc)ArrayList_ass_item,  /* sq_ass_item */
+  0,                                    /* was_sq_ass_slice */
+  (objobjproc)ArrayList_contains,       /* sq_contains */
+  (binaryfunc)ArrayList_inplace_concat, /* sq_inplace_concat */
+  0,                                    /* sq_inplace_repeat */
+};
+
+static PyMappingMethods ArrayList_as_mapping = {
+  (lenfunc)ArrayList_length,            /* mp_length */
+  (binaryfunc)ArrayList_subscript,      /* mp_subscript */
+  0,                                    /* mp_ass_subscript */
+};
+
+PyTypeObject ArrayListType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.ArrayList",          /* tp_name */
+  sizeof(ArrayList),                    /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)ArrayList_dealloc,        /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  ArrayList_repr,                       /* tp_repr */
+  0,                                    /* tp_as_number */
+  &ArrayList_as_sequence,               /* tp_as_sequence */
+  &ArrayList_as_mapping,                /* tp_as_mapping */
+  PyObject_HashNotImplemented,          /* tp_hash  */
+  0,                                    /* tp_call */
+  ArrayList_str,                        /* tp_str */
+  0,                                    /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_BASETYPE |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  ArrayList_doc,                        /* tp_doc */
+  (traverseproc)ArrayList_traverse,     /* tp_traverse */
+  (inquiry)ArrayList_tp_clear,          /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  (getiterfunc)ArrayList_iter,          /* tp_iter */
+  0,                                    /* tp_iternext */
+  ArrayList_methods,                    /* tp_methods */
+  0,                                    /* tp_members */
+  0,                                    /* tp_getset */
+  0,                                    /* tp_base */
+  0,                                    /* tp_dict */
+  0,                                    /* tp_descr_get */
+  0,                                    /* tp_descr_set */
+  0,                                    /* tp_dictoffset */
+  (initproc)ArrayList_init,             /* tp_init */
+  PyType_GenericAlloc,                  /* tp_alloc */
+  ArrayList_new,                        /* tp_new */
+  PyObject_GC_Del,                      /* tp_free */
+  0,                                    /* tp_is_gc */
+  0,                                    /* tp_bases */
+  0,                                    /* tp_mro */
+  0,                                    /* tp_cache */
+  0,                                    /* tp_subclasses */
+  0,                                    /* tp_weaklist */
+  0,                                    /* tp_del */
+  0,                                    /* tp_version_tag */
+  0,                                    /* tp_finalize */
+  ArrayList_vectorcall,                 /* tp_vectorcall */
+};
+
+
+/* ArrayDeque
+ * Circular-array-based implementation of the List interface.  Items occupy
+ * the size slots starting at head and wrap around the end of data, so adding
+ * or removing at either end is O(1), and insert() and remove() shift
+ * whichever side of index is shorter.  Unused slots hold NULL.  Growth
+ * follows ArrayList: opt-in, geometric, with an optional shrink threshold. */
+
+typedef struct {
+  PyObject_HEAD
+  Py_ssize_t capacity;
+  Py_ssize_t size;
+  Py_ssize_t head;
+  PyObject   **data;
+  int        growable;
+  double     shrink_threshold;
+  long       state;
+#if EDUCOLLECTIONS_STATS
+  ListStats  stats;
+#endif
+} ArrayDeque;
+
+/* Maps a logical index in [0, capacity) to its slot in data. */
+#define ArrayDeque_SLOT(self, index) \
+  ((self)->head + (index) < (self)->capacity ? \
+   (self)->head + (index) : (self)->head + (index) - (self)->capacity)
+
+PyDoc_STRVAR(ArrayDeque_doc,
+  "ArrayDeque(capacity, growable=False, shrink_threshold=0.0)\n"
+  "\n"
+  "Circular-array-based implementation of the List interface.\n"
+  "Adding or removing items at either end takes constant time.");
+
+/* Reallocates data to hold exactly capacity slots and unwraps the items so
+ * they start at slot 0. */
+static int
+ArrayDeque_resize(ArrayDeque *self, Py_ssize_t capacity)
+{
+  PyObject **data;
+  Py_ssize_t i;
+
+  assert(capacity >= self->size && capacity > 0);
+  data = PyMem_New(PyObject *, capacity);
+  if (data == NULL) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  for (i = 0; i < self->size; ++i) {
+    data[i] = self->data[ArrayDeque_SLOT(self, i)];
+  }
+  for (; i < capacity; ++i) {
+    data[i] = NULL;
+  }
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_ADD(self, frees, self->data != NULL);
+  PyMem_Del(self->data);
+  self->data = data;
+  self->capacity = capacity;
+  self->head = 0;
+  return 0;
+}
+
+/* Makes room for needed items, growing data geometrically if this
+ * ArrayDeque is growable. */
+static int
+ArrayDeque_make_room(ArrayDeque *self, Py_ssize_t needed)
+{
+  Py_ssize_t capacity;
+
+  if (needed <= self->capacity) {
+    return 0;
+  }
+  if (!self->growable) {
+    PyErr_SetString(PyExc_RuntimeError, "ArrayDeque is full (capacity == size)");
+    return -1;
+  }
+  capacity = self->capacity;
+  while (capacity < needed) {
+    if (capacity > PY_SSIZE_T_MAX / ARRAYLIST_GROWTH_FACTOR) {
+      capacity = needed;
+      break;
+    }
+    capacity *= ARRAYLIST_GROWTH_FACTOR;
+  }
+  return ArrayDeque_resize(self, capacity);
+}
+
+/* Gives memory back once a growable ArrayDeque drops below its shrink
+ * threshold; see ArrayList_maybe_shrink. */
+static void
+ArrayDeque_maybe_shrink(ArrayDeque *self)
+{
+  Py_ssize_t capacity;
+
+  if (!self->growable || self->shrink_threshold <= 0.0 ||
+      self->size >= self->capacity * self->shrink_threshold) {
+    return;
+  }
+  capacity = self->size * ARRAYLIST_GROWTH_FACTOR;
+  if (capacity < 1) {
+    capacity = 1;
+  }
+  if (capacity < self->capacity && ArrayDeque_resize(self, capacity) < 0) {
+    PyErr_Clear();
+  }
+}
+
+/* ArrayDequeType.tp_new */
+static PyObject *
+ArrayDeque_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  ArrayDeque *self;
+
+  self = (ArrayDeque *)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+  self->capacity = 0;
+  self->size = 0;
+  self->head = 0;
+  self->data = NULL;
+  self->growable = 0;
+  self->shrink_threshold = 0.0;
+  self->state = 0;
+  return (PyObject *)self;
+}
+
+/* ArrayDequeType.tp_init */
+static int
+ArrayDeque_init(ArrayDeque *self, PyObject *args, PyObject *kwds)
+{
+  PyObject **data, **tmp;
+  Py_ssize_t capacity, tmp_size, i;
+  int growable = 0;
+  double shrink_threshold = 0.0;
+  static char *kwlist[] = {"capacity", "growable", "shrink_threshold", NULL};
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|pd", kwlist, &capacity,
+                                   &growable, &shrink_threshold)) {
+    return -1;
+  }
+  if (capacity < 1) {
+    PyErr_SetString(PyExc_ValueError, "capacity must be greater than zero");
+    return -1;
+  }
+  if (!(shrink_threshold >= 0.0 &&
+        shrink_threshold < 1.0 / ARRAYLIST_GROWTH_FACTOR)) {
+    PyErr_SetString(PyExc_ValueError,
+                    "shrink_threshold must be in [0.0, 0.5)");
+    return -1;
+  }
+  data = PyMem_New(PyObject *, capacity);
+  if (data == NULL) {
+    PyErr_SetString(PyExc_MemoryError, "memory allocation request failed");
+    return -1;
+  }
+  for (i = 0; i < capacity; ++i) {
+    data[i] = NULL;
+  }
+  tmp = self->data;
+  tmp_size = self->capacity;
+  self->data = data;
+  self->capacity = capacity;
+  self->size = 0;
+  self->head = 0;
+  ++self->state;
+  self->growable = growable;
+  self->shrink_threshold = shrink_threshold;
+  for (i = 0; i < tmp_size; ++i) {
+    Py_XDECREF(tmp[i]);
+  }
+  PyMem_Del(tmp);
+  return 0;
+}
+
+/* ArrayDequeType.tp_traverse */
+static int
+ArrayDeque_traverse(ArrayDeque *self, visitproc visit, void *arg)
+{
+  Py_ssize_t i;
+
+  for (i = 0; i < self->size; ++i) {
+    Py_VISIT(self->data[ArrayDeque_SLOT(self, i)]);
+  }
+  return 0;
+}
+
+/* ArrayDequeType.tp_clear
+ * Releases the items from the front one at a time, keeping this ArrayDeque
+ * consistent whatever code releasing an item runs. */
+static int
+ArrayDeque_tp_clear(ArrayDeque *self)
+{
+  PyObject *item;
+
+  while (self->size > 0) {
+    item = self->data[self->head];
+    self->data[self->head] = NULL;
+    self->head = ArrayDeque_SLOT(self, 1);
+    self->size -= 1;
+    ++self->state;
+    Py_DECREF(item);
+  }
+  self->head = 0;
+  return 0;
+}
+
+/* ArrayDequeType.tp_dealloc */
+static void
+ArrayDeque_dealloc(ArrayDeque *self)
+{
+  Py_ssize_t i;
+
+  PyObject_GC_UnTrack(self);
+  for (i = 0; i < self->capacity; ++i) {
+    Py_XDECREF(self->data[i]);
+  }
+  PyMem_Del(self->data);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* Inserts item so that it ends up at index, which may equal size, moving
+ * the items on the shorter side of index by one slot. */
+static int
+ArrayDeque_insert_index(ArrayDeque *self, Py_ssize_t index, PyObject *item)
+{
+  Py_ssize_t i;
+
+  if (ArrayDeque_make_room(self, self->size + 1) < 0) {
+    return -1;
+  }
+  if (index < self->size - index) {
+    self->head = self->head > 0 ? self->head - 1 : self->capacity - 1;
+    for (i = 0; i < index; ++i) {
+      self->data[ArrayDeque_SLOT(self, i)] =
+        self->data[ArrayDeque_SLOT(self, i + 1)];
+    }
+    LISTSTATS_ADD(self, shifted, index);
+  }
+  else {
+    for (i = self->size; i > index; --i) {
+      self->data[ArrayDeque_SLOT(self, i)] =
+        self->data[ArrayDeque_SLOT(self, i - 1)];
+    }
+    LISTSTATS_ADD(self, shifted, self->size - index);
+  }
+  Py_INCREF(item);
+  self->data[ArrayDeque_SLOT(self, index)] = item;
+  ++self->size;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  return 0;
+}
+
+/* Removes and returns the item at index, which must be in range, moving the
+ * items on the shorter side of index by one slot. */
+static PyObject *
+ArrayDeque_remove_index(ArrayDeque *self, Py_ssize_t index)
+{
+  PyObject *item;
+  Py_ssize_t i;
+
+  item = self->data[ArrayDeque_SLOT(self, index)];
+  if (index < self->size - 1 - index) {
+    for (i = index; i > 0; --i) {
+      self->data[ArrayDeque_SLOT(self, i)] =
+        self->data[ArrayDeque_SLOT(self, i - 1)];
+    }
+    self->data[self->head] = NULL;
+    self->head = ArrayDeque_SLOT(self, 1);
+    LISTSTATS_ADD(self, shifted, index);
+  }
+  else {
+    for (i = index; i < self->size - 1; ++i) {
+      self->data[ArrayDeque_SLOT(self, i)] =
+        self->data[ArrayDeque_SLOT(self, i + 1)];
+    }
+    self->data[ArrayDeque_SLOT(self, self->size - 1)] = NULL;
+    LISTSTATS_ADD(self, shifted, self->size - 1 - index);
+  }
+  --self->size;
+  ++self->state;
+  ArrayDeque_maybe_shrink(self);
+  return item;
+}
+
+/* ArrayDeque.append(item) */
+static PyObject *
+ArrayDeque_append(ArrayDeque *self, PyObject *item)
+{
+  if (ArrayDeque_insert_index(self, self->size, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(ArrayDeque_capacity_doc,
+  "Returns the capacity of this ArrayDeque.");
+
+/* ArrayDeque.capacity() */
+static PyObject *
+ArrayDeque_capacity(ArrayDeque *self)
+{
+  return PyLong_FromSsize_t(self->capacity);
+}
+
+/* ArrayDeque.clear() */
+static PyObject *
+ArrayDeque_clear(ArrayDeque *self)
+{
+  ArrayDeque_tp_clear(self);
+  ++self->state;
+  ArrayDeque_maybe_shrink(self);
+  Py_RETURN_NONE;
+}
+
+/* ArrayDeque.extend(iterable) */
+static PyObject *
+ArrayDeque_extend(ArrayDeque *self, PyObject *iterable)
+{
+  PyObject *seq, **items;
+  Py_ssize_t n, i;
+
+  seq = PySequence_Fast(iterable,
+                        "ArrayDeque.extend() argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  if (ArrayDeque_make_room(self, self->size + n) < 0) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  items = PySequence_Fast_ITEMS(seq);
+  for (i = 0; i < n; ++i) {
+    Py_INCREF(items[i]);
+    self->data[ArrayDeque_SLOT(self, self->size + i)] = items[i];
+  }
+  self->size += n;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  Py_DECREF(seq);
+  Py_RETURN_NONE;
+}
+
+/* ArrayDeque.from_iterable(iterable, **kwds)
+ * The new ArrayDeque is sized to fit; kwds are passed to the constructor. */
+static PyObject *
+ArrayDeque_from_iterable(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  PyObject *iterable, *seq, *self, *result;
+  Py_ssize_t n;
+
+  if (!PyArg_UnpackTuple(args, "from_iterable", 1, 1, &iterable)) {
+    return NULL;
+  }
+  seq = PySequence_Fast(iterable,
+                        "ArrayDeque.from_iterable() argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  args = Py_BuildValue("(n)", n > 0 ? n : 1);
+  if (args == NULL) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  self = PyObject_Call((PyObject *)type, args, kwds);
+  Py_DECREF(args);
+  if (self == NULL) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  result = ArrayDeque_extend((ArrayDeque *)self, seq);
+  Py_DECREF(seq);
+  if (result == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  Py_DECREF(result);
+  return self;
+}
+
+/* ArrayDequeType.tp_as_sequence->sq_item */
+static PyObject *
+ArrayDeque_item(ArrayDeque *self, Py_ssize_t index)
+{
+  PyObject *item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "ArrayDeque index out of range");
+    return NULL;
+  }
+  item = self->data[ArrayDeque_SLOT(self, index)];
+  Py_INCREF(item);
+  return item;
+}
+
+/* ArrayDeque.get(index) */
+static PyObject *
+ArrayDeque_get(ArrayDeque *self, PyObject *indexobj)
+{
+  Py_ssize_t index;
+
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  return ArrayDeque_item(self, index);
+}
+
+/* ArrayDeque.insert(index, item) */
+static PyObject *
+ArrayDeque_insert(ArrayDeque *self, PyObject *const *args, Py_ssize_t nargs)
+{
+  PyObject *itemobj;
+  Py_ssize_t index;
+
+  if (!List_check_nargs("insert", nargs, 2)) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  itemobj = args[1];
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "ArrayDeque index out of range");
+    return NULL;
+  }
+  if (ArrayDeque_insert_index(self, index, itemobj) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(ArrayDeque_pop_back_doc,
+  "Removes and returns the item at the end of this ArrayDeque.");
+
+/* ArrayDeque.pop_back() */
+static PyObject *
+ArrayDeque_pop_back(ArrayDeque *self)
+{
+  if (self->size == 0) {
+    PyErr_SetString(PyExc_IndexError, "pop from an empty ArrayDeque");
+    return NULL;
+  }
+  return ArrayDeque_remove_index(self, self->size - 1);
+}
+
+PyDoc_STRVAR(ArrayDeque_pop_front_doc,
+  "Removes and returns the item at the front of this ArrayDeque.");
+
+/* ArrayDeque.pop_front() */
+static PyObject *
+ArrayDeque_pop_front(ArrayDeque *self)
+{
+  if (self->size == 0) {
+    PyErr_SetString(PyExc_IndexError, "pop from an empty ArrayDeque");
+    return NULL;
+  }
+  return ArrayDeque_remove_index(self, 0);
+}
+
+/* ArrayDeque.prepend(item) */
+static PyObject *
+ArrayDeque_prepend(ArrayDeque *self, PyObject *item)
+{
+  if (ArrayDeque_insert_index(self, 0, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* ArrayDeque.remove(index) */
+static PyObject *
+ArrayDeque_remove(ArrayDeque *self, PyObject *indexobj)
+{
+  Py_ssize_t index;
+
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "ArrayDeque index out of range");
+    return NULL;
+  }
+  return ArrayDeque_remove_index(self, index);
+}
+
+PyDoc_STRVAR(ArrayDeque_reserve_doc,
+  "Ensures this ArrayDeque can hold at least n items without reallocating.");
+
+/* ArrayDeque.reserve(n) */
+static PyObject *
+ArrayDeque_reserve(ArrayDeque *self, PyObject *nobj)
+{
+  Py_ssize_t n;
+
+  n = PyLong_AsSsize_t(nobj);
+  if (n == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (n > self->capacity && ArrayDeque_resize(self, n) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* ArrayDequeType.tp_as_sequence->sq_ass_item
+ * Assigns item at index, or deletes the item at index if item is NULL. */
+static int
+ArrayDeque_ass_item(ArrayDeque *self, Py_ssize_t index, PyObject *item)
+{
+  PyObject *old_item;
+  Py_ssize_t slot;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "ArrayDeque index out of range");
+    return -1;
+  }
+  if (item == NULL) {
+    old_item = ArrayDeque_remove_index(self, index);
+    Py_DECREF(old_item);
+    return 0;
+  }
+  ++self->state;
+  slot = ArrayDeque_SLOT(self, index);
+  Py_INCREF(item);
+  old_item = self->data[slot];
+  self->data[slot] = item;
+  Py_DECREF(old_item);
+  return 0;
+}
+
+/* ArrayDeque.set(index, item) */
+static PyObject *
+ArrayDeque_set(ArrayDeque *self, PyObject *const *args, Py_ssize_t nargs)
+{
+  PyObject *itemobj;
+  Py_ssize_t index;
+
+  if (!List_check_nargs("set", nargs, 2)) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  itemobj = args[1];
+  if (ArrayDeque_ass_item(self, index, itemobj) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(ArrayDeque_shrink_to_fit_doc,
+  "Reduces the capacity of this ArrayDeque to its size.");
+
+/* ArrayDeque.shrink_to_fit() */
+static PyObject *
+ArrayDeque_shrink_to_fit(ArrayDeque *self)
+{
+  Py_ssize_t capacity;
+
+  capacity = self->size > 0 ? self->size : 1;
+  if (capacity < self->capacity && ArrayDeque_resize(self, capacity) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* ArrayDeque.size() */
+static PyObject *
+ArrayDeque_size(ArrayDeque *self)
+{
+  return PyLong_FromSsize_t(self->size);
+}
+
+#if EDUCOLLECTIONS_STATS
+/* ArrayDeque.stats() */
+static PyObject *
+ArrayDeque_stats(ArrayDeque *self)
+{
+  return ListStats_dict(&self->stats);
+}
+
+/* ArrayDeque.reset_stats() */
+static PyObject *
+ArrayDeque_reset_stats(ArrayDeque *self)
+{
+  ListStats_reset(&self->stats, self->size);
+  Py_RETURN_NONE;
+}
+#endif
+
+/* ArrayDequeType.tp_as_sequence->sq_length */
+static Py_ssize_t
+ArrayDeque_length(ArrayDeque *self)
+{
+  return self->size;
+}
+
+/* ArrayDequeType.tp_as_sequence->sq_contains
+ * A comparison that mutates this ArrayDeque may move or release the items
+ * being searched, so that raises RuntimeError. */
+static int
+ArrayDeque_contains(ArrayDeque *self, PyObject *item)
+{
+  Py_ssize_t i;
+  long state = self->state;
+  int cmp = 0;
+
+  for (i = 0; cmp == 0 && i < self->size; ++i) {
+    cmp = List_item_eq(self->data[ArrayDeque_SLOT(self, i)], item);
+    if (cmp >= 0 && self->state != state) {
+      PyErr_SetString(PyExc_RuntimeError,
+                      "ArrayDeque mutated during search");
+      return -1;
+    }
+  }
+  return cmp;
+}
+
+/* ArrayDequeType.tp_as_mapping->mp_subscript
+ * Slicing returns a new ArrayDeque with the same growth settings. */
+static PyObject *
+ArrayDeque_subscript(ArrayDeque *self, PyObject *key)
+{
+  ArrayDeque *result;
+  Py_ssize_t index, start, stop, step, slicelength, i, j;
+  PyObject *item;
+
+  if (PyIndex_Check(key)) {
+    index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+    if (index < 0) {
+      index += self->size;
+    }
+    return ArrayDeque_item(self, index);
+  }
+  if (!PySlice_Check(key)) {
+    PyErr_Format(PyExc_TypeError,
+                 "ArrayDeque indices must be integers or slices, not %.200s",
+                 Py_TYPE(key)->tp_name);
+    return NULL;
+  }
+  if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+    return NULL;
+  }
+  slicelength = PySlice_AdjustIndices(self->size, &start, &stop, step);
+  result = (ArrayDeque *)PyObject_CallFunction((PyObject *)Py_TYPE(self), "n",
+                                               slicelength > 0 ? slicelength : 1);
+  if (result == NULL) {
+    return NULL;
+  }
+  result->growable = self->growable;
+  result->shrink_threshold = self->shrink_threshold;
+  for (i = start, j = 0; j < slicelength; i += step, ++j) {
+    item = self->data[ArrayDeque_SLOT(self, i)];
+    Py_INCREF(item);
+    result->data[j] = item;
+  }
+  result->size = slicelength;
+  LISTSTATS_PEAK(result);
+  return (PyObject *)result;
+}
+
+/* ArrayDequeType.tp_as_sequence->sq_inplace_concat */
+static PyObject *
+ArrayDeque_inplace_concat(ArrayDeque *self, PyObject *other)
+{
+  PyObject *result;
+
+  result = ArrayDeque_extend(self, other);
+  if (result == NULL) {
+    return NULL;
+  }
+  Py_DECREF(result);
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
+
+/* ArrayDequeIterator
+ * Iterates over an ArrayDeque by logical index, raising if the ArrayDeque
+ * is mutated before iteration ends. */
+typedef struct {
+  PyObject_HEAD
+  ArrayDeque *deque;
+  Py_ssize_t index;
+  long       state;
+} ArrayDequeIterator;
+
+/* ArrayDequeType.tp_iter */
+static PyObject *
+ArrayDeque_iter(ArrayDeque *self)
+{
+  ArrayDequeIterator *it;
+
+  it = PyObject_GC_New(ArrayDequeIterator, &ArrayDequeIteratorType);
+  if (it == NULL) {
+    return NULL;
+  }
+  Py_INCREF(self);
+  it->deque = self;
+  it->index = 0;
+  it->state = self->state;
+  PyObject_GC_Track(it);
+  return (PyObject *)it;
+}
+
+/* ArrayDequeIteratorType.tp_dealloc */
+static void
+ArrayDequeIterator_dealloc(ArrayDequeIterator *self)
+{
+  PyObject_GC_UnTrack(self);
+  Py_XDECREF(self->deque);
+  PyObject_GC_Del(self);
+}
+
+/* ArrayDequeIteratorType.tp_traverse */
+static int
+ArrayDequeIterator_traverse(ArrayDequeIterator *self, visitproc visit,
+                            void *arg)
+{
+  Py_VISIT(self->deque);
+  return 0;
+}
+
+/* ArrayDequeIteratorType.tp_clear */
+static int
+ArrayDequeIterator_clear(ArrayDequeIterator *self)
+{
+  Py_CLEAR(self->deque);
+  return 0;
+}
+
+/* ArrayDequeIteratorType.tp_iternext */
+static PyObject *
+ArrayDequeIterator_next(ArrayDequeIterator *self)
+{
+  PyObject *item;
+
+  if (self->deque == NULL) {
+    return NULL;
+  }
+  if (self->deque->state != self->state) {
+    PyErr_SetString(PyExc_RuntimeError, "ArrayDeque mutated during iteration");
+    Py_CLEAR(self->deque);
+    return NULL;
+  }
+  if (self->index >= self->deque->size) {
+    Py_CLEAR(self->deque);
+    return NULL;
+  }
+  item = self->deque->data[ArrayDeque_SLOT(self->deque, self->index)];
+  ++self->index;
+  Py_INCREF(item);
+  return item;
+}
+
+PyTypeObject ArrayDequeIteratorType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.ArrayDequeIterator", /* tp_name */
+  sizeof(ArrayDequeIterator),           /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)ArrayDequeIterator_dealloc,
+                                        /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  0,                                    /* tp_repr */
+  0,                                    /* tp_as_number */
+  0,                                    /* tp_as_sequence */
+  0,                                    /* tp_as_mapping */
+  0,                                    /* tp_hash  */
+  0,                                    /* tp_call */
+  0,                                    /* tp_str */
+  PyObject_GenericGetAttr,              /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  0,                                    /* tp_doc */
+  (traverseproc)ArrayDequeIterator_traverse,
+                                        /* tp_traverse */
+  (inquiry)ArrayDequeIterator_clear,    /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  PyObject_SelfIter,                    /* tp_iter */
+  (iternextfunc)ArrayDequeIterator_next,/* tp_iternext */
+};
+
+/* ArrayDequeType.tp_repr */
+static PyObject *
+ArrayDeque_repr(PyObject *self)
+{
+  return PyUnicode_FromString("[...]");
+}
+
+/* ArrayDequeType.tp_str */
+static PyObject *
+ArrayDeque_str(PyObject *self)
+{
+  return PyUnicode_FromString("[...]");
+}
+
+/* ArrayDequeType.tp_methods */
+static PyMethodDef ArrayDeque_methods[] = {
+  {"append",                  (PyCFunction)ArrayDeque_append,
+      METH_O,                  List_append_doc},
+  {"capacity",                (PyCFunction)ArrayDeque_capacity,
+      METH_NOARGS,             ArrayDeque_capacity_doc},
+  {"clear",                   (PyCFunction)ArrayDeque_clear,
+      METH_NOARGS,             List_clear_doc},
+  {"extend",                  (PyCFunction)ArrayDeque_extend,
+      METH_O,                  List_extend_doc},
+  {"from_iterable",           (PyCFunction)ArrayDeque_from_iterable,
+      METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+                               List_from_iterable_doc},
+  {"get",                     (PyCFunction)ArrayDeque_get,
+      METH_O,                  List_get_doc},
+  {"insert",                  (PyCFunction)ArrayDeque_insert,
+      METH_FASTCALL,           List_insert_doc},
+  {"pop_back",                (PyCFunction)ArrayDeque_pop_back,
+      METH_NOARGS,             ArrayDeque_pop_back_doc},
+  {"pop_front",               (PyCFunction)ArrayDeque_pop_front,
+      METH_NOARGS,             ArrayDeque_pop_front_doc},
+  {"prepend",                 (PyCFunction)ArrayDeque_prepend,
+      METH_O,                  List_prepend_doc},
+  {"remove",                  (PyCFunction)ArrayDeque_remove,
+      METH_O,                  List_remove_doc},
+  {"reserve",                 (PyCFunction)ArrayDeque_reserve,
+      METH_O,                  ArrayDeque_reserve_doc},
+#if EDUCOLLECTIONS_STATS
+  {"reset_stats",             (PyCFunction)ArrayDeque_reset_stats,
+      METH_NOARGS,             List_reset_stats_doc},
+#endif
+  {"set",                     (PyCFunction)ArrayDeque_set,
+      METH_FASTCALL,           List_set_doc},
+  {"shrink_to_fit",           (PyCFunction)ArrayDeque_shrink_to_fit,
+      METH_NOARGS,             ArrayDeque_shrink_to_fit_doc},
+  {"size",                    (PyCFunction)ArrayDeque_size,
+      METH_NOARGS,             List_size_doc},
+#if EDUCOLLECTIONS_STATS
+  {"stats",                   (PyCFunction)ArrayDeque_stats,
+      METH_NOARGS,             List_stats_doc},
+#endif
+  {NULL,                      NULL}
+};
+
+static PySequenceMethods ArrayDeque_as_sequence = {
+  (lenfunc)ArrayDeque_length,           /* sq_length */
+  0,                                    /* sq_concat */
+  0,                                    /* sq_repeat */
+  (ssizeargfunc)ArrayDeque_item,        /* sq_item */
+  0,                                    /* was_sq_slice */
+  (ssizeobjargproc)ArrayDeque_ass_item, /* sq_ass_item */
+  0,                                    /* was_sq_ass_slice */
+  (objobjproc)ArrayDeque_contains,      /* sq_contains */
+  (binaryfunc)ArrayDeque_inplace_concat,/* sq_inplace_concat */
+  0,                                    /* sq_inplace_repeat */
+};
+
+static PyMappingMethods ArrayDeque_as_mapping = {
+  (lenfunc)ArrayDeque_length,           /* mp_length */
+  (binaryfunc)ArrayDeque_subscript,     /* mp_subscript */
+  0,                                    /* mp_ass_subscript */
+};
+
+PyTypeObject ArrayDequeType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.ArrayDeque",         /* tp_name */
+  sizeof(ArrayDeque),                   /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)ArrayDeque_dealloc,       /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  ArrayDeque_repr,                      /* tp_repr */
+  0,                                    /* tp_as_number */
+  &ArrayDeque_as_sequence,              /* tp_as_sequence */
+  &ArrayDeque_as_mapping,               /* tp_as_mapping */
+  PyObject_HashNotImplemented,          /* tp_hash  */
+  0,                                    /* tp_call */
+  ArrayDeque_str,                       /* tp_str */
+  0,                                    /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_BASETYPE |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  ArrayDeque_doc,                       /* tp_doc */
+  (traverseproc)ArrayDeque_traverse,    /* tp_traverse */
+  (inquiry)ArrayDeque_tp_clear,         /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  (getiterfunc)ArrayDeque_iter,         /* tp_iter */
+  0,                                    /* tp_iternext */
+  ArrayDeque_methods,                   /* tp_methods */
+  0,                                    /* tp_members */
+  0,                                    /* tp_getset */
+  0,                                    /* tp_base */
+  0,                                    /* tp_dict */
+  0,                                    /* tp_descr_get */
+  0,                                    /* tp_descr_set */
+  0,                                    /* tp_dictoffset */
+  (initproc)ArrayDeque_init,            /* tp_init */
+  PyType_GenericAlloc,                  /* tp_alloc */
+  ArrayDeque_new,                       /* tp_new */
+  PyObject_GC_Del,                      /* tp_free */
+};
+
+
+/* GapBufferList
+ * Gap-buffer implementation of the List interface for editing around a
+ * cursor.  Items before the cursor fill data from the front and items after
+ * it fill data from the back; the unused slots between them are the gap,
+ * which starts at the cursor.  Inserting or removing at the cursor only
+ * moves a gap boundary, and moving the cursor moves the items it passes
+ * across the gap.  get() and set() map an index around the gap in O(1).
+ * Gap slots are not initialized.  Growth follows ArrayList: opt-in,
+ * geometric, with an optional shrink threshold. */
+
+typedef struct {
+  PyObject_HEAD
+  Py_ssize_t capacity;
+  Py_ssize_t size;
+  Py_ssize_t gap_start;
+  Py_ssize_t gap_end;
+  PyObject   **data;
+  int        growable;
+  double     shrink_threshold;
+  long       state;
+#if EDUCOLLECTIONS_STATS
+  ListStats  stats;
+#endif
+} GapBufferList;
+
+/* Maps an index in [0, size) to its slot in data. */
+#define GapBufferList_SLOT(self, index) \
+  ((index) < (self)->gap_start ? \
+   (index) : (index) + (self)->gap_end - (self)->gap_start)
+
+PyDoc_STRVAR(GapBufferList_doc,
+  "GapBufferList(capacity, growable=False, shrink_threshold=0.0)\n"
+  "\n"
+  "Gap-buffer implementation of the List interface.\n"
+  "Inserting and removing at the cursor takes constant time; moving the\n"
+  "cursor takes time proportional to the distance moved.  Positional\n"
+  "insert() and remove() move the cursor to the index first.");
+
+/* Moves the gap so that it starts at index, which may equal size, by
+ * copying the items between the old and new position across it. */
+static void
+GapBufferList_move_gap(GapBufferList *self, Py_ssize_t index)
+{
+  Py_ssize_t n;
+
+  if (index < self->gap_start) {
+    n = self->gap_start - index;
+    memmove(self->data + self->gap_end - n, self->data + index,
+            n * sizeof(PyObject *));
+    self->gap_start -= n;
+    self->gap_end -= n;
+    LISTSTATS_ADD(self, shifted, n);
+  }
+  else if (index > self->gap_start) {
+    n = index - self->gap_start;
+    memmove(self->data + self->gap_start, self->data + self->gap_end,
+            n * sizeof(PyObject *));
+    self->gap_start += n;
+    self->gap_end += n;
+    LISTSTATS_ADD(self, shifted, n);
+  }
+}
+
+/* Reallocates data to hold exactly capacity slots, keeping the cursor and
+ * widening or narrowing the gap. */
+static int
+GapBufferList_resize(GapBufferList *self, Py_ssize_t capacity)
+{
+  PyObject **data;
+  Py_ssize_t after;
+
+  assert(capacity >= self->size && capacity > 0);
+  data = PyMem_New(PyObject *, capacity);
+  if (data == NULL) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  after = self->capacity - self->gap_end;
+  if (self->data != NULL) {
+    memcpy(data, self->data, self->gap_start * sizeof(PyObject *));
+    memcpy(data + capacity - after, self->data + self->gap_end,
+           after * sizeof(PyObject *));
+  }
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_ADD(self, frees, self->data != NULL);
+  PyMem_Del(self->data);
+  self->data = data;
+  self->capacity = capacity;
+  self->gap_end = capacity - after;
+  return 0;
+}
+
+/* Makes room for needed items, growing data geometrically if this
+ * GapBufferList is growable. */
+static int
+GapBufferList_make_room(GapBufferList *self, Py_ssize_t needed)
+{
+  Py_ssize_t capacity;
+
+  if (needed <= self->capacity) {
+    return 0;
+  }
+  if (!self->growable) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "GapBufferList is full (capacity == size)");
+    return -1;
+  }
+  capacity = self->capacity;
+  while (capacity < needed) {
+    if (capacity > PY_SSIZE_T_MAX / ARRAYLIST_GROWTH_FACTOR) {
+      capacity = needed;
+      break;
+    }
+    capacity *= ARRAYLIST_GROWTH_FACTOR;
+  }
+  return GapBufferList_resize(self, capacity);
+}
+
+/* Gives memory back once a growable GapBufferList drops below its shrink
+ * threshold; see ArrayList_maybe_shrink. */
+static void
+GapBufferList_maybe_shrink(GapBufferList *self)
+{
+  Py_ssize_t capacity;
+
+  if (!self->growable || self->shrink_threshold <= 0.0 ||
+      self->size >= self->capacity * self->shrink_threshold) {
+    return;
+  }
+  capacity = self->size * ARRAYLIST_GROWTH_FACTOR;
+  if (capacity < 1) {
+    capacity = 1;
+  }
+  if (capacity < self->capacity && GapBufferList_resize(self, capacity) < 0) {
+    PyErr_Clear();
+  }
+}
+
+/* Releases the items held in data[0:capacity] outside the gap. */
+static void
+GapBufferList_release(PyObject **data, Py_ssize_t capacity,
+                      Py_ssize_t gap_start, Py_ssize_t gap_end)
+{
+  Py_ssize_t i;
+
+  for (i = 0; i < gap_start; ++i) {
+    Py_DECREF(data[i]);
+  }
+  for (i = gap_end; i < capacity; ++i) {
+    Py_DECREF(data[i]);
+  }
+}
+
+/* GapBufferListType.tp_new */
+static PyObject *
+GapBufferList_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  GapBufferList *self;
+
+  self = (GapBufferList *)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+  self->capacity = 0;
+  self->size = 0;
+  self->gap_start = 0;
+  self->gap_end = 0;
+  self->data = NULL;
+  self->growable = 0;
+  self->shrink_threshold = 0.0;
+  self->state = 0;
+  return (PyObject *)self;
+}
+
+/* GapBufferListType.tp_init */
+static int
+GapBufferList_init(GapBufferList *self, PyObject *args, PyObject *kwds)
+{
+  PyObject **data, **tmp;
+  Py_ssize_t capacity, tmp_capacity, tmp_gap_start, tmp_gap_end;
+  int growable = 0;
+  double shrink_threshold = 0.0;
+  static char *kwlist[] = {"capacity", "growable", "shrink_threshold", NULL};
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|pd", kwlist, &capacity,
+                                   &growable, &shrink_threshold)) {
+    return -1;
+  }
+  if (capacity < 1) {
+    PyErr_SetString(PyExc_ValueError, "capacity must be greater than zero");
+    return -1;
+  }
+  if (!(shrink_threshold >= 0.0 &&
+        shrink_threshold < 1.0 / ARRAYLIST_GROWTH_FACTOR)) {
+    PyErr_SetString(PyExc_ValueError,
+                    "shrink_threshold must be in [0.0, 0.5)");
+    return -1;
+  }
+  data = PyMem_New(PyObject *, capacity);
+  if (data == NULL) {
+    PyErr_SetString(PyExc_MemoryError, "memory allocation request failed");
+    return -1;
+  }
+  tmp = self->data;
+  tmp_capacity = self->capacity;
+  tmp_gap_start = self->gap_start;
+  tmp_gap_end = self->gap_end;
+  self->data = data;
+  self->capacity = capacity;
+  self->size = 0;
+  self->gap_start = 0;
+  self->gap_end = capacity;
+  ++self->state;
+  self->growable = growable;
+  self->shrink_threshold = shrink_threshold;
+  if (tmp != NULL) {
+    GapBufferList_release(tmp, tmp_capacity, tmp_gap_start, tmp_gap_end);
+  }
+  PyMem_Del(tmp);
+  return 0;
+}
+
+/* GapBufferListType.tp_traverse */
+static int
+GapBufferList_traverse(GapBufferList *self, visitproc visit, void *arg)
+{
+  Py_ssize_t i;
+
+  for (i = 0; i < self->size; ++i) {
+    Py_VISIT(self->data[GapBufferList_SLOT(self, i)]);
+  }
+  return 0;
+}
+
+/* GapBufferListType.tp_clear
+ * Releases the items one at a time, working outwards from the cursor, so
+ * this GapBufferList stays consistent whatever code releasing an item runs
+ * and nothing has to be allocated. */
+static int
+GapBufferList_tp_clear(GapBufferList *self)
+{
+  PyObject *item;
+
+  while (self->size > 0) {
+    if (self->gap_end < self->capacity) {
+      item = self->data[self->gap_end++];
+    }
+    else {
+      item = self->data[--self->gap_start];
+    }
+    self->size -= 1;
+    ++self->state;
+    Py_DECREF(item);
+  }
+  return 0;
+}
+
+/* GapBufferListType.tp_dealloc */
+static void
+GapBufferList_dealloc(GapBufferList *self)
+{
+  PyObject_GC_UnTrack(self);
+  if (self->data != NULL) {
+    GapBufferList_release(self->data, self->capacity, self->gap_start,
+                          self->gap_end);
+  }
+  PyMem_Del(self->data);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* Inserts item so that it ends up at index, which may equal size, and
+ * leaves the cursor just after it. */
+static int
+GapBufferList_insert_index(GapBufferList *self, Py_ssize_t index,
+                           PyObject *item)
+{
+  if (GapBufferList_make_room(self, self->size + 1) < 0) {
+    return -1;
+  }
+  GapBufferList_move_gap(self, index);
+  Py_INCREF(item);
+  self->data[self->gap_start++] = item;
+  ++self->size;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  return 0;
+}
+
+/* Removes and returns the item at index, which must be in range, and
+ * leaves the cursor where it was. */
+static PyObject *
+GapBufferList_remove_index(GapBufferList *self, Py_ssize_t index)
+{
+  PyObject *item;
+
+  GapBufferList_move_gap(self, index);
+  item = self->data[self->gap_end++];
+  --self->size;
+  ++self->state;
+  GapBufferList_maybe_shrink(self);
+  return item;
+}
+
+/* GapBufferList.append(item) */
+static PyObject *
+GapBufferList_append(GapBufferList *self, PyObject *item)
+{
+  if (GapBufferList_insert_index(self, self->size, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GapBufferList_capacity_doc,
+  "Returns the capacity of this GapBufferList.");
+
+/* GapBufferList.capacity() */
+static PyObject *
+GapBufferList_capacity(GapBufferList *self)
+{
+  return PyLong_FromSsize_t(self->capacity);
+}
+
+/* GapBufferList.clear() */
+static PyObject *
+GapBufferList_clear(GapBufferList *self)
+{
+  GapBufferList_tp_clear(self);
+  ++self->state;
+  GapBufferList_maybe_shrink(self);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GapBufferList_cursor_doc,
+  "Returns the cursor position of this GapBufferList, an index in\n"
+  "[0, size].");
+
+/* GapBufferList.cursor() */
+static PyObject *
+GapBufferList_cursor(GapBufferList *self)
+{
+  return PyLong_FromSsize_t(self->gap_start);
+}
+
+/* GapBufferList.extend(iterable)
+ * The items are copied into the gap after moving it to the end. */
+static PyObject *
+GapBufferList_extend(GapBufferList *self, PyObject *iterable)
+{
+  PyObject *seq, **items;
+  Py_ssize_t n, i;
+
+  seq = PySequence_Fast(iterable,
+                        "GapBufferList.extend() argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  if (GapBufferList_make_room(self, self->size + n) < 0) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  GapBufferList_move_gap(self, self->size);
+  items = PySequence_Fast_ITEMS(seq);
+  for (i = 0; i < n; ++i) {
+    Py_INCREF(items[i]);
+    self->data[self->gap_start++] = items[i];
+  }
+  self->size += n;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  Py_DECREF(seq);
+  Py_RETURN_NONE;
+}
+
+/* GapBufferList.from_iterable(iterable, **kwds)
+ * The new GapBufferList is sized to fit; kwds are passed to the
+ * constructor. */
+static PyObject *
+GapBufferList_from_iterable(PyTypeObject *type, PyObject *args,
+                            PyObject *kwds)
+{
+  PyObject *iterable, *seq, *self, *result;
+  Py_ssize_t n;
+
+  if (!PyArg_UnpackTuple(args, "from_iterable", 1, 1, &iterable)) {
+    return NULL;
+  }
+  seq = PySequence_Fast(iterable,
+                        "GapBufferList.from_iterable() argument must be "
+                        "iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  args = Py_BuildValue("(n)", n > 0 ? n : 1);
+  if (args == NULL) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  self = PyObject_Call((PyObject *)type, args, kwds);
+  Py_DECREF(args);
+  if (self == NULL) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  result = GapBufferList_extend((GapBufferList *)self, seq);
+  Py_DECREF(seq);
+  if (result == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  Py_DECREF(result);
+  return self;
+}
+
+/* GapBufferListType.tp_as_sequence->sq_item */
+static PyObject *
+GapBufferList_item(GapBufferList *self, Py_ssize_t index)
+{
+  PyObject *item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "GapBufferList index out of range");
+    return NULL;
+  }
+  item = self->data[GapBufferList_SLOT(self, index)];
+  Py_INCREF(item);
+  return item;
+}
+
+/* GapBufferList.get(index) */
+static PyObject *
+GapBufferList_get(GapBufferList *self, PyObject *indexobj)
+{
+  Py_ssize_t index;
+
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  return GapBufferList_item(self, index);
+}
+
+/* GapBufferList.insert(index, item) */
+static PyObject *
+GapBufferList_insert(GapBufferList *self, PyObject *const *args,
+                     Py_ssize_t nargs)
+{
+  Py_ssize_t index;
+
+  if (!List_check_nargs("insert", nargs, 2)) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "GapBufferList index out of range");
+    return NULL;
+  }
+  if (GapBufferList_insert_index(self, index, args[1]) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GapBufferList_insert_at_cursor_doc,
+  "Inserts the given item at the cursor of this GapBufferList and moves the\n"
+  "cursor past it.");
+
+/* GapBufferList.insert_at_cursor(item) */
+static PyObject *
+GapBufferList_insert_at_cursor(GapBufferList *self, PyObject *item)
+{
+  if (GapBufferList_insert_index(self, self->gap_start, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GapBufferList_move_cursor_doc,
+  "Moves the cursor of this GapBufferList to the given index, which may\n"
+  "equal the size of this GapBufferList.");
+
+/* GapBufferList.move_cursor(index)
+ * Moving the cursor leaves the contents alone, so it does not invalidate
+ * iterators. */
+static PyObject *
+GapBufferList_move_cursor(GapBufferList *self, PyObject *indexobj)
+{
+  Py_ssize_t index;
+
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (index < 0 || index > self->size) {
+    PyErr_SetString(PyExc_IndexError, "GapBufferList cursor out of range");
+    return NULL;
+  }
+  GapBufferList_move_gap(self, index);
+  Py_RETURN_NONE;
+}
+
+/* GapBufferList.prepend(item) */
+static PyObject *
+GapBufferList_prepend(GapBufferList *self, PyObject *item)
+{
+  if (GapBufferList_insert_index(self, 0, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* GapBufferList.remove(index) */
+static PyObject *
+GapBufferList_remove(GapBufferList *self, PyObject *indexobj)
+{
+  Py_ssize_t index;
+
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "GapBufferList index out of range");
+    return NULL;
+  }
+  return GapBufferList_remove_index(self, index);
+}
+
+PyDoc_STRVAR(GapBufferList_remove_after_cursor_doc,
+  "Removes and returns the item just after the cursor of this\n"
+  "GapBufferList.  The cursor stays where it is.");
+
+/* GapBufferList.remove_after_cursor() */
+static PyObject *
+GapBufferList_remove_after_cursor(GapBufferList *self)
+{
+  if (self->gap_end == self->capacity) {
+    PyErr_SetString(PyExc_IndexError, "no item after the cursor");
+    return NULL;
+  }
+  return GapBufferList_remove_index(self, self->gap_start);
+}
+
+PyDoc_STRVAR(GapBufferList_remove_before_cursor_doc,
+  "Removes and returns the item just before the cursor of this\n"
+  "GapBufferList.  The cursor moves back by one.");
+
+/* GapBufferList.remove_before_cursor()
+ * The item is taken off the front of the gap, so no item moves. */
+static PyObject *
+GapBufferList_remove_before_cursor(GapBufferList *self)
+{
+  PyObject *item;
+
+  if (self->gap_start == 0) {
+    PyErr_SetString(PyExc_IndexError, "no item before the cursor");
+    return NULL;
+  }
+  item = self->data[--self->gap_start];
+  --self->size;
+  ++self->state;
+  GapBufferList_maybe_shrink(self);
+  return item;
+}
+
+/* GapBufferListType.tp_as_sequence->sq_ass_item
+ * Assigns item at index, or deletes the item at index if item is NULL. */
+static int
+GapBufferList_ass_item(GapBufferList *self, Py_ssize_t index, PyObject *item)
+{
+  PyObject *old_item;
+  Py_ssize_t slot;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "GapBufferList index out of range");
+    return -1;
+  }
+  if (item == NULL) {
+    old_item = GapBufferList_remove_index(self, index);
+    Py_DECREF(old_item);
+    return 0;
+  }
+  ++self->state;
+  slot = GapBufferList_SLOT(self, index);
+  Py_INCREF(item);
+  old_item = self->data[slot];
+  self->data[slot] = item;
+  Py_DECREF(old_item);
+  return 0;
+}
+
+/* GapBufferList.set(index, item) */
+static PyObject *
+GapBufferList_set(GapBufferList *self, PyObject *const *args,
+                  Py_ssize_t nargs)
+{
+  Py_ssize_t index;
+
+  if (!List_check_nargs("set", nargs, 2)) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (GapBufferList_ass_item(self, index, args[1]) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* GapBufferList.size() */
+static PyObject *
+GapBufferList_size(GapBufferList *self)
+{
+  return PyLong_FromSsize_t(self->size);
+}
+
+#if EDUCOLLECTIONS_STATS
+/* GapBufferList.stats() */
+static PyObject *
+GapBufferList_stats(GapBufferList *self)
+{
+  return ListStats_dict(&self->stats);
+}
+
+/* GapBufferList.reset_stats() */
+static PyObject *
+GapBufferList_reset_stats(GapBufferList *self)
+{
+  ListStats_reset(&self->stats, self->size);
+  Py_RETURN_NONE;
+}
+#endif
+
+/* GapBufferListType.tp_as_sequence->sq_length */
+static Py_ssize_t
+GapBufferList_length(GapBufferList *self)
+{
+  return self->size;
+}
+
+/* GapBufferListType.tp_as_sequence->sq_contains
+ * A comparison that mutates this GapBufferList may move or release the
+ * items being searched, so that raises RuntimeError. */
+static int
+GapBufferList_contains(GapBufferList *self, PyObject *item)
+{
+  Py_ssize_t i;
+  long state = self->state;
+  int cmp = 0;
+
+  for (i = 0; cmp == 0 && i < self->size; ++i) {
+    cmp = List_item_eq(self->data[GapBufferList_SLOT(self, i)], item);
+    if (cmp >= 0 && self->state != state) {
+      PyErr_SetString(PyExc_RuntimeError,
+                      "GapBufferList mutated during search");
+      return -1;
+    }
+  }
+  return cmp;
+}
+
+/* GapBufferListType.tp_as_mapping->mp_subscript
+ * Slicing returns a new GapBufferList with the same growth settings and its
+ * cursor at the end. */
+static PyObject *
+GapBufferList_subscript(GapBufferList *self, PyObject *key)
+{
+  GapBufferList *result;
+  Py_ssize_t index, start, stop, step, slicelength, i, j;
+  PyObject *item;
+
+  if (PyIndex_Check(key)) {
+    index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+    if (index < 0) {
+      index += self->size;
+    }
+    return GapBufferList_item(self, index);
+  }
+  if (!PySlice_Check(key)) {
+    PyErr_Format(PyExc_TypeError,
+                 "GapBufferList indices must be integers or slices, "
+                 "not %.200s", Py_TYPE(key)->tp_name);
+    return NULL;
+  }
+  if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+    return NULL;
+  }
+  slicelength = PySlice_AdjustIndices(self->size, &start, &stop, step);
+  result = (GapBufferList *)PyObject_CallFunction(
+    (PyObject *)Py_TYPE(self), "n", slicelength > 0 ? slicelength : 1);
+  if (result == NULL) {
+    return NULL;
+  }
+  result->growable = self->growable;
+  result->shrink_threshold = self->shrink_threshold;
+  for (i = start, j = 0; j < slicelength; i += step, ++j) {
+    item = self->data[GapBufferList_SLOT(self, i)];
+    Py_INCREF(item);
+    result->data[j] = item;
+  }
+  result->size = slicelength;
+  result->gap_start = slicelength;
+  LISTSTATS_PEAK(result);
+  return (PyObject *)result;
+}
+
+/* GapBufferListType.tp_as_sequence->sq_inplace_concat */
+static PyObject *
+GapBufferList_inplace_concat(GapBufferList *self, PyObject *other)
+{
+  PyObject *result;
+
+  result = GapBufferList_extend(self, other);
+  if (result == NULL) {
+    return NULL;
+  }
+  Py_DECREF(result);
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
+
+/* GapBufferListIterator
+ * Iterates over a GapBufferList by index, raising if the GapBufferList is
+ * mutated before iteration ends.  Moving the cursor is not a mutation. */
+typedef struct {
+  PyObject_HEAD
+  GapBufferList *list;
+  Py_ssize_t    index;
+  long          state;
+} GapBufferListIterator;
+
+/* GapBufferListType.tp_iter */
+static PyObject *
+GapBufferList_iter(GapBufferList *self)
+{
+  GapBufferListIterator *it;
+
+  it = PyObject_GC_New(GapBufferListIterator, &GapBufferListIteratorType);
+  if (it == NULL) {
+    return NULL;
+  }
+  Py_INCREF(self);
+  it->list = self;
+  it->index = 0;
+  it->state = self->state;
+  PyObject_GC_Track(it);
+  return (PyObject *)it;
+}
+
+/* GapBufferListIteratorType.tp_dealloc */
+static void
+GapBufferListIterator_dealloc(GapBufferListIterator *self)
+{
+  PyObject_GC_UnTrack(self);
+  Py_XDECREF(self->list);
+  PyObject_GC_Del(self);
+}
+
+/* GapBufferListIteratorType.tp_traverse */
+static int
+GapBufferListIterator_traverse(GapBufferListIterator *self, visitproc visit,
+                               void *arg)
+{
+  Py_VISIT(self->list);
+  return 0;
+}
+
+/* GapBufferListIteratorType.tp_clear */
+static int
+GapBufferListIterator_clear(GapBufferListIterator *self)
+{
+  Py_CLEAR(self->list);
+  return 0;
+}
+
+/* GapBufferListIteratorType.tp_iternext */
+static PyObject *
+GapBufferListIterator_next(GapBufferListIterator *self)
+{
+  PyObject *item;
+
+  if (self->list == NULL) {
+    return NULL;
+  }
+  if (self->list->state != self->state) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "GapBufferList mutated during iteration");
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  if (self->index >= self->list->size) {
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  item = self->list->data[GapBufferList_SLOT(self->list, self->index)];
+  ++self->index;
+  Py_INCREF(item);
+  return item;
+}
+
+PyTypeObject GapBufferListIteratorType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.GapBufferListIterator",
+                                        /* tp_name */
+  sizeof(GapBufferListIterator),        /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)GapBufferListIterator_dealloc,
+                                        /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  0,                                    /* tp_repr */
+  0,                                    /* tp_as_number */
+  0,                                    /* tp_as_sequence */
+  0,                                    /* tp_as_mapping */
+  0,                                    /* tp_hash  */
+  0,                                    /* tp_call */
+  0,                                    /* tp_str */
+  PyObject_GenericGetAttr,              /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  0,                                    /* tp_doc */
+  (traverseproc)GapBufferListIterator_traverse,
+                                        /* tp_traverse */
+  (inquiry)GapBufferListIterator_clear, /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  PyObject_SelfIter,                    /* tp_iter */
+  (iternextfunc)GapBufferListIterator_next,
+                                        /* tp_iternext */
+};
+
+/* GapBufferListType.tp_repr */
+static PyObject *
+GapBufferList_repr(PyObject *self)
+{
+  return PyUnicode_FromString("[...]");
+}
+
+/* GapBufferListType.tp_str */
+static PyObject *
+GapBufferList_str(PyObject *self)
+{
+  return PyUnicode_FromString("[...]");
+}
+
+/* GapBufferListType.tp_methods */
+static PyMethodDef GapBufferList_methods[] = {
+  {"append",                  (PyCFunction)GapBufferList_append,
+      METH_O,                  List_append_doc},
+  {"capacity",                (PyCFunction)GapBufferList_capacity,
+      METH_NOARGS,             GapBufferList_capacity_doc},
+  {"clear",                   (PyCFunction)GapBufferList_clear,
+      METH_NOARGS,             List_clear_doc},
+  {"cursor",                  (PyCFunction)GapBufferList_cursor,
+      METH_NOARGS,             GapBufferList_cursor_doc},
+  {"extend",                  (PyCFunction)GapBufferList_extend,
+      METH_O,                  List_extend_doc},
+  {"from_iterable",           (PyCFunction)GapBufferList_from_iterable,
+      METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+                               List_from_iterable_doc},
+  {"get",                     (PyCFunction)GapBufferList_get,
+      METH_O,                  List_get_doc},
+  {"insert",                  (PyCFunction)GapBufferList_insert,
+      METH_FASTCALL,           List_insert_doc},
+  {"insert_at_cursor",        (PyCFunction)GapBufferList_insert_at_cursor,
+      METH_O,                  GapBufferList_insert_at_cursor_doc},
+  {"move_cursor",             (PyCFunction)GapBufferList_move_cursor,
+      METH_O,                  GapBufferList_move_cursor_doc},
+  {"prepend",                 (PyCFunction)GapBufferList_prepend,
+      METH_O,                  List_prepend_doc},
+  {"remove",                  (PyCFunction)GapBufferList_remove,
+      METH_O,                  List_remove_doc},
+  {"remove_after_cursor",     (PyCFunction)GapBufferList_remove_after_cursor,
+      METH_NOARGS,             GapBufferList_remove_after_cursor_doc},
+  {"remove_before_cursor",    (PyCFunction)GapBufferList_remove_before_cursor,
+      METH_NOARGS,             GapBufferList_remove_before_cursor_doc},
+#if EDUCOLLECTIONS_STATS
+  {"reset_stats",             (PyCFunction)GapBufferList_reset_stats,
+      METH_NOARGS,             List_reset_stats_doc},
+#endif
+  {"set",                     (PyCFunction)GapBufferList_set,
+      METH_FASTCALL,           List_set_doc},
+  {"size",                    (PyCFunction)GapBufferList_size,
+      METH_NOARGS,             List_size_doc},
+#if EDUCOLLECTIONS_STATS
+  {"stats",                   (PyCFunction)GapBufferList_stats,
+      METH_NOARGS,             List_stats_doc},
+#endif
+  {NULL,                      NULL}
+};
+
+static PySequenceMethods GapBufferList_as_sequence = {
+  (lenfunc)GapBufferList_length,        /* sq_length */
+  0,                                    /* sq_concat */
+  0,                                    /* sq_repeat */
+  (ssizeargfunc)GapBufferList_item,     /* sq_item */
+  0,                                    /* was_sq_slice */
+  (ssizeobjargproc)GapBufferList_ass_item,
+                                        /* sq_ass_item */
+  0,                                    /* was_sq_ass_slice */
+  (objobjproc)GapBufferList_contains,   /* sq_contains */
+  (binaryfunc)GapBufferList_inplace_concat,
+                                        /* sq_inplace_concat */
+  0,                                    /* sq_inplace_repeat */
+};
+
+static PyMappingMethods GapBufferList_as_mapping = {
+  (lenfunc)GapBufferList_length,        /* mp_length */
+  (binaryfunc)GapBufferList_subscript,  /* mp_subscript */
+  0,                                    /* mp_ass_subscript */
+};
+
+PyTypeObject GapBufferListType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.GapBufferList",      /* tp_name */
+  sizeof(GapBufferList),                /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)GapBufferList_dealloc,    /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  GapBufferList_repr,                   /* tp_repr */
+  0,                                    /* tp_as_number */
+  &GapBufferList_as_sequence,           /* tp_as_sequence */
+  &GapBufferList_as_mapping,            /* tp_as_mapping */
+  PyObject_HashNotImplemented,          /* tp_hash  */
+  0,                                    /* tp_call */
+  GapBufferList_str,                    /* tp_str */
+  0,                                    /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_BASETYPE |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  GapBufferList_doc,                    /* tp_doc */
+  (traverseproc)GapBufferList_traverse, /* tp_traverse */
+  (inquiry)GapBufferList_tp_clear,      /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  (getiterfunc)GapBufferList_iter,      /* tp_iter */
+  0,                                    /* tp_iternext */
+  GapBufferList_methods,                /* tp_methods */
+  0,                                    /* tp_members */
+  0,                                    /* tp_getset */
+  0,                                    /* tp_base */
+  0,                                    /* tp_dict */
+  0,                                    /* tp_descr_get */
+  0,                                    /* tp_descr_set */
+  0,                                    /* tp_dictoffset */
+  (initproc)GapBufferList_init,         /* tp_init */
+  PyType_GenericAlloc,                  /* tp_alloc */
+  GapBufferList_new,                    /* tp_new */
+  PyObject_GC_Del,                      /* tp_free */
+};
+
+
+/* TypedArrayList
+ * Array-based implementation of the List interface that stores raw C values
+ * contiguously and boxes them only at the Python boundary.  Int64ArrayList
+ * and Float64ArrayList share this implementation and differ only in the
+ * TypedArrayListDescr their tp_new installs.  Growth follows ArrayList.
+ *
+ * Both types export their items through the buffer protocol.  While any
+ * export is alive, data is pinned: operations that would change size or
+ * capacity raise BufferError, while set() still writes through in place. */
+
+typedef struct {
+  const char *name;
+  const char *format;
+  Py_ssize_t itemsize;
+  PyObject   *(*box)(const char *p);
+  int        (*unbox)(PyObject *item, char *p);
+} TypedArrayListDescr;
+
+typedef struct {
+  PyObject_HEAD
+  Py_ssize_t                capacity;
+  Py_ssize_t                size;
+  char                      *data;
+  const TypedArrayListDescr *descr;
+  int                       growable;
+  double                    shrink_threshold;
+  long                      state;
+  Py_ssize_t                exports;
+#if EDUCOLLECTIONS_STATS
+  ListStats                 stats;
+#endif
+} TypedArrayList;
+
+#define TypedArrayList_AT(self, index) \
+  ((self)->data + (index) * (self)->descr->itemsize)
+
+/* Fails with BufferError if data is pinned by a buffer export. */
+static int
+TypedArrayList_check_exports(TypedArrayList *self)
+{
+  if (self->exports > 0) {
+    PyErr_SetString(PyExc_BufferError,
+                    "Existing exports of data: object cannot be re-sized");
+    return -1;
+  }
+  return 0;
+}
+
+/* Int64ArrayList items */
+static PyObject *
+Int64_box(const char *p)
+{
+  int64_t x;
+
+  memcpy(&x, p, sizeof(x));
+  return PyLong_FromLongLong(x);
+}
+
+static int
+Int64_unbox(PyObject *item, char *p)
+{
+  long long x;
+
+  x = PyLong_AsLongLong(item);
+  if (x == -1 && PyErr_Occurred()) {
+    return -1;
+  }
+  *(int64_t *)p = (int64_t)x;
+  return 0;
+}
+
+static const TypedArrayListDescr Int64ArrayList_descr = {
+  "Int64ArrayList", "q", sizeof(int64_t), Int64_box, Int64_unbox
+};
+
+/* Float64ArrayList items */
+static PyObject *
+Float64_box(const char *p)
+{
+  double x;
+
+  memcpy(&x, p, sizeof(x));
+  return PyFloat_FromDouble(x);
+}
+
+static int
+Float64_unbox(PyObject *item, char *p)
+{
+  double x;
+
+  x = PyFloat_AsDouble(item);
+  if (x == -1.0 && PyErr_Occurred()) {
+    return -1;
+  }
+  *(double *)p = x;
+  return 0;
+}
+
+static const TypedArrayListDescr Float64ArrayList_descr = {
+  "Float64ArrayList", "d", sizeof(double), Float64_box, Float64_unbox
+};
+
+PyDoc_STRVAR(Int64ArrayList_doc,
+  "Int64ArrayList(capacity, growable=False, shrink_threshold=0.0)\n"
+  "\n"
+  "ArrayList that stores its items as unboxed 64-bit signed integers.");
+
+PyDoc_STRVAR(TypedArrayList_frombuffer_doc,
+  "frombuffer(buffer, **kwds)\n"
+  "\n"
+  "Class method that returns a new list holding a copy of a C-contiguous\n"
+  "buffer.  A byte buffer is read as raw native items; any other buffer\n"
+  "must already hold items of this list's type.  kwds are passed to the\n"
+  "constructor.");
+
+PyDoc_STRVAR(Float64ArrayList_doc,
+  "Float64ArrayList(capacity, growable=False, shrink_threshold=0.0)\n"
+  "\n"
+  "ArrayList that stores its items as unboxed 64-bit floats.");
+
+/* Reallocates data to hold exactly capacity items. */
+static int
+TypedArrayList_resize(TypedArrayList *self, Py_ssize_t capacity)
+{
+  char *data;
+
+  assert(capacity >= self->size && capacity > 0);
+  if (TypedArrayList_check_exports(self) < 0) {
+    return -1;
+  }
+  if ((size_t)capacity > PY_SSIZE_T_MAX / (size_t)self->descr->itemsize) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  data = PyMem_Realloc(self->data, capacity * self->descr->itemsize);
+  if (data == NULL) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_ADD(self, frees, self->data != NULL);
+  self->data = data;
+  self->capacity = capacity;
+  return 0;
+}
+
+/* Makes room for needed items, growing data geometrically if this list is
+ * growable. */
+static int
+TypedArrayList_make_room(TypedArrayList *self, Py_ssize_t needed)
+{
+  Py_ssize_t capacity;
+
+  if (needed <= self->capacity) {
+    return 0;
+  }
+  if (!self->growable) {
+    PyErr_Format(PyExc_RuntimeError, "%s is full (capacity == size)",
+                 self->descr->name);
+    return -1;
+  }
+  capacity = self->capacity;
+  while (capacity < needed) {
+    if (capacity > PY_SSIZE_T_MAX / ARRAYLIST_GROWTH_FACTOR) {
+      capacity = needed;
+      break;
+    }
+    capacity *= ARRAYLIST_GROWTH_FACTOR;
+  }
+  return TypedArrayList_resize(self, capacity);
+}
+
+/* Gives memory back once a growable list drops below its shrink threshold;
+ * see ArrayList_maybe_shrink. */
+static void
+TypedArrayList_maybe_shrink(TypedArrayList *self)
+{
+  Py_ssize_t capacity;
+
+  if (!self->growable || self->shrink_threshold <= 0.0 ||
+      self->size >= self->capacity * self->shrink_threshold) {
+    return;
+  }
+  capacity = self->size * ARRAYLIST_GROWTH_FACTOR;
+  if (capacity < 1) {
+    capacity = 1;
+  }
+  if (capacity < self->capacity && TypedArrayList_resize(self, capacity) < 0) {
+    PyErr_Clear();
+  }
+}
+
+static PyObject *
+TypedArrayList_alloc(PyTypeObject *type, const TypedArrayListDescr *descr)
+{
+  TypedArrayList *self;
+
+  self = (TypedArrayList *)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+  self->capacity = 0;
+  self->size = 0;
+  self->data = NULL;
+  self->descr = descr;
+  self->growable = 0;
+  self->shrink_threshold = 0.0;
+  self->state = 0;
+  self->exports = 0;
+  return (PyObject *)self;
+}
+
+/* Int64ArrayListType.tp_new */
+static PyObject *
+Int64ArrayList_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  return TypedArrayList_alloc(type, &Int64ArrayList_descr);
+}
+
+/* Float64ArrayListType.tp_new */
+static PyObject *
+Float64ArrayList_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  return TypedArrayList_alloc(type, &Float64ArrayList_descr);
+}
+
+/* TypedArrayList tp_init */
+static int
+TypedArrayList_init(TypedArrayList *self, PyObject *args, PyObject *kwds)
+{
+  Py_ssize_t capacity;
+  int growable = 0;
+  double shrink_threshold = 0.0;
+  static char *kwlist[] = {"capacity", "growable", "shrink_threshold", NULL};
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|pd", kwlist, &capacity,
+                                   &growable, &shrink_threshold)) {
+    return -1;
+  }
+  if (capacity < 1) {
+    PyErr_SetString(PyExc_ValueError, "capacity must be greater than zero");
+    return -1;
+  }
+  if (!(shrink_threshold >= 0.0 &&
+        shrink_threshold < 1.0 / ARRAYLIST_GROWTH_FACTOR)) {
+    PyErr_SetString(PyExc_ValueError,
+                    "shrink_threshold must be in [0.0, 0.5)");
+    return -1;
+  }
+  if (TypedArrayList_check_exports(self) < 0) {
+    return -1;
+  }
+  self->size = 0;
+  if (TypedArrayList_resize(self, capacity) < 0) {
+    return -1;
+  }
+  ++self->state;
+  self->growable = growable;
+  self->shrink_threshold = shrink_threshold;
+  return 0;
+}
+
+/* TypedArrayList tp_dealloc */
+static void
+TypedArrayList_dealloc(TypedArrayList *self)
+{
+  PyMem_Free(self->data);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* Inserts the C value at p so that it ends up at index, which may equal
+ * size. */
+static int
+TypedArrayList_insert_index(TypedArrayList *self, Py_ssize_t index,
+                            const char *p)
+{
+  Py_ssize_t itemsize = self->descr->itemsize;
+
+  if (TypedArrayList_check_exports(self) < 0 ||
+      TypedArrayList_make_room(self, self->size + 1) < 0) {
+    return -1;
+  }
+  memmove(TypedArrayList_AT(self, index + 1), TypedArrayList_AT(self, index),
+          (self->size - index) * itemsize);
+  LISTSTATS_ADD(self, shifted, self->size - index);
+  memcpy(TypedArrayList_AT(self, index), p, itemsize);
+  ++self->size;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  return 0;
+}
+
+/* Removes the item at index, which must be in range, and returns it boxed. */
+static PyObject *
+TypedArrayList_remove_index(TypedArrayList *self, Py_ssize_t index)
+{
+  PyObject *item;
+
+  if (TypedArrayList_check_exports(self) < 0) {
+    return NULL;
+  }
+  item = self->descr->box(TypedArrayList_AT(self, index));
+  if (item == NULL) {
+    return NULL;
+  }
+  memmove(TypedArrayList_AT(self, index), TypedArrayList_AT(self, index + 1),
+          (self->size - index - 1) * self->descr->itemsize);
+  LISTSTATS_ADD(self, shifted, self->size - index - 1);
+  --self->size;
+  ++self->state;
+  TypedArrayList_maybe_shrink(self);
+  return item;
+}
+
+/* TypedArrayList.append(item) */
+static PyObject *
+TypedArrayList_append(TypedArrayList *self, PyObject *item)
+{
+  char buf[sizeof(double) > sizeof(int64_t) ? sizeof(double) : sizeof(int64_t)];
+
+  if (self->descr->unbox(item, buf) < 0 ||
+      TypedArrayList_insert_index(self, self->size, buf) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* TypedArrayList.capacity() */
+static PyObject *
+TypedArrayList_capacity(TypedArrayList *self)
+{
+  return PyLong_FromSsize_t(self->capacity);
+}
+
+/* TypedArrayList.clear() */
+static PyObject *
+TypedArrayList_clear(TypedArrayList *self)
+{
+  if (TypedArrayList_check_exports(self) < 0) {
+    return NULL;
+  }
+  self->size = 0;
+  ++self->state;
+  TypedArrayList_maybe_shrink(self);
+  Py_RETURN_NONE;
+}
+
+/* TypedArrayList.extend(iterable)
+ * Items are unboxed into a scratch buffer before data is touched, since
+ * unboxing an item can run arbitrary code, including code that reallocates
+ * data.  A bad item part way through leaves the list unchanged. */
+static PyObject *
+TypedArrayList_extend(TypedArrayList *self, PyObject *iterable)
+{
+  PyObject *seq, **items;
+  Py_ssize_t n, i, itemsize = self->descr->itemsize;
+  char *buf;
+
+  seq = PySequence_Fast(iterable, "extend() argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  buf = PyMem_Malloc(n > 0 ? n * itemsize : 1);
+  if (buf == NULL) {
+    Py_DECREF(seq);
+    return PyErr_NoMemory();
+  }
+  items = PySequence_Fast_ITEMS(seq);
+  for (i = 0; i < n; ++i) {
+    if (self->descr->unbox(items[i], buf + i * itemsize) < 0) {
+      goto fail;
+    }
+  }
+  if (TypedArrayList_check_exports(self) < 0 ||
+      TypedArrayList_make_room(self, self->size + n) < 0) {
+    goto fail;
+  }
+  memcpy(TypedArrayList_AT(self, self->size), buf, n * itemsize);
+  self->size += n;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  PyMem_Free(buf);
+  Py_DECREF(seq);
+  Py_RETURN_NONE;
+
+fail:
+  PyMem_Free(buf);
+  Py_DECREF(seq);
+  return NULL;
+}
+
+/* TypedArrayList.from_iterable(iterable, **kwds)
+ * The new list is sized to fit; kwds are passed to the constructor. */
+static PyObject *
+TypedArrayList_from_iterable(PyTypeObject *type, PyObject *args,
+                             PyObject *kwds)
+{
+  PyObject *iterable, *seq, *self, *result;
+  Py_ssize_t n;
+
+  if (!PyArg_UnpackTuple(args, "from_iterable", 1, 1, &iterable)) {
+    return NULL;
+  }
+  seq = PySequence_Fast(iterable, "from_iterable() argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  args = Py_BuildValue("(n)", n > 0 ? n : 1);
+  if (args == NULL) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  self = PyObject_Call((PyObject *)type, args, kwds);
+  Py_DECREF(args);
+  if (self == NULL) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  result = TypedArrayList_extend((TypedArrayList *)self, seq);
+  Py_DECREF(seq);
+  if (result == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  Py_DECREF(result);
+  return self;
+}
+
+/* TypedArrayList tp_as_sequence->sq_item */
+static PyObject *
+TypedArrayList_item(TypedArrayList *self, Py_ssize_t index)
+{
+  if (index < 0 || index > self->size - 1) {
+    PyErr_Format(PyExc_IndexError, "%s index out of range", self->descr->name);
+    return NULL;
+  }
+  return self->descr->box(TypedArrayList_AT(self, index));
+}
+
+/* TypedArrayList.get(index) */
+static PyObject *
+TypedArrayList_get(TypedArrayList *self, PyObject *indexobj)
+{
+  Py_ssize_t index;
+
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  return TypedArrayList_item(self, index);
+}
+
+/* TypedArrayList.insert(index, item) */
+static PyObject *
+TypedArrayList_insert(TypedArrayList *self, PyObject *const *args,
+                      Py_ssize_t nargs)
+{
+  char buf[sizeof(double) > sizeof(int64_t) ? sizeof(double) : sizeof(int64_t)];
+  PyObject *itemobj;
+  Py_ssize_t index;
+
+  if (!List_check_nargs("insert", nargs, 2)) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  itemobj = args[1];
+  /* Unboxing can run arbitrary code, so the index is checked after it. */
+  if (self->descr->unbox(itemobj, buf) < 0) {
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+    PyErr_Format(PyExc_IndexError, "%s index out of range", self->descr->name);
+    return NULL;
+  }
+  if (TypedArrayList_insert_index(self, index, buf) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* TypedArrayList.prepend(item) */
+static PyObject *
+TypedArrayList_prepend(TypedArrayList *self, PyObject *item)
+{
+  char buf[sizeof(double) > sizeof(int64_t) ? sizeof(double) : sizeof(int64_t)];
+
+  if (self->descr->unbox(item, buf) < 0 ||
+      TypedArrayList_insert_index(self, 0, buf) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* TypedArrayList.remove(index) */
+static PyObject *
+TypedArrayList_remove(TypedArrayList *self, PyObject *indexobj)
+{
+  Py_ssize_t index;
+
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+    PyErr_Format(PyExc_IndexError, "%s index out of range", self->descr->name);
+    return NULL;
+  }
+  return TypedArrayList_remove_index(self, index);
+}
+
+/* TypedArrayList.reserve(n) */
+static PyObject *
+TypedArrayList_reserve(TypedArrayList *self, PyObject *nobj)
+{
+  Py_ssize_t n;
+
+  n = PyLong_AsSsize_t(nobj);
+  if (n == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (n > self->capacity && TypedArrayList_resize(self, n) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* TypedArrayList tp_as_sequence->sq_ass_item
+ * Assigns item at index, or deletes the item at index if item is NULL.
+ * Unboxing can run arbitrary code that resizes this list, so item is
+ * unboxed into buf and the index is checked again before it is stored. */
+static int
+TypedArrayList_ass_item(TypedArrayList *self, Py_ssize_t index,
+                        PyObject *item)
+{
+  char buf[sizeof(double) > sizeof(int64_t) ? sizeof(double) : sizeof(int64_t)];
+  PyObject *old_item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_Format(PyExc_IndexError, "%s index out of range", self->descr->name);
+    return -1;
+  }
+  if (item == NULL) {
+    old_item = TypedArrayList_remove_index(self, index);
+    if (old_item == NULL) {
+      return -1;
+    }
+    Py_DECREF(old_item);
+    return 0;
+  }
+  if (self->descr->unbox(item, buf) < 0) {
+    return -1;
+  }
+  if (index > self->size - 1) {
+    PyErr_Format(PyExc_IndexError, "%s index out of range", self->descr->name);
+    return -1;
+  }
+  memcpy(TypedArrayList_AT(self, index), buf, self->descr->itemsize);
+  ++self->state;
+  return 0;
+}
+
+/* TypedArrayList.set(index, item) */
+static PyObject *
+TypedArrayList_set(TypedArrayList *self, PyObject *const *args,
+                   Py_ssize_t nargs)
+{
+  PyObject *itemobj;
+  Py_ssize_t index;
+
+  if (!List_check_nargs("set", nargs, 2)) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  itemobj = args[1];
+  if (TypedArrayList_ass_item(self, index, itemobj) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* TypedArrayList.shrink_to_fit() */
+static PyObject *
+TypedArrayList_shrink_to_fit(TypedArrayList *self)
+{
+  Py_ssize_t capacity;
+
+  capacity = self->size > 0 ? self->size : 1;
+  if (capacity < self->capacity && TypedArrayList_resize(self, capacity) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* TypedArrayList.size() */
+static PyObject *
+TypedArrayList_size(TypedArrayList *self)
+{
+  return PyLong_FromSsize_t(self->size);
+}
+
+#if EDUCOLLECTIONS_STATS
+/* TypedArrayList.stats() */
+static PyObject *
+TypedArrayList_stats(TypedArrayList *self)
+{
+  return ListStats_dict(&self->stats);
+}
+
+/* TypedArrayList.reset_stats() */
+static PyObject *
+TypedArrayList_reset_stats(TypedArrayList *self)
+{
+  ListStats_reset(&self->stats, self->size);
+  Py_RETURN_NONE;
+}
+#endif
+
+/* TypedArrayList tp_as_sequence->sq_length */
+static Py_ssize_t
+TypedArrayList_length(TypedArrayList *self)
+{
+  return self->size;
+}
+
+/* TypedArrayList tp_as_sequence->sq_contains
+ * An item of the list's own Python type is unboxed once and compared in C;
+ * anything else is compared against each boxed item. */
+static int
+TypedArrayList_contains(TypedArrayList *self, PyObject *item)
+{
+  char buf[sizeof(double) > sizeof(int64_t) ? sizeof(double) : sizeof(int64_t)];
+  PyObject *boxed;
+  Py_ssize_t i, itemsize = self->descr->itemsize;
+  int cmp;
+
+  if ((self->descr->format[0] == 'q' && PyLong_CheckExact(item)) ||
+      (self->descr->format[0] == 'd' && PyFloat_CheckExact(item))) {
+    if (self->descr->unbox(item, buf) == 0) {
+      for (i = 0; i < self->size; ++i) {
+        if (self->descr->format[0] == 'q' ?
+            *(int64_t *)TypedArrayList_AT(self, i) == *(int64_t *)buf :
+            *(double *)TypedArrayList_AT(self, i) == *(double *)buf) {
+          return 1;
+        }
+      }
+      return 0;
+    }
+    if (!PyErr_ExceptionMatches(PyExc_OverflowError)) {
+      return -1;
+    }
+    PyErr_Clear();
+  }
+  for (i = 0, cmp = 0; cmp == 0 && i < self->size; ++i) {
+    boxed = self->descr->box(self->data + i * itemsize);
+    if (boxed == NULL) {
+      return -1;
+    }
+    cmp = PyObject_RichCompareBool(boxed, item, Py_EQ);
+    Py_DECREF(boxed);
+  }
+  return cmp;
+}
+
+/* TypedArrayList tp_as_mapping->mp_subscript
+ * Slicing returns a new list of the same type and growth settings. */
+static PyObject *
+TypedArrayList_subscript(TypedArrayList *self, PyObject *key)
+{
+  TypedArrayList *result;
+  Py_ssize_t index, start, stop, step, slicelength, i, j;
+
+  if (PyIndex_Check(key)) {
+    index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+    if (index < 0) {
+      index += self->size;
+    }
+    return TypedArrayList_item(self, index);
+  }
+  if (!PySlice_Check(key)) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s indices must be integers or slices, not %.200s",
+                 self->descr->name, Py_TYPE(key)->tp_name);
+    return NULL;
+  }
+  if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+    return NULL;
+  }
+  slicelength = PySlice_AdjustIndices(self->size, &start, &stop, step);
+  result = (TypedArrayList *)PyObject_CallFunction(
+    (PyObject *)Py_TYPE(self), "n", slicelength > 0 ? slicelength : 1);
+  if (result == NULL) {
+    return NULL;
+  }
+  result->growable = self->growable;
+  result->shrink_threshold = self->shrink_threshold;
+  if (step == 1) {
+    memcpy(result->data, TypedArrayList_AT(self, start),
+           slicelength * self->descr->itemsize);
+  }
+  else {
+    for (i = start, j = 0; j < slicelength; i += step, ++j) {
+      memcpy(TypedArrayList_AT(result, j), TypedArrayList_AT(self, i),
+             self->descr->itemsize);
+    }
+  }
+  result->size = slicelength;
+  LISTSTATS_PEAK(result);
+  return (PyObject *)result;
+}
+
+/* TypedArrayList tp_as_sequence->sq_inplace_concat */
+static PyObject *
+TypedArrayList_inplace_concat(TypedArrayList *self, PyObject *other)
+{
+  PyObject *result;
+
+  result = TypedArrayList_extend(self, other);
+  if (result == NULL) {
+    return NULL;
+  }
+  Py_DECREF(result);
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
+
+/* Returns whether a buffer of the given format and itemsize holds items of
+ * this list's C type in native byte order. */
+static int
+TypedArrayList_format_matches(const TypedArrayListDescr *descr,
+                              const char *format, Py_ssize_t itemsize)
+{
+  if (itemsize != descr->itemsize) {
+    return 0;
+  }
+  if (*format == '@' || *format == '=' ||
+      *format == (PY_LITTLE_ENDIAN ? '<' : '>') ||
+      (!PY_LITTLE_ENDIAN && *format == '!')) {
+    ++format;
+  }
+  if (format[0] == '\0' || format[1] != '\0') {
+    return 0;
+  }
+  if (descr->format[0] == 'q') {
+    return strchr("qln", format[0]) != NULL;
+  }
+  return format[0] == descr->format[0];
+}
+
+/* TypedArrayList.frombuffer(buffer, **kwds)
+ * Copies any C-contiguous buffer in one memcpy.  Byte buffers are
+ * reinterpreted as raw items; typed buffers must match the item type.  kwds
+ * are passed to the constructor. */
+static PyObject *
+TypedArrayList_frombuffer(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  const TypedArrayListDescr *descr;
+  PyObject *obj, *self;
+  Py_buffer view;
+  Py_ssize_t n;
+
+  if (!PyArg_UnpackTuple(args, "frombuffer", 1, 1, &obj)) {
+    return NULL;
+  }
+  descr = PyType_IsSubtype(type, &Int64ArrayListType) ?
+    &Int64ArrayList_descr : &Float64ArrayList_descr;
+  if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+    return NULL;
+  }
+  if (view.itemsize == 1 &&
+      (view.format == NULL || strchr("Bbc", view.format[0]) != NULL)) {
+    if (view.len % descr->itemsize != 0) {
+      PyErr_Format(PyExc_ValueError,
+                   "buffer size must be a multiple of %zd bytes",
+                   descr->itemsize);
+      PyBuffer_Release(&view);
+      return NULL;
+    }
+  }
+  else if (view.format == NULL ||
+           !TypedArrayList_format_matches(descr, view.format, view.itemsize)) {
+    PyErr_Format(PyExc_TypeError, "cannot build %s from buffer of format '%s'",
+                 descr->name, view.format != NULL ? view.format : "B");
+    PyBuffer_Release(&view);
+    return NULL;
+  }
+  n = view.len / descr->itemsize;
+  args = Py_BuildValue("(n)", n > 0 ? n : 1);
+  if (args == NULL) {
+    PyBuffer_Release(&view);
+    return NULL;
+  }
+  self = PyObject_Call((PyObject *)type, args, kwds);
+  Py_DECREF(args);
+  if (self == NULL) {
+    PyBuffer_Release(&view);
+    return NULL;
+  }
+  memcpy(((TypedArrayList *)self)->data, view.buf, view.len);
+  ((TypedArrayList *)self)->size = n;
+  LISTSTATS_PEAK((TypedArrayList *)self);
+  PyBuffer_Release(&view);
+  return self;
+}
+
+/* TypedArrayList tp_as_buffer->bf_getbuffer
+ * Exposes the live items as a one-dimensional, writable, C-contiguous
+ * array.  shape points at size, which cannot change while exported. */
+static int
+TypedArrayList_getbuffer(TypedArrayList *self, Py_buffer *view, int flags)
+{
+  if (view == NULL) {
+    PyErr_SetString(PyExc_BufferError, "NULL view in getbuffer");
+    return -1;
+  }
+  view->buf = self->data;
+  view->obj = (PyObject *)self;
+  Py_INCREF(self);
+  view->len = self->size * self->descr->itemsize;
+  view->readonly = 0;
+  view->itemsize = self->descr->itemsize;
+  view->format = (flags & PyBUF_FORMAT) ? (char *)self->descr->format : NULL;
+  view->ndim = 1;
+  view->shape = (flags & PyBUF_ND) ? &self->size : NULL;
+  view->strides = (flags & PyBUF_STRIDES) ? &view->itemsize : NULL;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+  ++self->exports;
+  return 0;
+}
+
+/* TypedArrayList tp_as_buffer->bf_releasebuffer */
+static void
+TypedArrayList_releasebuffer(TypedArrayList *self, Py_buffer *view)
+{
+  --self->exports;
+}
+
+/* TypedArrayListIterator
+ * Iterates over a typed list by index, boxing each item and raising if the
+ * list is mutated before iteration ends. */
+typedef struct {
+  PyObject_HEAD
+  TypedArrayList *list;
+  Py_ssize_t     index;
+  long           state;
+} TypedArrayListIterator;
+
+/* TypedArrayList tp_iter */
+static PyObject *
+TypedArrayList_iter(TypedArrayList *self)
+{
+  TypedArrayListIterator *it;
+
+  it = PyObject_New(TypedArrayListIterator, &TypedArrayListIteratorType);
+  if (it == NULL) {
+    return NULL;
+  }
+  Py_INCREF(self);
+  it->list = self;
+  it->index = 0;
+  it->state = self->state;
+  return (PyObject *)it;
+}
+
+/* TypedArrayListIteratorType.tp_dealloc */
+static void
+TypedArrayListIterator_dealloc(TypedArrayListIterator *self)
+{
+  Py_XDECREF(self->list);
+  PyObject_Del(self);
+}
+
+/* TypedArrayListIteratorType.tp_iternext */
+static PyObject *
+TypedArrayListIterator_next(TypedArrayListIterator *self)
+{
+  TypedArrayList *list = self->list;
+
+  if (list == NULL) {
+    return NULL;
+  }
+  if (list->state != self->state) {
+    PyErr_Format(PyExc_RuntimeError, "%s mutated during iteration",
+                 list->descr->name);
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  if (self->index >= list->size) {
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  return list->descr->box(TypedArrayList_AT(list, self->index++));
+}
+
+PyTypeObject TypedArrayListIteratorType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.TypedArrayListIterator",
+                                        /* tp_name */
+  sizeof(TypedArrayListIterator),       /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)TypedArrayListIterator_dealloc,
+                                        /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  0,                                    /* tp_repr */
+  0,                                    /* tp_as_number */
+  0,                                    /* tp_as_sequence */
+  0,                                    /* tp_as_mapping */
+  0,                                    /* tp_hash  */
+  0,                                    /* tp_call */
+  0,                                    /* tp_str */
+  PyObject_GenericGetAttr,              /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT,                   /* tp_flags */
+  0,                                    /* tp_doc */
+  0,                                    /* tp_traverse */
+  0,                                    /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  PyObject_SelfIter,                    /* tp_iter */
+  (iternextfunc)TypedArrayListIterator_next,
+                                        /* tp_iternext */
+};
+
+/* TypedArrayList tp_repr */
+static PyObject *
+TypedArrayList_repr(PyObject *self)
+{
+  return PyUnicode_FromString("[...]");
+}
+
+/* TypedArrayList tp_str */
+static PyObject *
+TypedArrayList_str(PyObject *self)
+{
+  return PyUnicode_FromString("[...]");
+}
+
+static PyMethodDef TypedArrayList_methods[] = {
+  {"append",                  (PyCFunction)TypedArrayList_append,
+      METH_O,                  List_append_doc},
+  {"capacity",                (PyCFunction)TypedArrayList_capacity,
+      METH_NOARGS,             ArrayList_capacity_doc},
+  {"clear",                   (PyCFunction)TypedArrayList_clear,
+      METH_NOARGS,             List_clear_doc},
+  {"extend",                  (PyCFunction)TypedArrayList_extend,
+      METH_O,                  List_extend_doc},
+  {"from_iterable",           (PyCFunction)TypedArrayList_from_iterable,
+      METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+                               List_from_iterable_doc},
+  {"frombuffer",              (PyCFunction)TypedArrayList_frombuffer,
+      METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+                               TypedArrayList_frombuffer_doc},
+  {"get",                     (PyCFunction)TypedArrayList_get,
+      METH_O,                  List_get_doc},
+  {"insert",                  (PyCFunction)TypedArrayList_insert,
+      METH_FASTCALL,           List_insert_doc},
+  {"prepend",                 (PyCFunction)TypedArrayList_prepend,
+      METH_O,                  List_prepend_doc},
+  {"remove",                  (PyCFunction)TypedArrayList_remove,
+      METH_O,                  List_remove_doc},
+  {"reserve",                 (PyCFunction)TypedArrayList_reserve,
+      METH_O,                  ArrayList_reserve_doc},
+#if EDUCOLLECTIONS_STATS
+  {"reset_stats",             (PyCFunction)TypedArrayList_reset_stats,
+      METH_NOARGS,             List_reset_stats_doc},
+#endif
+  {"set",                     (PyCFunction)TypedArrayList_set,
+      METH_FASTCALL,           List_set_doc},
+  {"shrink_to_fit",           (PyCFunction)TypedArrayList_shrink_to_fit,
+      METH_NOARGS,             ArrayList_shrink_to_fit_doc},
+  {"size",                    (PyCFunction)TypedArrayList_size,
+      METH_NOARGS,             List_size_doc},
+#if EDUCOLLECTIONS_STATS
+  {"stats",                   (PyCFunction)TypedArrayList_stats,
+      METH_NOARGS,             List_stats_doc},
+#endif
+  {NULL,                      NULL}
+};
+
+static PySequenceMethods TypedArrayList_as_sequence = {
+  (lenfunc)TypedArrayList_length,       /* sq_length */
+  0,                                    /* sq_concat */
+  0,                                    /* sq_repeat */
+  (ssizeargfunc)TypedArrayList_item,    /* sq_item */
+  0,                                    /* was_sq_slice */
+  (ssizeobjargproc)TypedArrayList_ass_item,
+                                        /* sq_ass_item */
+  0,                                    /* was_sq_ass_slice */
+  (objobjproc)TypedArrayList_contains,  /* sq_contains */
+  (binaryfunc)TypedArrayList_inplace_concat,
+                                        /* sq_inplace_concat */
+  0,                                    /* sq_inplace_repeat */
+};
+
+static PyMappingMethods TypedArrayList_as_mapping = {
+  (lenfunc)TypedArrayList_length,       /* mp_length */
+  (binaryfunc)TypedArrayList_subscript, /* mp_subscript */
+  0,                                    /* mp_ass_subscript */
+};
+
+static PyBufferProcs TypedArrayList_as_buffer = {
+  (getbufferproc)TypedArrayList_getbuffer,
+                                        /* bf_getbuffer */
+  (releasebufferproc)TypedArrayList_releasebuffer,
+                                        /* bf_releasebuffer */
+};
+
+PyTypeObject Int64ArrayListType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.Int64ArrayList",     /* tp_name */
+  sizeof(TypedArrayList),               /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)TypedArrayList_dealloc,   /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  TypedArrayList_repr,                  /* tp_repr */
+  0,                                    /* tp_as_number */
+  &TypedArrayList_as_sequence,          /* tp_as_sequence */
+  &TypedArrayList_as_mapping,           /* tp_as_mapping */
+  PyObject_HashNotImplemented,          /* tp_hash  */
+  0,                                    /* tp_call */
+  TypedArrayList_str,                   /* tp_str */
+  0,                                    /* tp_getattro */
+  0,                                    /* tp_setattro */
+  &TypedArrayList_as_buffer,            /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_BASETYPE,                /* tp_flags */
+  Int64ArrayList_doc,                   /* tp_doc */
+  0,                                    /* tp_traverse */
+  0,                                    /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  (getiterfunc)TypedArrayList_iter,     /* tp_iter */
+  0,                                    /* tp_iternext */
+  TypedArrayList_methods,               /* tp_methods */
+  0,                                    /* tp_members */
+  0,                                    /* tp_getset */
+  0,                                    /* tp_base */
+  0,                                    /* tp_dict */
+  0,                                    /* tp_descr_get */
+  0,                                    /* tp_descr_set */
+  0,                                    /* tp_dictoffset */
+  (initproc)TypedArrayList_init,        /* tp_init */
+  PyType_GenericAlloc,                  /* tp_alloc */
+  Int64ArrayList_new,                   /* tp_new */
+};
+
+PyTypeObject Float64ArrayListType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.Float64ArrayList",   /* tp_name */
+  sizeof(TypedArrayList),               /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)TypedArrayList_dealloc,   /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  TypedArrayList_repr,                  /* tp_repr */
+  0,                                    /* tp_as_number */
+  &TypedArrayList_as_sequence,          /* tp_as_sequence */
+  &TypedArrayList_as_mapping,           /* tp_as_mapping */
+  PyObject_HashNotImplemented,          /* tp_hash  */
+  0,                                    /* tp_call */
+  TypedArrayList_str,                   /* tp_str */
+  0,                                    /* tp_getattro */
+  0,                                    /* tp_setattro */
+  &TypedArrayList_as_buffer,            /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_BASETYPE,                /* tp_flags */
+  Float64ArrayList_doc,                 /* tp_doc */
+  0,                                    /* tp_traverse */
+  0,                                    /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  (getiterfunc)TypedArrayList_iter,     /* tp_iter */
+  0,                                    /* tp_iternext */
+  TypedArrayList_methods,               /* tp_methods */
+  0,                                    /* tp_members */
+  0,                                    /* tp_getset */
+  0,                                    /* tp_base */
+  0,                                    /* tp_dict */
+  0,                                    /* tp_descr_get */
+  0,                                    /* tp_descr_set */
+  0,                                    /* tp_dictoffset */
+  (initproc)TypedArrayList_init,        /* tp_init */
+  PyType_GenericAlloc,                  /* tp_alloc */
+  Float64ArrayList_new,                 /* tp_new */
+};
+
+
+/* NodePool
+ * Fixed-size node allocator for the linked lists.  Nodes are carved out of
+ * slabs of NODEPOOL_SLAB_SIZE bytes, so neighbouring nodes share cache lines,
+ * and released nodes go on their slab's free list, threaded through the
+ * nodes themselves, so allocating and releasing a node is a pointer pop or
+ * push.  Slabs are aligned to their size, so a node finds its slab by
+ * masking its address.  A slab whose nodes are all free is given back to
+ * the system once NODEPOOL_MAX_SPARE empty slabs are already kept spare,
+ * so a pool holds on to a bounded amount of memory beyond its live nodes
+ * while a list that shrinks and regrows need not go to the system every
+ * time. */
+
+#define NODEPOOL_SLAB_SIZE 4096
+#define NODEPOOL_MAX_SPARE 64
+
+typedef struct NodePoolFreeType {
+  struct NodePoolFreeType *next;
+} NodePoolFree;
+
+typedef struct NodePoolSlabType {
+  struct NodePoolSlabType *prev;
+  struct NodePoolSlabType *next;
+  NodePoolFree            *free;
+  Py_ssize_t              in_use;
+} NodePoolSlab;
+
+typedef struct {
+  const char   *name;
+  size_t       node_size;
+  Py_ssize_t   slab_nodes;
+  NodePoolSlab *partial;
+  NodePoolSlab *spare;
+  Py_ssize_t   nspare;
+  Py_ssize_t   nslabs;
+  Py_ssize_t   nfree;
+  Py_ssize_t   in_use;
+} NodePool;
+
+#define NODEPOOL_INIT(type) \
+  {#type, sizeof(type), \
+   (NODEPOOL_SLAB_SIZE - sizeof(NodePoolSlab)) / sizeof(type), \
+   NULL, NULL, 0, 0, 0, 0}
+
+#define NodePool_SLAB_OF(p) \
+  ((NodePoolSlab *)((uintptr_t)(p) & ~(uintptr_t)(NODEPOOL_SLAB_SIZE - 1)))
+
+/* Returns a slab of NODEPOOL_SLAB_SIZE bytes aligned to its size, or NULL.
+ * PyMem_Malloc makes no alignment promise, so this goes to the system
+ * allocator. */
+static NodePoolSlab *
+NodePool_slab_alloc(void)
+{
+  void *p;
+
+#ifdef MS_WINDOWS
+  p = _aligned_malloc(NODEPOOL_SLAB_SIZE, NODEPOOL_SLAB_SIZE);
+#else
+  if (posix_memalign(&p, NODEPOOL_SLAB_SIZE, NODEPOOL_SLAB_SIZE) != 0) {
+    p = NULL;
+  }
+#endif
+  return p;
+}
+
+static void
+NodePool_slab_free(NodePoolSlab *slab)
+{
+#ifdef MS_WINDOWS
+  _aligned_free(slab);
+#else
+  free(slab);
+#endif
+}
+
+/* Adds slab to the front of the slabs of pool that have free nodes.  Spare
+ * slabs are kept on a separate list through next. */
+static void
+NodePool_link(NodePool *pool, NodePoolSlab *slab)
+{
+  slab->prev = NULL;
+  slab->next = pool->partial;
+  if (pool->partial != NULL) {
+    pool->partial->prev = slab;
+  }
+  pool->partial = slab;
+}
+
+/* Removes slab from the slabs of pool that have free nodes. */
+static void
+NodePool_unlink(NodePool *pool, NodePoolSlab *slab)
+{
+  if (slab->prev != NULL) {
+    slab->prev->next = slab->next;
+  }
+  else {
+    pool->partial = slab->next;
+  }
+  if (slab->next != NULL) {
+    slab->next->prev = slab->prev;
+  }
+}
+
+/* Returns an uninitialized node, or NULL if a new slab cannot be allocated.
+ * Like PyMem_Malloc, sets no exception. */
+static void *
+NodePool_alloc(NodePool *pool)
+{
+  NodePoolSlab *slab;
+  NodePoolFree *node;
+  char *nodes;
+  Py_ssize_t i;
+
+  slab = pool->partial;
+  if (slab == NULL) {
+    if (pool->spare != NULL) {
+      slab = pool->spare;
+      pool->spare = slab->next;
+      --pool->nspare;
+    }
+    else {
+      slab = NodePool_slab_alloc();
+      if (slab == NULL) {
+        return NULL;
+      }
+      ++pool->nslabs;
+      pool->nfree += pool->slab_nodes;
+      slab->in_use = 0;
+      slab->free = NULL;
+      /* Push the new nodes in reverse so they are handed out in address
+       * order. */
+      nodes = (char *)(slab + 1);
+      for (i = pool->slab_nodes - 1; i >= 0; --i) {
+        node = (NodePoolFree *)(nodes + i * pool->node_size);
+        node->next = slab->free;
+        slab->free = node;
+      }
+    }
+    NodePool_link(pool, slab);
+  }
+  node = slab->free;
+  slab->free = node->next;
+  if (slab->free == NULL) {
+    NodePool_unlink(pool, slab);
+  }
+  ++slab->in_use;
+  --pool->nfree;
+  ++pool->in_use;
+  return node;
+}
+
+/* Returns p, a node from NodePool_alloc, to the pool. */
+static void
+NodePool_free(NodePool *pool, void *p)
+{
+  NodePoolSlab *slab = NodePool_SLAB_OF(p);
+  NodePoolFree *node = p;
+
+  if (slab->free == NULL) {
+    NodePool_link(pool, slab);
+  }
+  node->next = slab->free;
+  slab->free = node;
+  ++pool->nfree;
+  --pool->in_use;
+  if (--slab->in_use > 0) {
+    return;
+  }
+  NodePool_unlink(pool, slab);
+  if (pool->nspare < NODEPOOL_MAX_SPARE) {
+    slab->next = pool->spare;
+    pool->spare = slab;
+    ++pool->nspare;
+    return;
+  }
+  --pool->nslabs;
+  pool->nfree -= pool->slab_nodes;
+  NodePool_slab_free(slab);
+}
+
+/* Returns a dict describing the occupancy of pool. */
+static PyObject *
+NodePool_stats_dict(NodePool *pool)
+{
+  Py_ssize_t capacity = pool->nslabs * pool->slab_nodes;
+
+  return Py_BuildValue("{sn,sn,sn,sn,sn,sn,sd}",
+                       "slabs", pool->nslabs,
+                       "spare_slabs", pool->nspare,
+                       "slab_nodes", pool->slab_nodes,
+                       "capacity", capacity,
+                       "in_use", pool->in_use,
+                       "free", pool->nfree,
+                       "occupancy", capacity > 0 ?
+                         (double)pool->in_use / capacity : 0.0);
+}
+
+
+/* SinglyLinkedListNode */
+typedef struct SinglyLinkedListNodeType {
+  PyObject *data;
+  struct SinglyLinkedListNodeType *next;
+} SinglyLinkedListNode;
+
+static NodePool SinglyLinkedListNode_pool = NODEPOOL_INIT(SinglyLinkedListNode);
+
+#define SinglyLinkedListNode_alloc() \
+  ((SinglyLinkedListNode *)NodePool_alloc(&SinglyLinkedListNode_pool))
+#define SinglyLinkedListNode_free(n) \
+  NodePool_free(&SinglyLinkedListNode_pool, (n))
+
+/* Returns the node index links past n. */
+static SinglyLinkedListNode *
+SinglyLinkedListNode_at(SinglyLinkedListNode *n, Py_ssize_t index)
+{
+  Py_ssize_t i;
+
+  for (i = 0; i < index; ++i)
+    n = n->next;
+  return n;
+}
+
+/* Frees the chain of nodes starting at n and releases their items. */
+static void
+SinglyLinkedListNode_free_chain(SinglyLinkedListNode *n)
+{
+  SinglyLinkedListNode *tmp;
+
+  while (n) {
+      Py_XDECREF(n->data);
+      tmp = n;
+      n = n->next;
+      SinglyLinkedListNode_free(tmp);
+  }
+}
+
+/* Visits the items of the chain of nodes starting at n on behalf of a list's
+ * tp_traverse.  The nodes themselves are not Python objects. */
+static int
+SinglyLinkedListNode_traverse_chain(SinglyLinkedListNode *n, visitproc visit,
+                                    void *arg)
+{
+  for (; n; n = n->next) {
+    Py_VISIT(n->data);
+  }
+  return 0;
+}
+
+/* Builds a new chain of nodes holding the items of iterable.  Lists and
+ * tuples are read straight from their item arrays; any other iterable is
+ * gathered into a list first.  The chain is built completely before a list
+ * links it in, so a failure part way through leaves the list untouched. */
+static int
+SinglyLinkedListNode_chain_from_iterable(PyObject *iterable,
+                                         SinglyLinkedListNode **headp,
+                                         SinglyLinkedListNode **tailp,
+                                         Py_ssize_t *sizep)
+{
+  SinglyLinkedListNode *head = NULL, *tail = NULL, *n;
+  PyObject *seq, **items;
+  Py_ssize_t size, i;
+
+  seq = PySequence_Fast(iterable, "LinkedList argument must be iterable");
+  if (seq == NULL) {
+    return -1;
+  }
+  size = PySequence_Fast_GET_SIZE(seq);
+  items = PySequence_Fast_ITEMS(seq);
+  for (i = 0; i < size; ++i) {
+    n = SinglyLinkedListNode_alloc();
+    if (n == NULL) {
+      Py_DECREF(seq);
+      SinglyLinkedListNode_free_chain(head);
+      PyErr_NoMemory();
+      return -1;
+    }
+    Py_INCREF(items[i]);
+    n->data = items[i];
+    n->next = NULL;
+    if (head == NULL) {
+      head = n;
+    }
+    else {
+      tail->next = n;
+    }
+    tail = n;
+  }
+  Py_DECREF(seq);
+  *headp = head;
+  *tailp = tail;
+  *sizep = size;
+  return 0;
+}
+
+/* Builds a new chain of nodes holding the slicelength items selected by start
+ * and step from the chain starting at head.  A negative step walks the
+ * selected range forward once and links each copy in front of the last. */
+static int
+SinglyLinkedListNode_chain_slice(SinglyLinkedListNode *head, Py_ssize_t start,
+                                 Py_ssize_t step, Py_ssize_t slicelength,
+                                 SinglyLinkedListNode **headp,
+                                 SinglyLinkedListNode **tailp)
+{
+  SinglyLinkedListNode *first = NULL, *last = NULL, *n, *copy;
+  Py_ssize_t stride, j;
+
+  *headp = *tailp = NULL;
+  if (slicelength <= 0) {
+    return 0;
+  }
+  if (step < 0) {
+    start += (slicelength - 1) * step;
+    stride = -step;
+  }
+  else {
+    stride = step;
+  }
+  n = SinglyLinkedListNode_at(head, start);
+  for (j = 0; j < slicelength; ++j) {
+    if (j > 0) {
+      n = SinglyLinkedListNode_at(n, stride);
+    }
+    copy = SinglyLinkedListNode_alloc();
+    if (copy == NULL) {
+      SinglyLinkedListNode_free_chain(first);
+      PyErr_NoMemory();
+      return -1;
+    }
+    Py_INCREF(n->data);
+    copy->data = n->data;
+    if (step < 0) {
+      copy->next = first;
+      first = copy;
+      if (last == NULL) {
+        last = copy;
+      }
+    }
+    else {
+      copy->next = NULL;
+      if (first == NULL) {
+        first = copy;
+      }
+      else {
+        last->next = copy;
+      }
+      last = copy;
+    }
+  }
+  *headp = first;
+  *tailp = last;
+  return 0;
+}
+
+/* Compares item with the items of the chain starting at head from index
+ * start up to stop, on behalf of a list whose modification counter is at
+ * statep.  Unless count is set, stops at the first equal item and sets
+ * *resultp to its index, or to -1 if there is none; otherwise sets it to
+ * the number of equal items.  A comparison that mutates the list may free
+ * the node being visited, so that raises RuntimeError.  Returns 0 on
+ * success and -1 on error. */
+static int
+SinglyLinkedListNode_chain_search(SinglyLinkedListNode *n, PyObject *item,
+                                  Py_ssize_t start, Py_ssize_t stop,
+                                  int count, long *statep, const char *name,
+                                  Py_ssize_t *resultp)
+{
+  Py_ssize_t i, found = 0;
+  long state = *statep;
+  int cmp;
+
+  for (i = 0; n && i < start; ++i) {
+    n = n->next;
+  }
+  for (; n && i < stop; n = n->next, ++i) {
+    cmp = List_item_eq(n->data, item);
+    if (cmp < 0) {
+      return -1;
+    }
+    if (*statep != state) {
+      PyErr_Format(PyExc_RuntimeError, "%s mutated during search", name);
+      return -1;
+    }
+    if (cmp) {
+      if (!count) {
+        *resultp = i;
+        return 0;
+      }
+      ++found;
+    }
+  }
+  *resultp = count ? found : -1;
+  return 0;
+}
+
+/* Unlinks the nodes of a list's chain whose items predicate returns
+ * remove_matches for, given pointers to the list's head, tail (NULL for a
+ * list without one), size and modification counter.  The predicate is
+ * called for every item first, with the list left untouched, and the
+ * picked nodes are unlinked in a second walk, as ArrayList_filter does:
+ * if the predicate raises, the nodes picked so far are still unlinked, and
+ * if it modifies the list, RuntimeError is raised and nothing is unlinked.
+ * Unlinked nodes have their items released last.  Sets *countp to the
+ * number of nodes unlinked.  Returns 0 on success and -1 on error. */
+static int
+SinglyLinkedListNode_chain_filter(SinglyLinkedListNode **headp,
+                                  SinglyLinkedListNode **tailp,
+                                  Py_ssize_t *sizep, long *statep,
+                                  PyObject *predicate, int remove_matches,
+                                  const char *name, Py_ssize_t *countp)
+{
+  SinglyLinkedListNode *prev = NULL, *n, *next;
+  SinglyLinkedListNode *removed = NULL, **removed_tail = &removed;
+  char *picked;
+  Py_ssize_t size, judged, count = 0, i;
+  long state = *statep;
+  int truth = 0;
+
+  *countp = 0;
+  size = *sizep;
+  picked = PyMem_Malloc(size > 0 ? size : 1);
+  if (picked == NULL) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  for (judged = 0, n = *headp; n; n = n->next, ++judged) {
+    truth = List_call_predicate(predicate, n->data);
+    if (truth < 0 || *statep != state) {
+      break;
+    }
+    picked[judged] = truth == remove_matches;
+  }
+  if (*statep != state) {
+    PyMem_Free(picked);
+    if (truth >= 0) {
+      PyErr_Format(PyExc_RuntimeError, "%s mutated during %s", name,
+                   remove_matches ? "remove_if" : "retain");
+    }
+    return -1;
+  }
+  for (i = 0, n = *headp; i < judged; ++i, n = next) {
+    next = n->next;
+    if (!picked[i]) {
+      prev = n;
+      continue;
+    }
+    if (prev == NULL) {
+      *headp = next;
+    }
+    else {
+      prev->next = next;
+    }
+    if (tailp != NULL && *tailp == n) {
+      *tailp = prev;
+    }
+    n->next = NULL;
+    *removed_tail = n;
+    removed_tail = &n->next;
+    ++count;
+  }
+  PyMem_Free(picked);
+  if (count > 0) {
+    *sizep -= count;
+    ++*statep;
+  }
+  *countp = count;
+  SinglyLinkedListNode_free_chain(removed);
+  return truth < 0 ? -1 : 0;
+}
+
+/* Reverses the chain starting at head in place and returns its new head. */
+static SinglyLinkedListNode *
+SinglyLinkedListNode_reverse(SinglyLinkedListNode *head)
+{
+  SinglyLinkedListNode *prev = NULL, *next;
+
+  while (head) {
+    next = head->next;
+    head->next = prev;
+    prev = head;
+    head = next;
+  }
+  return prev;
+}
+
+/* Merges the sorted chains a and b, taking from a on ties.  Once *failed
+ * is set no more comparisons are made and the rest of a is followed by
+ * the rest of b, so no node is lost. */
+static SinglyLinkedListNode *
+SinglyLinkedListNode_merge(SinglyLinkedListNode *a, SinglyLinkedListNode *b,
+                           ListSort_lt lt, int *failed)
+{
+  SinglyLinkedListNode head, *tail = &head;
+  int c;
+
+  while (a && b && !*failed) {
+    c = lt(b->data, a->data);
+    if (c < 0) {
+      *failed = 1;
+      break;
+    }
+    if (c) {
+      tail->next = b;
+      b = b->next;
+    }
+    else {
+      tail->next = a;
+      a = a->next;
+    }
+    tail = tail->next;
+  }
+  if (a && b) {
+    tail->next = a;
+    while (tail->next) {
+      tail = tail->next;
+    }
+    tail->next = b;
+  }
+  else {
+    tail->next = a ? a : b;
+  }
+  return head.next;
+}
+
+/* Detaches and returns the run at the front of *restp, reversing it first
+ * if it is strictly descending.  Once *failed is set the whole rest is
+ * returned as one run. */
+static SinglyLinkedListNode *
+SinglyLinkedListNode_take_run(SinglyLinkedListNode **restp, ListSort_lt lt,
+                              int *failed)
+{
+  SinglyLinkedListNode *run = *restp, *cur, *next, *rev;
+  int c;
+
+  *restp = NULL;
+  if (*failed || run->next == NULL) {
+    return run;
+  }
+  cur = run->next;
+  c = lt(cur->data, run->data);
+  if (c < 0) {
+    *failed = 1;
+    return run;
+  }
+  if (c) {
+    rev = run;
+    rev->next = NULL;
+    for (;;) {
+      next = cur->next;
+      cur->next = rev;
+      rev = cur;
+      if (next == NULL) {
+        break;
+      }
+      c = lt(next->data, cur->data);
+      if (c <= 0) {
+        *failed = c < 0;
+        *restp = next;
+        break;
+      }
+      cur = next;
+    }
+    return rev;
+  }
+  for (;;) {
+    next = cur->next;
+    if (next == NULL) {
+      break;
+    }
+    c = lt(next->data, cur->data);
+    if (c != 0) {
+      *failed = c < 0;
+      *restp = next;
+      cur->next = NULL;
+      break;
+    }
+    cur = next;
+  }
+  return run;
+}
+
+#define SINGLYLINKEDLIST_SORT_BINS 64
+
+/* Sorts the chain starting at head by relinking its nodes and returns its
+ * new head, allocating nothing.  Natural runs are fed into bins that hold
+ * merged chains of about 2**k runs, as in a binary counter, so sorted or
+ * reversed input is a single run and takes one pass.  Sets *failed, with
+ * an exception, if a comparison fails; the chain is still complete. */
+static SinglyLinkedListNode *
+SinglyLinkedListNode_sort(SinglyLinkedListNode *head, int *failed)
+{
+  SinglyLinkedListNode *bins[SINGLYLINKEDLIST_SORT_BINS] = {NULL};
+  SinglyLinkedListNode *run, *n;
+  ListSort_lt lt;
+  int k;
+
+  *failed = 0;
+  if (head == NULL) {
+    return NULL;
+  }
+  lt = ListSort_lt_for(head->data);
+  for (n = head->next; n && lt != ListSort_lt_generic; n = n->next) {
+    if (ListSort_lt_for(n->data) != lt) {
+      lt = ListSort_lt_generic;
+    }
+  }
+  while (head) {
+    run = SinglyLinkedListNode_take_run(&head, lt, failed);
+    for (k = 0; k < SINGLYLINKEDLIST_SORT_BINS - 1 && bins[k]; ++k) {
+      run = SinglyLinkedListNode_merge(bins[k], run, lt, failed);
+      bins[k] = NULL;
+    }
+    bins[k] = SinglyLinkedListNode_merge(bins[k], run, lt, failed);
+  }
+  for (run = NULL, k = 0; k < SINGLYLINKEDLIST_SORT_BINS; ++k) {
+    run = SinglyLinkedListNode_merge(bins[k], run, lt, failed);
+  }
+  return run;
+}
+
+/* Implements sort() for either singly linked list, given pointers to its
+ * head, size and modification counter, and to its tail if it keeps one.
+ * Without a key function the nodes are relinked while detached from the
+ * list, so anything a comparison adds to the list is discarded, as in
+ * list.sort().  With one, the keys are
+ * computed into a temporary array and the sorted items are written back
+ * into the existing nodes. */
+static int
+SinglyLinkedListNode_sort_list(SinglyLinkedListNode **headp,
+                               SinglyLinkedListNode **tailp, Py_ssize_t *sizep,
+                               long *statep, PyObject *keyfunc, int reverse,
+                               const char *name)
+{
+  SinglyLinkedListNode *head, *added, *n;
+  PyObject **values;
+  Py_ssize_t size, i;
+  long state;
+  int failed, result;
+
+  size = *sizep;
+  if (keyfunc != Py_None) {
+    values = PyMem_New(PyObject *, size > 0 ? size : 1);
+    if (values == NULL) {
+      PyErr_NoMemory();
+      return -1;
+    }
+    for (i = 0, n = *headp; n; n = n->next, ++i) {
+      Py_INCREF(n->data);
+      values[i] = n->data;
+    }
+    state = *statep;
+    result = ListSort_sort_values(values, size, keyfunc, reverse);
+    if (*statep == state) {
+      for (i = 0, n = *headp; n; n = n->next, ++i) {
+        n->data = values[i];
+      }
+      ++*statep;
+    }
+    else if (result == 0) {
+      PyErr_Format(PyExc_ValueError, "%s modified during sort", name);
+      result = -1;
+    }
+    for (i = 0; i < size; ++i) {
+      Py_DECREF(values[i]);
+    }
+    PyMem_Del(values);
+    return result;
+  }
+
+  head = *headp;
+  *headp = NULL;
+  if (tailp != NULL) {
+    *tailp = NULL;
+  }
+  *sizep = 0;
+  ++*statep;
+  if (reverse) {
+    head = SinglyLinkedListNode_reverse(head);
+  }
+  head = SinglyLinkedListNode_sort(head, &failed);
+  if (reverse) {
+    head = SinglyLinkedListNode_reverse(head);
+  }
+  added = *headp;
+  *headp = head;
+  if (tailp != NULL) {
+    *tailp = head;
+    while (*tailp != NULL && (*tailp)->next != NULL) {
+      *tailp = (*tailp)->next;
+    }
+  }
+  *sizep = size;
+  ++*statep;
+  if (added != NULL) {
+    if (!failed) {
+      PyErr_Format(PyExc_ValueError, "%s modified during sort", name);
+      failed = 1;
+    }
+    SinglyLinkedListNode_free_chain(added);
+  }
+  return failed ? -1 : 0;
+}
+
+
+/* SinglyLinkedListIterator
+ * Iterates over either singly linked list by following next pointers, so a
+ * full scan is a single walk.  state points at the list's modification
+ * counter; the iterator raises once it no longer matches. */
+typedef struct {
+  PyObject_HEAD
+  PyObject             *list;
+  SinglyLinkedListNode *node;
+  long                 *state;
+  long                 expected_state;
+} SinglyLinkedListIterator;
+
+/* Returns a new iterator over the chain starting at head that belongs to
+ * list and is guarded by *state. */
+static PyObject *
+SinglyLinkedListIterator_new(PyObject *list, SinglyLinkedListNode *head,
+                             long *state)
+{
+  SinglyLinkedListIterator *it;
+
+  it = PyObject_GC_New(SinglyLinkedListIterator,
+                       &SinglyLinkedListIteratorType);
+  if (it == NULL) {
+    return NULL;
+  }
+  Py_INCREF(list);
+  it->list = list;
+  it->node = head;
+  it->state = state;
+  it->expected_state = *state;
+  PyObject_GC_Track(it);
+  return (PyObject *)it;
+}
+
+/* SinglyLinkedListIteratorType.tp_dealloc */
+static void
+SinglyLinkedListIterator_dealloc(SinglyLinkedListIterator *self)
+{
+  PyObject_GC_UnTrack(self);
+  Py_XDECREF(self->list);
+  PyObject_GC_Del(self);
+}
+
+/* SinglyLinkedListIteratorType.tp_traverse */
+static int
+SinglyLinkedListIterator_traverse(SinglyLinkedListIterator *self,
+                                  visitproc visit, void *arg)
+{
+  Py_VISIT(self->list);
+  return 0;
+}
+
+/* SinglyLinkedListIteratorType.tp_clear
+ * node and state point into the list, so they are dropped with it. */
+static int
+SinglyLinkedListIterator_clear(SinglyLinkedListIterator *self)
+{
+  self->node = NULL;
+  Py_CLEAR(self->list);
+  return 0;
+}
+
+/* SinglyLinkedListIteratorType.tp_iternext */
+static PyObject *
+SinglyLinkedListIterator_next(SinglyLinkedListIterator *self)
+{
+  PyObject *item;
+
+  if (self->list == NULL) {
+    return NULL;
+  }
+  if (*self->state != self->expected_state) {
+    PyErr_SetString(PyExc_RuntimeError, "LinkedList mutated during iteration");
+    self->node = NULL;
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  if (self->node == NULL) {
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  item = self->node->data;
+  self->node = self->node->next;
+  Py_INCREF(item);
+  return item;
+}
+
+PyTypeObject SinglyLinkedListIteratorType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.SinglyLinkedListIterator",
+                                        /* tp_name */
+  sizeof(SinglyLinkedListIterator),     /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)SinglyLinkedListIterator_dealloc,
+                                        /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  0,                                    /* tp_repr */
+  0,                                    /* tp_as_number */
+  0,                                    /* tp_as_sequence */
+  0,                                    /* tp_as_mapping */
+  0,                                    /* tp_hash  */
+  0,                                    /* tp_call */
+  0,                                    /* tp_str */
+  PyObject_GenericGetAttr,              /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  0,                                    /* tp_doc */
+  (traverseproc)SinglyLinkedListIterator_traverse,
+                                        /* tp_traverse */
+  (inquiry)SinglyLinkedListIterator_clear,
+                                        /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  PyObject_SelfIter,                    /* tp_iter */
+  (iternextfunc)SinglyLinkedListIterator_next,
+                                        /* tp_iternext */
+};
+
+
+/* SinglyLinkedList1
+ * Resizable singly-linked-node-based implementation of the List interface. */
+typedef struct {
+  PyObject_HEAD
+  SinglyLinkedListNode *head;
+  Py_ssize_t size;
+  long state;
+  SinglyLinkedListNode *finger;
+  Py_ssize_t finger_index;
+  long finger_state;
+#if EDUCOLLECTIONS_STATS
+  ListStats stats;
+#endif
+} SinglyLinkedList1;
+
+PyDoc_STRVAR(SinglyLinkedList1_doc,
+  "Resizable singly-linked-node-based implementation of the List interface.");
+
+/* SinglyLinkedList1Type.tp_new */
+static PyObject *
+SinglyLinkedList1_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  SinglyLinkedList1 *self;
+
+  self = (SinglyLinkedList1 *)type->tp_alloc(type, 0);
+  if (self == NULL)
+      return NULL;
+
+  self->head = NULL;
+  self->size = 0;
+  self->state = 0;
+  self->finger = NULL;
+  self->finger_index = 0;
+  self->finger_state = 0;
+
+  return (PyObject *)self;
+}
+
+/* Returns the node at index, which must be in range.  The walk starts from
+ * the finger, the last node reached this way, when no mutation has happened
+ * since and it is at or before index, so forward-sequential access costs
+ * O(1) per call.  Mutators that leave every node up to the finger in place
+ * revalidate it by copying state into finger_state. */
+static SinglyLinkedListNode *
+SinglyLinkedList1_node_at(SinglyLinkedList1 *self, Py_ssize_t index)
+{
+  SinglyLinkedListNode *n = self->head;
+  Py_ssize_t start = 0;
+
+  if (self->finger != NULL && self->finger_state == self->state &&
+      self->finger_index <= index) {
+    n = self->finger;
+    start = self->finger_index;
+  }
+  n = SinglyLinkedListNode_at(n, index - start);
+  LISTSTATS_ADD(self, walked, index - start);
+  self->finger = n;
+  self->finger_index = index;
+  self->finger_state = self->state;
+  return n;
+}
+
+/* SinglyLinkedList1Type.tp_init */
+static int
+SinglyLinkedList1_init(SinglyLinkedList1 *self, PyObject *args, PyObject *kwds)
+{
+  return 0;
+}
+
+/* SinglyLinkedList1Type.tp_vectorcall
+ * The constructor takes no arguments, so the common call allocates the list
+ * directly. */
+static PyObject *
+SinglyLinkedList1_vectorcall(PyObject *type, PyObject *const *args,
+                               size_t nargsf, PyObject *kwnames)
+{
+  if (type != (PyObject *)&SinglyLinkedListType1 || PyVectorcall_NARGS(nargsf) != 0 ||
+      (kwnames != NULL && PyTuple_GET_SIZE(kwnames) != 0)) {
+    return List_vectorcall_fallback(type, args, nargsf, kwnames);
+  }
+  return SinglyLinkedList1_new((PyTypeObject *)type, NULL, NULL);
+}
+
+/* SinglyLinkedList1Type.tp_traverse */
+static int
+SinglyLinkedList1_traverse(SinglyLinkedList1 *self, visitproc visit, void *arg)
+{
+  return SinglyLinkedListNode_traverse_chain(self->head, visit, arg);
+}
+
+/* SinglyLinkedList1Type.tp_clear
+ * Detaches the chain before releasing its items, which can run arbitrary
+ * code. */
+static int
+SinglyLinkedList1_tp_clear(SinglyLinkedList1 *self)
+{
+  SinglyLinkedListNode *n;
+
+  n = self->head;
+  self->head = NULL;
+  LISTSTATS_ADD(self, frees, self->size);
+  self->size = 0;
+  ++self->state;
+  SinglyLinkedListNode_free_chain(n);
+  return 0;
+}
+
+/* SinglyLinkedList1Type.tp_dealloc */
+static void
+SinglyLinkedList1_dealloc(SinglyLinkedList1 *self)
+{
+  PyObject_GC_UnTrack(self);
+  SinglyLinkedListNode_free_chain(self->head);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* SinglyLinkedList1.append(item) */
+static PyObject *
+SinglyLinkedList1_append(SinglyLinkedList1 *self, PyObject *item)
+{
+  SinglyLinkedListNode *n, *tail;
+
+  n = SinglyLinkedListNode_alloc();
+  if (n == NULL) {
+      PyErr_NoMemory();
+      return NULL;
+  }
+  n->next = NULL;
+  Py_INCREF(item);
+  ++self->size;
+  n->data = item;
+  if (self->head == NULL) {
+    self->head = n;
+    ++self->state;
+  }
+  else {
+    tail = SinglyLinkedList1_node_at(self, self->size - 2);
+    tail->next = n;
+    ++self->state;
+    self->finger_state = self->state;
+  }
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_PEAK(self);
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList1.clear() */
+static PyObject *
+SinglyLinkedList1_clear(SinglyLinkedList1 *self)
+{
+  SinglyLinkedList1_tp_clear(self);
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList1.extend(iterable) */
+static PyObject *
+SinglyLinkedList1_extend(SinglyLinkedList1 *self, PyObject *iterable)
+{
+  SinglyLinkedListNode *head, *tail;
+  Py_ssize_t size;
+
+  if (SinglyLinkedListNode_chain_from_iterable(iterable, &head, &tail,
+                                               &size) < 0) {
+    return NULL;
+  }
+  if (size > 0) {
+    if (self->head == NULL) {
+      self->head = head;
+      ++self->state;
+    }
+    else {
+      SinglyLinkedList1_node_at(self, self->size - 1)->next = head;
+      ++self->state;
+      self->finger_state = self->state;
+    }
+    self->size += size;
+    LISTSTATS_ADD(self, allocs, size);
+    LISTSTATS_PEAK(self);
+  }
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList1.from_iterable(iterable) */
+static PyObject *
+SinglyLinkedList1_from_iterable(PyTypeObject *type, PyObject *iterable)
+{
+  PyObject *self, *result;
+
+  self = PyObject_CallNoArgs((PyObject *)type);
+  if (self == NULL) {
+    return NULL;
+  }
+  result = SinglyLinkedList1_extend((SinglyLinkedList1 *)self, iterable);
+  if (result == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  Py_DECREF(result);
+  return self;
+}
+
+/* SinglyLinkedList1Type.tp_as_sequence->sq_item */
+static PyObject *
+SinglyLinkedList1_item(SinglyLinkedList1 *self, Py_ssize_t index)
+{
+  SinglyLinkedListNode *n;
+  PyObject *item;
+
+  if (index < 0 || index > self->size - 1) {
+  PyErr_SetString(PyExc_IndexError, "LinkedList index out of range");
+  return NULL;
+  }
+
+  n = SinglyLinkedList1_node_at(self, index);
+  item = n->data;
+  Py_INCREF(item);
+  return item;
+}
+
+/* SinglyLinkedList1.get(index) */
+static PyObject *
+SinglyLinkedList1_get(SinglyLinkedList1 *self, PyObject *indexobj)
+{
+  Py_ssize_t index = -1;
+
+  if (indexobj != NULL && indexobj != Py_None) {
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred())
+    return NULL;
+  }
+  return SinglyLinkedList1_item(self, index);
+}
+
+static PyObject * SinglyLinkedList1_prepend(SinglyLinkedList1 *self, PyObject *item);
+
+/* SinglyLinkedList1.insert(index, item) */
+static PyObject *
+SinglyLinkedList1_insert(SinglyLinkedList1 *self, PyObject *const *args,
+                         Py_ssize_t nargs)
+{
+  SinglyLinkedListNode *n, *tmp;
+  PyObject *indexobj = NULL, *itemobj = NULL;
+  Py_ssize_t index = -1;
+
+  if (!List_check_nargs("insert", nargs, 2)) {
+    return NULL;
+  }
+  indexobj = args[0];
+  itemobj = args[1];
+  if (indexobj != NULL && indexobj != Py_None) {
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred())
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+  PyErr_SetString(PyExc_IndexError, "SinglyLinkedList1 index out of range");
+  return NULL;
+  }
+  if (itemobj == NULL) {
+  PyErr_SetString(PyExc_ValueError, "item == NULL");
+  return NULL;
+  }
+
+  if (index == 0)
+  return SinglyLinkedList1_prepend(self, itemobj);
+  n = SinglyLinkedList1_node_at(self, index - 1);
+  tmp = SinglyLinkedListNode_alloc();
+  if (tmp == NULL) {
+    PyErr_NoMemory();
+    return NULL;
+  }
+  ++self->state;
+  self->finger_state = self->state;
+  ++self->size;
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_PEAK(self);
+  Py_INCREF(itemobj);
+  tmp->data = itemobj;
+  tmp->next = n->next;
+  n->next = tmp;
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList1.prepend(item) */
+static PyObject *
+SinglyLinkedList1_prepend(SinglyLinkedList1 *self, PyObject *item)
+{
+  SinglyLinkedListNode *n;
+
+  ++self->state;
+  n = SinglyLinkedListNode_alloc();
+  if (n == NULL) {
+      PyErr_NoMemory();
+      return NULL;
+  }
+  n->next = self->head;
+  Py_INCREF(item);
+  ++self->size;
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_PEAK(self);
+  n->data = item;
+  self->head = n;
+  Py_RETURN_NONE;
+}
+
+/* Removes and returns the item at index, which must be in range.  Without a
+ * tail pointer, removing the last node is the general case. */
+static PyObject *
+SinglyLinkedList1_remove_index(SinglyLinkedList1 *self, Py_ssize_t index)
+{
+  PyObject *item;
+  SinglyLinkedListNode *n, *remove;
+
+  if (index == 0) {
+    item = self->head->data;
+    --self->size;
+    ++self->state;
+    n = self->head;
+    self->head = self->head->next;
+    LISTSTATS_ADD(self, frees, 1);
+    SinglyLinkedListNode_free(n);
+    return item;
+  }
+
+  n = SinglyLinkedList1_node_at(self, index - 1);
+  LISTSTATS_ADD(self, frees, 1);
+  remove = n->next;
+  item = remove->data;
+  n->next = remove->next;
+  SinglyLinkedListNode_free(remove);
+  --self->size;
+  ++self->state;
+  self->finger_state = self->state;
+  return item;
+}
+
+/* SinglyLinkedList1.remove(index) */
+static PyObject *
+SinglyLinkedList1_remove(SinglyLinkedList1 *self, PyObject *indexobj)
+{
+  Py_ssize_t index = -1;
+
+  if (indexobj != NULL && indexobj != Py_None) {
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred())
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+  PyErr_SetString(PyExc_IndexError, "SinglyLinkedList1 index out of range");
+  return NULL;
+  }
+  return SinglyLinkedList1_remove_index(self, index);
+}
+
+/* SinglyLinkedList1Type.tp_as_sequence->sq_ass_item
+ * Assigns item at index, or deletes the item at index if item is NULL. */
+static int
+SinglyLinkedList1_ass_item(SinglyLinkedList1 *self, Py_ssize_t index,
+                            PyObject *item)
+{
+  SinglyLinkedListNode *n;
+  PyObject *old_item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "SinglyLinkedList1 index out of range");
+    return -1;
+  }
+  if (item == NULL) {
+    old_item = SinglyLinkedList1_remove_index(self, index);
+    Py_DECREF(old_item);
+    return 0;
+  }
+
+  n = SinglyLinkedList1_node_at(self, index);
+  ++self->state;
+  self->finger_state = self->state;
+  old_item = n->data;
+  Py_INCREF(item);
+  n->data = item;
+  Py_DECREF(old_item);
+  return 0;
+}
+
+/* Implements remove_if() and retain() for SinglyLinkedList1. */
+static PyObject *
+SinglyLinkedList1_filter(SinglyLinkedList1 *self, PyObject *predicate, int remove_matches)
+{
+  Py_ssize_t count;
+  int result;
+
+  result = SinglyLinkedListNode_chain_filter(&self->head, NULL,
+                                             &self->size, &self->state,
+                                             predicate, remove_matches,
+                                             "SinglyLinkedList1", &count);
+  LISTSTATS_ADD(self, frees, count);
+  if (result < 0) {
+    return NULL;
+  }
+  return PyLong_FromSsize_t(count);
+}
+
+/* SinglyLinkedList1.remove_if(predicate) */
+static PyObject *
+SinglyLinkedList1_remove_if(SinglyLinkedList1 *self, PyObject *predicate)
+{
+  return SinglyLinkedList1_filter(self, predicate, 1);
+}
+
+/* SinglyLinkedList1.retain(predicate) */
+static PyObject *
+SinglyLinkedList1_retain(SinglyLinkedList1 *self, PyObject *predicate)
+{
+  return SinglyLinkedList1_filter(self, predicate, 0);
+}
+
+/* SinglyLinkedList1.set(index, item) */
+static PyObject *
+SinglyLinkedList1_set(SinglyLinkedList1 *self, PyObject *const *args,
+                      Py_ssize_t nargs)
+{
+  PyObject *indexobj = NULL, *itemobj = NULL;
+  Py_ssize_t index = -1;
+
+  if (!List_check_nargs("set", nargs, 2)) {
+    return NULL;
+  }
+  indexobj = args[0];
+  itemobj = args[1];
+  if (indexobj != NULL && indexobj != Py_None) {
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred())
+    return NULL;
+  }
+  if (itemobj == NULL) {
+    PyErr_SetString(PyExc_ValueError, "item == NULL");
+    return NULL;
+  }
+  if (SinglyLinkedList1_ass_item(self, index, itemobj) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList1.sort(*, key=None, reverse=False) */
+static PyObject *
+SinglyLinkedList1_sort(SinglyLinkedList1 *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *keyfunc;
+  int reverse, result;
+
+  if (!ListSort_parse_args(args, kwds, &keyfunc, &reverse)) {
+    return NULL;
+  }
+  result = SinglyLinkedListNode_sort_list(&self->head, NULL, &self->size,
+                                          &self->state, keyfunc, reverse,
+                                          "SinglyLinkedList1");
+  if (result < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList1.index_of(item[, start[, stop]]) */
+static PyObject *
+SinglyLinkedList1_index_of(SinglyLinkedList1 *self, PyObject *args)
+{
+  PyObject *item;
+  Py_ssize_t start, stop, index;
+
+  if (!List_parse_index_of_args(args, self->size, &item, &start, &stop)) {
+    return NULL;
+  }
+  if (SinglyLinkedListNode_chain_search(self->head, item, start, stop, 0,
+                                        &self->state, "SinglyLinkedList1",
+                                        &index) < 0) {
+    return NULL;
+  }
+  if (index < 0) {
+    PyErr_Format(PyExc_ValueError, "%R is not in SinglyLinkedList1", item);
+    return NULL;
+  }
+  return PyLong_FromSsize_t(index);
+}
+
+static int SinglyLinkedList1_contains(SinglyLinkedList1 *self, PyObject *item);
+
+/* SinglyLinkedList1.contains(item) */
+static PyObject *
+SinglyLinkedList1_contains_method(SinglyLinkedList1 *self, PyObject *item)
+{
+  int cmp;
+
+  cmp = SinglyLinkedList1_contains(self, item);
+  if (cmp < 0) {
+    return NULL;
+  }
+  return PyBool_FromLong(cmp);
+}
+
+/* SinglyLinkedList1.count(item) */
+static PyObject *
+SinglyLinkedList1_count(SinglyLinkedList1 *self, PyObject *item)
+{
+  Py_ssize_t count;
+
+  if (SinglyLinkedListNode_chain_search(self->head, item, 0, self->size, 1,
+                                        &self->state, "SinglyLinkedList1",
+                                        &count) < 0) {
+    return NULL;
+  }
+  return PyLong_FromSsize_t(count);
+}
+
+/* SinglyLinkedList1.size() */
+static PyObject *
+SinglyLinkedList1_size(SinglyLinkedList1 *self)
+{
+  return PyLong_FromSsize_t(self->size);
+}
+
+#if EDUCOLLECTIONS_STATS
+/* SinglyLinkedList1.stats() */
+static PyObject *
+SinglyLinkedList1_stats(SinglyLinkedList1 *self)
+{
+  return ListStats_dict(&self->stats);
+}
+
+/* SinglyLinkedList1.reset_stats() */
+static PyObject *
+SinglyLinkedList1_reset_stats(SinglyLinkedList1 *self)
+{
+  ListStats_reset(&self->stats, self->size);
+  Py_RETURN_NONE;
+}
+#endif
+
+/* SinglyLinkedList1Type.tp_iter */
+static PyObject *
+SinglyLinkedList1_iter(SinglyLinkedList1 *self)
+{
+  return SinglyLinkedListIterator_new((PyObject *)self, self->head,
+                                      &self->state);
+}
+
+/* SinglyLinkedList1Type.tp_as_sequence->sq_length */
+static Py_ssize_t
+SinglyLinkedList1_length(SinglyLinkedList1 *self)
+{
+  return self->size;
+}
+
+/* SinglyLinkedList1Type.tp_as_sequence->sq_contains */
+static int
+SinglyLinkedList1_contains(SinglyLinkedList1 *self, PyObject *item)
+{
+  Py_ssize_t index;
+
+  if (SinglyLinkedListNode_chain_search(self->head, item, 0, self->size, 0,
+                                        &self->state, "SinglyLinkedList1",
+                                        &index) < 0) {
+    return -1;
+  }
+  return index >= 0;
+}
+
+/* SinglyLinkedList1Type.tp_as_mapping->mp_subscript */
+static PyObject *
+SinglyLinkedList1_subscript(SinglyLinkedList1 *self, PyObject *key)
+{
+  SinglyLinkedList1 *result;
+  SinglyLinkedListNode *head, *tail;
+  Py_ssize_t index, start, stop, step, slicelength;
+
+  if (PyIndex_Check(key)) {
+    index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+    if (index < 0) {
+      index += self->size;
+    }
+    return SinglyLinkedList1_item(self, index);
+  }
+  if (!PySlice_Check(key)) {
+    PyErr_Format(PyExc_TypeError,
+                 "SinglyLinkedList1 indices must be integers or slices, not %.200s",
+                 Py_TYPE(key)->tp_name);
+    return NULL;
+  }
+  if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+    return NULL;
+  }
+  slicelength = PySlice_AdjustIndices(self->size, &start, &stop, step);
+  result = (SinglyLinkedList1 *)PyObject_CallNoArgs((PyObject *)Py_TYPE(self));
+  if (result == NULL) {
+    return NULL;
+  }
+  if (SinglyLinkedListNode_chain_slice(self->head, start, step, slicelength,
+                                       &head, &tail) < 0) {
+    Py_DECREF(result);
+    return NULL;
+  }
+  result->head = head;
+  result->size = slicelength > 0 ? slicelength : 0;
+  LISTSTATS_ADD(result, allocs, result->size);
+  LISTSTATS_PEAK(result);
+  return (PyObject *)result;
+}
+
+/* SinglyLinkedList1Type.tp_as_sequence->sq_inplace_concat */
+static PyObject *
+SinglyLinkedList1_inplace_concat(SinglyLinkedList1 *self, PyObject *other)
+{
+  PyObject *result;
+
+  result = SinglyLinkedList1_extend(self, other);
+  if (result == NULL) {
+    return NULL;
+  }
+  Py_DECREF(result);
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
+
+/* SinglyLinkedList1Type.tp_repr */
+static PyObject *
+SinglyLinkedList1_repr(PyObject *self)
+{
+  /* PyObject *aslist, *result; */
+  /* int i; */
+
+  /* i = Py_ReprEnter(self); */
+  /* if (i != 0) { */
+  /*     if (i < 0) */
+  /*         return NULL; */
+  /*     return PyUnicode_FromString("[...]"); */
+  /* } */
+
+  /* aslist = PySequence_List(self); */
+  /* if (aslist == NULL) { */
+  /*     Py_ReprLeave(self); */
+  /*     return NULL; */
+  /* } */
+  /* result = PyUnicode_FromFormat("%R", aslist); */
+  /* Py_DECREF(aslist); */
+  /* Py_ReprLeave(self); */
+  /* return result; */
+  return PyUnicode_FromString("[...]");
+}
+
+/* SinglyLinkedList1Type.tp_str */
+static PyObject *
+SinglyLinkedList1_str(PyObject *self)
+{
+  /* PyObject *aslist, *result; */
+  /* int i; */
+
+  /* i = Py_ReprEnter(self); */
+  /* if (i != 0) { */
+  /*     if (i < 0) */
+  /*         return NULL; */
+  /*     return PyUnicode_FromString("[...]"); */
+  /* } */
+
+  /* aslist = PySequence_List(self); */
+  /* if (aslist == NULL) { */
+  /*     Py_ReprLeave(self); */
+  /*     return NULL; */
+  /* } */
+  /* result = PyUnicode_FromFormat("%R", aslist); */
+  /* Py_DECREF(aslist); */
+  /* Py_ReprLeave(self); */
+  /* return result; */
+  return PyUnicode_FromString("[...]");
+}
+
+static PyMethodDef SinglyLinkedList1_methods[] = {
+  {"append",                  (PyCFunction)SinglyLinkedList1_append,
+      METH_O,                  List_append_doc},
+  {"clear",                   (PyCFunction)SinglyLinkedList1_clear,
+      METH_NOARGS,             List_clear_doc},
+  {"contains",                (PyCFunction)SinglyLinkedList1_contains_method,
+      METH_O,                  List_contains_doc},
+  {"count",                   (PyCFunction)SinglyLinkedList1_count,
+      METH_O,                  List_count_doc},
+  {"extend",                  (PyCFunction)SinglyLinkedList1_extend,
+      METH_O,                  List_extend_doc},
+  {"from_iterable",           (PyCFunction)SinglyLinkedList1_from_iterable,
+      METH_O | METH_CLASS,     List_from_iterable_doc},
+  {"get",                     (PyCFunction)SinglyLinkedList1_get,
+      METH_O,                  List_get_doc},
+  {"index_of",                (PyCFunction)SinglyLinkedList1_index_of,
+      METH_VARARGS,            List_index_of_doc},
+  {"insert",                  (PyCFunction)SinglyLinkedList1_insert,
+      METH_FASTCALL,           List_insert_doc},
+  {"prepend",                 (PyCFunction)SinglyLinkedList1_prepend,
+      METH_O,                  List_prepend_doc},
+  {"remove",                  (PyCFunction)SinglyLinkedList1_remove,
+      METH_O,                  List_remove_doc},
+  {"remove_if",               (PyCFunction)SinglyLinkedList1_remove_if,
+      METH_O,                  List_remove_if_doc},
+#if EDUCOLLECTIONS_STATS
+  {"reset_stats",             (PyCFunction)SinglyLinkedList1_reset_stats,
+      METH_NOARGS,             List_reset_stats_doc},
+#endif
+  {"retain",                  (PyCFunction)SinglyLinkedList1_retain,
+      METH_O,                  List_retain_doc},
+  {"set",                     (PyCFunction)SinglyLinkedList1_set,
+      METH_FASTCALL,           List_set_doc},
+  {"size",                    (PyCFunction)SinglyLinkedList1_size,
+      METH_NOARGS,             List_size_doc},
+  {"sort",                    (PyCFunction)SinglyLinkedList1_sort,
+      METH_VARARGS | METH_KEYWORDS,
+                               List_sort_doc},
+#if EDUCOLLECTIONS_STATS
+  {"stats",                   (PyCFunction)SinglyLinkedList1_stats,
+      METH_NOARGS,             List_stats_doc},
+#endif
+  {NULL,                      NULL}
+};
+
+static PySequenceMethods SinglyLinkedList1_as_sequence = {
+  (lenfunc)SinglyLinkedList1_length,    /* sq_length */
+  0,                                    /* sq_concat */
+  0,                                    /* sq_repeat */
+  (ssizeargfunc)SinglyLinkedList1_item, /* sq_item */
+  0,                                    /* was_sq_slice */
+  (ssizeobjargproc)SinglyLinkedList1_ass_item,
+                                        /* sq_ass_item */
+  0,                                    /* was_sq_ass_slice */
+  (objobjproc)SinglyLinkedList1_contains,
+                                        /* sq_contains */
+  (binaryfunc)SinglyLinkedList1_inplace_concat,
+                                        /* sq_inplace_concat */
+  0,                                    /* sq_inplace_repeat */
+};
+
+static PyMappingMethods SinglyLinkedList1_as_mapping = {
+  (lenfunc)SinglyLinkedList1_length,    /* mp_length */
+  (binaryfunc)SinglyLinkedList1_subscript,
+                                        /* mp_subscript */
+  0,                                    /* mp_ass_subscript */
+};
+
+PyTypeObject SinglyLinkedListType1 = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.SinglyLinkedList1",  /* tp_name */
+  sizeof(SinglyLinkedList1),            /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)SinglyLinkedList1_dealloc,/* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  SinglyLinkedList1_repr,               /* tp_repr */
+  0,                                    /* tp_as_number */
+  &SinglyLinkedList1_as_sequence,       /* tp_as_sequence */
+  &SinglyLinkedList1_as_mapping,        /* tp_as_mapping */
+  PyObject_HashNotImplemented,          /* tp_hash  */
+  0,                                    /* tp_call */
+  SinglyLinkedList1_str,                /* tp_str */
+  0,                                    /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_BASETYPE |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  SinglyLinkedList1_doc,                /* tp_doc */
+  (traverseproc)SinglyLinkedList1_traverse,
+                                        /* tp_traverse */
+  (inquiry)SinglyLinkedList1_tp_clear,  /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  (getiterfunc)SinglyLinkedList1_iter,  /* tp_iter */
+  0,                                    /* tp_iternext */
+  SinglyLinkedList1_methods,            /* tp_methods */
+  0,                                    /* tp_members */
+  0,                                    /* tp_getset */
+  0,                                    /* tp_base */
+  0,                                    /* tp_dict */
+  0,                                    /* tp_descr_get */
+  0,                                    /* tp_descr_set */
+  0,                                    /* tp_dictoffset */
+  (initproc)SinglyLinkedList1_init,     /* tp_init */
+  PyType_GenericAlloc,                  /* tp_alloc */
+  SinglyLinkedList1_new,                /* tp_new */
+  PyObject_GC_Del,                      /* tp_free */
+  0,                                    /* tp_is_gc */
+  0,                                    /* tp_bases */
+  0,                                    /* tp_mro */
+  0,                                    /* tp_cache */
+  0,                                    /* tp_subclasses */
+  0,                                    /* tp_weaklist */
+  0,                                    /* tp_del */
+  0,                                    /* tp_version_tag */
+  0,                                    /* tp_finalize */
+  SinglyLinkedList1_vectorcall,         /* tp_vectorcall */
+};
+
+
+/* SinglyLinkedList2
+ * Resizable singly-linked-node-based implementation of the List interface.
+ * Uses a tail pointer to make appending more efficient. */
+typedef struct {
+  PyObject_HEAD
+  SinglyLinkedListNode *head;
+  SinglyLinkedListNode *tail;
+  Py_ssize_t size;
+  long state;
+  SinglyLinkedListNode *finger;
+  Py_ssize_t finger_index;
+  long finger_state;
+#if EDUCOLLECTIONS_STATS
+  ListStats stats;
+#endif
+} SinglyLinkedList2;
+
+PyDoc_STRVAR(SinglyLinkedList2_doc,
+  "Resizable singly-linked-node-based implementation of the List interface.\n"
+  "Uses a tail pointer to make appending more efficient.");
+
+/* SinglyLinkedList2Type.tp_new */
+static PyObject *
+SinglyLinkedList2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  SinglyLinkedList2 *self;
+
+  self = (SinglyLinkedList2 *)type->tp_alloc(type, 0);
+  if (self == NULL)
+      return NULL;
+
+  self->head = NULL;
+  self->tail = NULL;
+  self->size = 0;
+  self->state = 0;
+  self->finger = NULL;
+  self->finger_index = 0;
+  self->finger_state = 0;
+
+  return (PyObject *)self;
+}
+
+/* Returns the node at index, which must be in range.  The walk starts from
+ * the finger, the last node reached this way, when no mutation has happened
+ * since and it is at or before index, so forward-sequential access costs
+ * O(1) per call.  Mutators that leave every node up to the finger in place
+ * revalidate it by copying state into finger_state. */
+static SinglyLinkedListNode *
+SinglyLinkedList2_node_at(SinglyLinkedList2 *self, Py_ssize_t index)
+{
+  SinglyLinkedListNode *n = self->head;
+  Py_ssize_t start = 0;
+
+  if (self->finger != NULL && self->finger_state == self->state &&
+      self->finger_index <= index) {
+    n = self->finger;
+    start = self->finger_index;
+  }
+  n = SinglyLinkedListNode_at(n, index - start);
+  LISTSTATS_ADD(self, walked, index - start);
+  self->finger = n;
+  self->finger_index = index;
+  self->finger_state = self->state;
+  return n;
+}
+
+/* SinglyLinkedList2Type.tp_init */
+static int
+SinglyLinkedList2_init(SinglyLinkedList2 *self, PyObject *args, PyObject *kwds)
+{
+  return 0;
+}
+
+/* SinglyLinkedList2Type.tp_vectorcall
+ * The constructor takes no arguments, so the common call allocates the list
+ * directly. */
+static PyObject *
+SinglyLinkedList2_vectorcall(PyObject *type, PyObject *const *args,
+                               size_t nargsf, PyObject *kwnames)
+{
+  if (type != (PyObject *)&SinglyLinkedListType2 || PyVectorcall_NARGS(nargsf) != 0 ||
+      (kwnames != NULL && PyTuple_GET_SIZE(kwnames) != 0)) {
+    return List_vectorcall_fallback(type, args, nargsf, kwnames);
+  }
+  return SinglyLinkedList2_new((PyTypeObject *)type, NULL, NULL);
+}
+
+/* SinglyLinkedList2Type.tp_traverse */
+static int
+SinglyLinkedList2_traverse(SinglyLinkedList2 *self, visitproc visit, void *arg)
+{
+  return SinglyLinkedListNode_traverse_chain(self->head, visit, arg);
+}
+
+/* SinglyLinkedList2Type.tp_clear
+ * Detaches the chain before releasing its items, which can run arbitrary
+ * code. */
+static int
+SinglyLinkedList2_tp_clear(SinglyLinkedList2 *self)
+{
+  SinglyLinkedListNode *n;
+
+  n = self->head;
+  self->head = NULL;
+  self->tail = NULL;
+  LISTSTATS_ADD(self, frees, self->size);
+  self->size = 0;
+  ++self->state;
+  SinglyLinkedListNode_free_chain(n);
+  return 0;
+}
+
+/* SinglyLinkedList2Type.tp_dealloc */
+static void
+SinglyLinkedList2_dealloc(SinglyLinkedList2 *self)
+{
+  PyObject_GC_UnTrack(self);
+  SinglyLinkedListNode_free_chain(self->head);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* SinglyLinkedList2.append(item) */
+static PyObject *
+SinglyLinkedList2_append(SinglyLinkedList2 *self, PyObject *item)
+{
+  SinglyLinkedListNode *n;
+
+  ++self->state;
+  n = SinglyLinkedListNode_alloc();
+  if (n == NULL) {
+      PyErr_NoMemory();
+      return NULL;
+  }
+  n->next = NULL;
+  Py_INCREF(item);
+  ++self->size;
+  n->data = item;
+  if (self->head == NULL) {
+    self->head = self->tail = n;
+  }
+  else {
+    self->tail->next = n;
+    self->tail = n;
+  }
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_PEAK(self);
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList2.clear() */
+static PyObject *
+SinglyLinkedList2_clear(SinglyLinkedList2 *self)
+{
+  SinglyLinkedList2_tp_clear(self);
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList2.extend(iterable) */
+static PyObject *
+SinglyLinkedList2_extend(SinglyLinkedList2 *self, PyObject *iterable)
+{
+  SinglyLinkedListNode *head, *tail;
+  Py_ssize_t size;
+
+  if (SinglyLinkedListNode_chain_from_iterable(iterable, &head, &tail,
+                                               &size) < 0) {
+    return NULL;
+  }
+  if (size > 0) {
+    if (self->head == NULL) {
+      self->head = head;
+    }
+    else {
+      self->tail->next = head;
+    }
+    self->tail = tail;
+    self->size += size;
+    ++self->state;
+    LISTSTATS_ADD(self, allocs, size);
+    LISTSTATS_PEAK(self);
+  }
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList2.from_iterable(iterable) */
+static PyObject *
+SinglyLinkedList2_from_iterable(PyTypeObject *type, PyObject *iterable)
+{
+  PyObject *self, *result;
+
+  self = PyObject_CallNoArgs((PyObject *)type);
+  if (self == NULL) {
+    return NULL;
+  }
+  result = SinglyLinkedList2_extend((SinglyLinkedList2 *)self, iterable);
+  if (result == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  Py_DECREF(result);
+  return self;
+}
+
+/* SinglyLinkedList2Type.tp_as_sequence->sq_item */
+static PyObject *
+SinglyLinkedList2_item(SinglyLinkedList2 *self, Py_ssize_t index)
+{
+  SinglyLinkedListNode *n;
+  PyObject *item;
+
+  if (index < 0 || index > self->size - 1) {
+  PyErr_SetString(PyExc_IndexError, "LinkedList index out of range");
+  return NULL;
+  }
+
+  n = SinglyLinkedList2_node_at(self, index);
+  item = n->data;
+  Py_INCREF(item);
+  return item;
+}
+
+/* SinglyLinkedList2.get(index) */
+static PyObject *
+SinglyLinkedList2_get(SinglyLinkedList2 *self, PyObject *indexobj)
+{
+  Py_ssize_t index = -1;
+
+  if (indexobj != NULL && indexobj != Py_None) {
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred())
+    return NULL;
+  }
+  return SinglyLinkedList2_item(self, index);
+}
+
+static PyObject * SinglyLinkedList2_prepend(SinglyLinkedList2 *self, PyObject *item);
+
+/* SinglyLinkedList2.insert(index, item) */
+static PyObject *
+SinglyLinkedList2_insert(SinglyLinkedList2 *self, PyObject *const *args,
+                         Py_ssize_t nargs)
+{
+  SinglyLinkedListNode *n, *tmp;
+  PyObject *indexobj = NULL, *itemobj = NULL;
+  Py_ssize_t index = -1;
+
+  if (!List_check_nargs("insert", nargs, 2)) {
+    return NULL;
+  }
+  indexobj = args[0];
+  itemobj = args[1];
+  if (indexobj != NULL && indexobj != Py_None) {
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred())
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+  PyErr_SetString(PyExc_IndexError, "SinglyLinkedList2 index out of range");
+  return NULL;
+  }
+  if (itemobj == NULL) {
+  PyErr_SetString(PyExc_ValueError, "item == NULL");
+  return NULL;
+  }
+
+  if (index == 0)
+  return SinglyLinkedList2_prepend(self, itemobj);
+  n = SinglyLinkedList2_node_at(self, index - 1);
+  tmp = SinglyLinkedListNode_alloc();
+  if (tmp == NULL) {
+    PyErr_NoMemory();
+    return NULL;
+  }
+  ++self->state;
+  self->finger_state = self->state;
+  ++self->size;
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_PEAK(self);
+  Py_INCREF(itemobj);
+  tmp->data = itemobj;
+  tmp->next = n->next;
+  n->next = tmp;
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList2.prepend(item) */
+static PyObject *
+SinglyLinkedList2_prepend(SinglyLinkedList2 *self, PyObject *item)
+{
+  SinglyLinkedListNode *n;
+
+  ++self->state;
+  n = SinglyLinkedListNode_alloc();
+  if (n == NULL) {
+      PyErr_NoMemory();
+      return NULL;
+  }
+  n->next = self->head;
+  Py_INCREF(item);
+  ++self->size;
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_PEAK(self);
+  n->data = item;
+  if (self->tail == NULL)
+    self->tail = n;
+  self->head = n;
+  Py_RETURN_NONE;
+}
+
+/* Removes and returns the item at index, which must be in range. */
+static PyObject *
+SinglyLinkedList2_remove_index(SinglyLinkedList2 *self, Py_ssize_t index)
+{
+  PyObject *item;
+  SinglyLinkedListNode *n, *remove;
+
+  if (index == 0) {
+    item = self->head->data;
+    --self->size;
+    ++self->state;
+    n = self->head;
+    self->head = self->head->next;
+    LISTSTATS_ADD(self, frees, 1);
+    if (self->size == 0) {
+      self->tail = NULL;
+    }
+    SinglyLinkedListNode_free(n);
+    return item;
+  }
+  if (index == self->size - 1) {
+    item = self->tail->data;
+    n = SinglyLinkedList2_node_at(self, self->size - 2);
+    LISTSTATS_ADD(self, frees, 1);
+    SinglyLinkedListNode_free(n->next);
+    --self->size;
+    ++self->state;
+    self->finger_state = self->state;
+    if (self->size == 0) {
+      self->head = self->tail = NULL;
+    } else {
+      self->tail = n;
+      self->tail->next = NULL;
+    }
+    return item;
+  }
+
+  n = SinglyLinkedList2_node_at(self, index - 1);
+  LISTSTATS_ADD(self, frees, 1);
+  remove = n->next;
+  item = remove->data;
+  n->next = remove->next;
+  SinglyLinkedListNode_free(remove);
+  --self->size;
+  ++self->state;
+  self->finger_state = self->state;
+  return item;
+}
+
+/* SinglyLinkedList2.remove(index) */
+static PyObject *
+SinglyLinkedList2_remove(SinglyLinkedList2 *self, PyObject *indexobj)
+{
+  Py_ssize_t index = -1;
+
+  if (indexobj != NULL && indexobj != Py_None) {
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred())
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+  PyErr_SetString(PyExc_IndexError, "SinglyLinkedList2 index out of range");
+  return NULL;
+  }
+  return SinglyLinkedList2_remove_index(self, index);
+}
+
+/* SinglyLinkedList2Type.tp_as_sequence->sq_ass_item
+ * Assigns item at index, or deletes the item at index if item is NULL. */
+static int
+SinglyLinkedList2_ass_item(SinglyLinkedList2 *self, Py_ssize_t index,
+                            PyObject *item)
+{
+  SinglyLinkedListNode *n;
+  PyObject *old_item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "SinglyLinkedList2 index out of range");
+    return -1;
+  }
+  if (item == NULL) {
+    old_item = SinglyLinkedList2_remove_index(self, index);
+    Py_DECREF(old_item);
+    return 0;
+  }
+
+  n = SinglyLinkedList2_node_at(self, index);
+  ++self->state;
+  self->finger_state = self->state;
+  old_item = n->data;
+  Py_INCREF(item);
+  n->data = item;
+  Py_DECREF(old_item);
+  return 0;
+}
+
+/* Moves the nodes of other into self before index, where 0 <= index <=
+ * self->size, and leaves other empty. */
+static void
+SinglyLinkedList2_splice_nodes(SinglyLinkedList2 *self,
+                               SinglyLinkedList2 *other, Py_ssize_t index)
+{
+  SinglyLinkedListNode *n;
+
+  if (other->head == NULL) {
+    return;
+  }
+  if (index == self->size) {
+    if (self->head == NULL) {
+      self->head = other->head;
+    }
+    else {
+      self->tail->next = other->head;
+    }
+    self->tail = other->tail;
+    /* Appending leaves every node up to a valid finger in place, but a
+     * finger that was already stale must stay so. */
+    if (self->finger_state == self->state) {
+      self->finger_state = self->state + 1;
+    }
+    ++self->state;
+  }
+  else if (index == 0) {
+    other->tail->next = self->head;
+    self->head = other->head;
+    ++self->state;
+  }
+  else {
+    n = SinglyLinkedList2_node_at(self, index - 1);
+    other->tail->next = n->next;
+    n->next = other->head;
+    ++self->state;
+    self->finger_state = self->state;
+  }
+  self->size += other->size;
+  LISTSTATS_PEAK(self);
+  other->head = NULL;
+  other->tail = NULL;
+  other->size = 0;
+  ++other->state;
+}
+
+/* Checks that other can be spliced into self. */
+static int
+SinglyLinkedList2_check_splice(SinglyLinkedList2 *self, PyObject *other)
+{
+  if (!PyObject_TypeCheck(other, &SinglyLinkedListType2)) {
+    PyErr_Format(PyExc_TypeError,
+                 "expected a SinglyLinkedList2, not %.200s",
+                 Py_TYPE(other)->tp_name);
+    return 0;
+  }
+  if (other == (PyObject *)self) {
+    PyErr_SetString(PyExc_ValueError,
+                    "cannot splice a SinglyLinkedList2 into itself");
+    return 0;
+  }
+  return 1;
+}
+
+PyDoc_STRVAR(SinglyLinkedList2_splice_doc,
+  "Moves the items of the given SinglyLinkedList2 into this one before the\n"
+  "given index, or onto the end if no index is given, leaving the other\n"
+  "empty.  Nodes are relinked rather than copied, so splicing at either end\n"
+  "takes constant time.");
+
+/* SinglyLinkedList2.splice(other[, index]) */
+static PyObject *
+SinglyLinkedList2_splice(SinglyLinkedList2 *self, PyObject *args)
+{
+  PyObject *other;
+  Py_ssize_t index = -1;
+
+  if (!PyArg_ParseTuple(args, "O|n:splice", &other, &index)) {
+    return NULL;
+  }
+  if (!SinglyLinkedList2_check_splice(self, other)) {
+    return NULL;
+  }
+  if (PyTuple_GET_SIZE(args) < 2) {
+    index = self->size;
+  }
+  else if (index < 0 || index > self->size) {
+    PyErr_SetString(PyExc_IndexError, "SinglyLinkedList2 index out of range");
+    return NULL;
+  }
+  SinglyLinkedList2_splice_nodes(self, (SinglyLinkedList2 *)other, index);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(SinglyLinkedList2_concat_doc,
+  "Moves the items of the given SinglyLinkedList2 onto the end of this one\n"
+  "in constant time, leaving the other empty.");
+
+/* SinglyLinkedList2.concat(other) */
+static PyObject *
+SinglyLinkedList2_concat(SinglyLinkedList2 *self, PyObject *other)
+{
+  if (!SinglyLinkedList2_check_splice(self, other)) {
+    return NULL;
+  }
+  SinglyLinkedList2_splice_nodes(self, (SinglyLinkedList2 *)other,
+                                 self->size);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(SinglyLinkedList2_split_at_doc,
+  "Removes the items from the given index onward from this SinglyLinkedList2\n"
+  "and returns them, without copying, as a new one.");
+
+/* SinglyLinkedList2.split_at(index)
+ * The new list is created before the split, since constructing a subclass
+ * can run arbitrary code. */
+static PyObject *
+SinglyLinkedList2_split_at(SinglyLinkedList2 *self, PyObject *indexobj)
+{
+  SinglyLinkedList2 *result;
+  SinglyLinkedListNode *n;
+  Py_ssize_t index;
+
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  result = (SinglyLinkedList2 *)PyObject_CallNoArgs((PyObject *)Py_TYPE(self));
+  if (result == NULL) {
+    return NULL;
+  }
+  if (index < 0 || index > self->size) {
+    Py_DECREF(result);
+    PyErr_SetString(PyExc_IndexError, "SinglyLinkedList2 index out of range");
+    return NULL;
+  }
+  if (index == self->size) {
+    return (PyObject *)result;
+  }
+  if (index == 0) {
+    SinglyLinkedList2_splice_nodes(result, self, 0);
+    return (PyObject *)result;
+  }
+  n = SinglyLinkedList2_node_at(self, index - 1);
+  result->head = n->next;
+  result->tail = self->tail;
+  result->size = self->size - index;
+  LISTSTATS_PEAK(result);
+  n->next = NULL;
+  self->tail = n;
+  self->size = index;
+  ++self->state;
+  self->finger_state = self->state;
+  return (PyObject *)result;
+}
+
+/* SinglyLinkedList2.reverse() */
+static PyObject *
+SinglyLinkedList2_reverse(SinglyLinkedList2 *self)
+{
+  self->tail = self->head;
+  self->head = SinglyLinkedListNode_reverse(self->head);
+  ++self->state;
+  Py_RETURN_NONE;
+}
+
+/* Implements remove_if() and retain() for SinglyLinkedList2. */
+static PyObject *
+SinglyLinkedList2_filter(SinglyLinkedList2 *self, PyObject *predicate, int remove_matches)
+{
+  Py_ssize_t count;
+  int result;
+
+  result = SinglyLinkedListNode_chain_filter(&self->head, &self->tail,
+                                             &self->size, &self->state,
+                                             predicate, remove_matches,
+                                             "SinglyLinkedList2", &count);
+  LISTSTATS_ADD(self, frees, count);
+  if (result < 0) {
+    return NULL;
+  }
+  return PyLong_FromSsize_t(count);
+}
+
+/* SinglyLinkedList2.remove_if(predicate) */
+static PyObject *
+SinglyLinkedList2_remove_if(SinglyLinkedList2 *self, PyObject *predicate)
+{
+  return SinglyLinkedList2_filter(self, predicate, 1);
+}
+
+/* SinglyLinkedList2.retain(predicate) */
+static PyObject *
+SinglyLinkedList2_retain(SinglyLinkedList2 *self, PyObject *predicate)
+{
+  return SinglyLinkedList2_filter(self, predicate, 0);
+}
+
+/* SinglyLinkedList2.set(index, item) */
+static PyObject *
+SinglyLinkedList2_set(SinglyLinkedList2 *self, PyObject *const *args,
+                      Py_ssize_t nargs)
+{
+  PyObject *indexobj = NULL, *itemobj = NULL;
+  Py_ssize_t index = -1;
+
+  if (!List_check_nargs("set", nargs, 2)) {
+    return NULL;
+  }
+  indexobj = args[0];
+  itemobj = args[1];
+  if (indexobj != NULL && indexobj != Py_None) {
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred())
+    return NULL;
+  }
+  if (itemobj == NULL) {
+    PyErr_SetString(PyExc_ValueError, "item == NULL");
+    return NULL;
+  }
+  if (SinglyLinkedList2_ass_item(self, index, itemobj) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList2.sort(*, key=None, reverse=False) */
+static PyObject *
+SinglyLinkedList2_sort(SinglyLinkedList2 *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *keyfunc;
+  int reverse, result;
+
+  if (!ListSort_parse_args(args, kwds, &keyfunc, &reverse)) {
+    return NULL;
+  }
+  result = SinglyLinkedListNode_sort_list(&self->head, &self->tail,
+                                          &self->size, &self->state, keyfunc,
+                                          reverse, "SinglyLinkedList2");
+  if (result < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* SinglyLinkedList2.index_of(item[, start[, stop]]) */
+static PyObject *
+SinglyLinkedList2_index_of(SinglyLinkedList2 *self, PyObject *args)
+{
+  PyObject *item;
+  Py_ssize_t start, stop, index;
+
+  if (!List_parse_index_of_args(args, self->size, &item, &start, &stop)) {
+    return NULL;
+  }
+  if (SinglyLinkedListNode_chain_search(self->head, item, start, stop, 0,
+                                        &self->state, "SinglyLinkedList2",
+                                        &index) < 0) {
+    return NULL;
+  }
+  if (index < 0) {
+    PyErr_Format(PyExc_ValueError, "%R is not in SinglyLinkedList2", item);
+    return NULL;
+  }
+  return PyLong_FromSsize_t(index);
+}
+
+static int SinglyLinkedList2_contains(SinglyLinkedList2 *self, PyObject *item);
+
+/* SinglyLinkedList2.contains(item) */
+static PyObject *
+SinglyLinkedList2_contains_method(SinglyLinkedList2 *self, PyObject *item)
+{
+  int cmp;
+
+  cmp = SinglyLinkedList2_contains(self, item);
+  if (cmp < 0) {
+    return NULL;
+  }
+  return PyBool_FromLong(cmp);
+}
+
+/* SinglyLinkedList2.count(item) */
+static PyObject *
+SinglyLinkedList2_count(SinglyLinkedList2 *self, PyObject *item)
+{
+  Py_ssize_t count;
+
+  if (SinglyLinkedListNode_chain_search(self->head, item, 0, self->size, 1,
+                                        &self->state, "SinglyLinkedList2",
+                                        &count) < 0) {
+    return NULL;
+  }
+  return PyLong_FromSsize_t(count);
+}
+
+/* SinglyLinkedList2.size() */
+static PyObject *
+SinglyLinkedList2_size(SinglyLinkedList2 *self)
+{
+  return PyLong_FromSsize_t(self->size);
+}
+
+#if EDUCOLLECTIONS_STATS
+/* SinglyLinkedList2.stats() */
+static PyObject *
+SinglyLinkedList2_stats(SinglyLinkedList2 *self)
+{
+  return ListStats_dict(&self->stats);
+}
+
+/* SinglyLinkedList2.reset_stats() */
+static PyObject *
+SinglyLinkedList2_reset_stats(SinglyLinkedList2 *self)
+{
+  ListStats_reset(&self->stats, self->size);
+  Py_RETURN_NONE;
+}
+#endif
+
+/* SinglyLinkedList2Type.tp_iter */
+static PyObject *
+SinglyLinkedList2_iter(SinglyLinkedList2 *self)
+{
+  return SinglyLinkedListIterator_new((PyObject *)self, self->head,
+                                      &self->state);
+}
+
+/* SinglyLinkedList2Type.tp_as_sequence->sq_length */
+static Py_ssize_t
+SinglyLinkedList2_length(SinglyLinkedList2 *self)
+{
+  return self->size;
+}
+
+/* SinglyLinkedList2Type.tp_as_sequence->sq_contains */
+static int
+SinglyLinkedList2_contains(SinglyLinkedList2 *self, PyObject *item)
+{
+  Py_ssize_t index;
+
+  if (SinglyLinkedListNode_chain_search(self->head, item, 0, self->size, 0,
+                                        &self->state, "SinglyLinkedList2",
+                                        &index) < 0) {
+    return -1;
+  }
+  return index >= 0;
+}
+
+/* SinglyLinkedList2Type.tp_as_mapping->mp_subscript */
+static PyObject *
+SinglyLinkedList2_subscript(SinglyLinkedList2 *self, PyObject *key)
+{
+  SinglyLinkedList2 *result;
+  SinglyLinkedListNode *head, *tail;
+  Py_ssize_t index, start, stop, step, slicelength;
+
+  if (PyIndex_Check(key)) {
+    index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+    if (index < 0) {
+      index += self->size;
+    }
+    return SinglyLinkedList2_item(self, index);
+  }
+  if (!PySlice_Check(key)) {
+    PyErr_Format(PyExc_TypeError,
+                 "SinglyLinkedList2 indices must be integers or slices, not %.200s",
+                 Py_TYPE(key)->tp_name);
+    return NULL;
+  }
+  if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+    return NULL;
+  }
+  slicelength = PySlice_AdjustIndices(self->size, &start, &stop, step);
+  result = (SinglyLinkedList2 *)PyObject_CallNoArgs((PyObject *)Py_TYPE(self));
+  if (result == NULL) {
+    return NULL;
+  }
+  if (SinglyLinkedListNode_chain_slice(self->head, start, step, slicelength,
+                                       &head, &tail) < 0) {
+    Py_DECREF(result);
+    return NULL;
+  }
+  result->head = head;
+  result->tail = tail;
+  result->size = slicelength > 0 ? slicelength : 0;
+  LISTSTATS_ADD(result, allocs, result->size);
+  LISTSTATS_PEAK(result);
+  return (PyObject *)result;
+}
+
+/* SinglyLinkedList2Type.tp_as_sequence->sq_inplace_concat */
+static PyObject *
+SinglyLinkedList2_inplace_concat(SinglyLinkedList2 *self, PyObject *other)
+{
+  PyObject *result;
+
+  result = SinglyLinkedList2_extend(self, other);
+  if (result == NULL) {
+    return NULL;
+  }
+  Py_DECREF(result);
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
+
+/* SinglyLinkedList2Type.tp_repr */
+static PyObject *
+SinglyLinkedList2_repr(PyObject *self)
+{
+  /* PyObject *aslist, *result; */
+  /* int i; */
+
+  /* i = Py_ReprEnter(self); */
+  /* if (i != 0) { */
+  /*     if (i < 0) */
+  /*         return NULL; */
+  /*     return PyUnicode_FromString("[...]"); */
+  /* } */
+
+  /* aslist = PySequence_List(self); */
+  /* if (aslist == NULL) { */
+  /*     Py_ReprLeave(self); */
+  /*     return NULL; */
+  /* } */
+  /* result = PyUnicode_FromFormat("%R", aslist); */
+  /* Py_DECREF(aslist); */
+  /* Py_ReprLeave(self); */
+  /* return result; */
+  return PyUnicode_FromString("[...]");
+}
+
+/* SinglyLinkedList2Type.tp_str */
+static PyObject *
+SinglyLinkedList2_str(PyObject *self)
+{
+  /* PyObject *aslist, *result; */
+  /* int i; */
+
+  /* i = Py_ReprEnter(self); */
+  /* if (i != 0) { */
+  /*     if (i < 0) */
+  /*         return NULL; */
+  /*     return PyUnicode_FromString("[...]"); */
+  /* } */
+
+  /* aslist = PySequence_List(self); */
+  /* if (aslist == NULL) { */
+  /*     Py_ReprLeave(self); */
+  /*     return NULL; */
+  /* } */
+  /* result = PyUnicode_FromFormat("%R", aslist); */
+  /* Py_DECREF(aslist); */
+  /* Py_ReprLeave(self); */
+  /* return result; */
+  return PyUnicode_FromString("[...]");
+}
+
+static PyMethodDef SinglyLinkedList2_methods[] = {
+  {"append",                  (PyCFunction)SinglyLinkedList2_append,
+      METH_O,                  List_append_doc},
+  {"clear",                   (PyCFunction)SinglyLinkedList2_clear,
+      METH_NOARGS,             List_clear_doc},
+  {"concat",                  (PyCFunction)SinglyLinkedList2_concat,
+      METH_O,                  SinglyLinkedList2_concat_doc},
+  {"contains",                (PyCFunction)SinglyLinkedList2_contains_method,
+      METH_O,                  List_contains_doc},
+  {"count",                   (PyCFunction)SinglyLinkedList2_count,
+      METH_O,                  List_count_doc},
+  {"extend",                  (PyCFunction)SinglyLinkedList2_extend,
+      METH_O,                  List_extend_doc},
+  {"from_iterable",           (PyCFunction)SinglyLinkedList2_from_iterable,
+      METH_O | METH_CLASS,     List_from_iterable_doc},
+  {"get",                     (PyCFunction)SinglyLinkedList2_get,
+      METH_O,                  List_get_doc},
+  {"index_of",                (PyCFunction)SinglyLinkedList2_index_of,
+      METH_VARARGS,            List_index_of_doc},
+  {"insert",                  (PyCFunction)SinglyLinkedList2_insert,
+      METH_FASTCALL,           List_insert_doc},
+  {"prepend",                 (PyCFunction)SinglyLinkedList2_prepend,
+      METH_O,                  List_prepend_doc},
+  {"remove",                  (PyCFunction)SinglyLinkedList2_remove,
+      METH_O,                  List_remove_doc},
+  {"remove_if",               (PyCFunction)SinglyLinkedList2_remove_if,
+      METH_O,                  List_remove_if_doc},
+#if EDUCOLLECTIONS_STATS
+  {"reset_stats",             (PyCFunction)SinglyLinkedList2_reset_stats,
+      METH_NOARGS,             List_reset_stats_doc},
+#endif
+  {"retain",                  (PyCFunction)SinglyLinkedList2_retain,
+      METH_O,                  List_retain_doc},
+  {"reverse",                 (PyCFunction)SinglyLinkedList2_reverse,
+      METH_NOARGS,             List_reverse_doc},
+  {"set",                     (PyCFunction)SinglyLinkedList2_set,
+      METH_FASTCALL,           List_set_doc},
+  {"size",                    (PyCFunction)SinglyLinkedList2_size,
+      METH_NOARGS,             List_size_doc},
+  {"sort",                    (PyCFunction)SinglyLinkedList2_sort,
+      METH_VARARGS | METH_KEYWORDS,
+                               List_sort_doc},
+  {"splice",                  (PyCFunction)SinglyLinkedList2_splice,
+      METH_VARARGS,            SinglyLinkedList2_splice_doc},
+  {"split_at",                (PyCFunction)SinglyLinkedList2_split_at,
+      METH_O,                  SinglyLinkedList2_split_at_doc},
+#if EDUCOLLECTIONS_STATS
+  {"stats",                   (PyCFunction)SinglyLinkedList2_stats,
+      METH_NOARGS,             List_stats_doc},
+#endif
+  {NULL,                      NULL}
+};
+
+static PySequenceMethods SinglyLinkedList2_as_sequence = {
+  (lenfunc)SinglyLinkedList2_length,    /* sq_length */
+  0,                                    /* sq_concat */
+  0,                                    /* sq_repeat */
+  (ssizeargfunc)SinglyLinkedList2_item, /* sq_item */
+  0,                                    /* was_sq_slice */
+  (ssizeobjargproc)SinglyLinkedList2_ass_item,
+                                        /* sq_ass_item */
+  0,                                    /* was_sq_ass_slice */
+  (objobjproc)SinglyLinkedList2_contains,
+                                        /* sq_contains */
+  (binaryfunc)SinglyLinkedList2_inplace_concat,
+                                        /* sq_inplace_concat */
+  0,                                    /* sq_inplace_repeat */
+};
+
+static PyMappingMethods SinglyLinkedList2_as_mapping = {
+  (lenfunc)SinglyLinkedList2_length,    /* mp_length */
+  (binaryfunc)SinglyLinkedList2_subscript,
+                                        /* mp_subscript */
+  0,                                    /* mp_ass_subscript */
+};
+
+PyTypeObject SinglyLinkedListType2 = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.SinglyLinkedList2",  /* tp_name */
+  sizeof(SinglyLinkedList2),            /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)SinglyLinkedList2_dealloc,/* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  SinglyLinkedList2_repr,               /* tp_repr */
+  0,                                    /* tp_as_number */
+  &SinglyLinkedList2_as_sequence,       /* tp_as_sequence */
+  &SinglyLinkedList2_as_mapping,        /* tp_as_mapping */
+  PyObject_HashNotImplemented,          /* tp_hash  */
+  0,                                    /* tp_call */
+  SinglyLinkedList2_str,                /* tp_str */
+  0,                                    /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_BASETYPE |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  SinglyLinkedList2_doc,                /* tp_doc */
+  (traverseproc)SinglyLinkedList2_traverse,
+                                        /* tp_traverse */
+  (inquiry)SinglyLinkedList2_tp_clear,  /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  (getiterfunc)SinglyLinkedList2_iter,  /* tp_iter */
+  0,                                    /* tp_iternext */
+  SinglyLinkedList2_methods,            /* tp_methods */
+  0,                                    /* tp_members */
+  0,                                    /* tp_getset */
+  0,                                    /* tp_base */
+  0,                                    /* tp_dict */
+  0,                                    /* tp_descr_get */
+  0,                                    /* tp_descr_set */
+  0,                                    /* tp_dictoffset */
+  (initproc)SinglyLinkedList2_init,     /* tp_init */
+  PyType_GenericAlloc,                  /* tp_alloc */
+  SinglyLinkedList2_new,                /* tp_new */
+  PyObject_GC_Del,                      /* tp_free */
+  0,                                    /* tp_is_gc */
+  0,                                    /* tp_bases */
+  0,                                    /* tp_mro */
+  0,                                    /* tp_cache */
+  0,                                    /* tp_subclasses */
+  0,                                    /* tp_weaklist */
+  0,                                    /* tp_del */
+  0,                                    /* tp_version_tag */
+  0,                                    /* tp_finalize */
+  SinglyLinkedList2_vectorcall,         /* tp_vectorcall */
+};
+
+
+/* DoublyLinkedListNode */
+typedef struct DoublyLinkedListNodeType {
+  PyObject *data;
+  struct DoublyLinkedListNodeType *prev;
+  struct DoublyLinkedListNodeType *next;
+} DoublyLinkedListNode;
+
+static NodePool DoublyLinkedListNode_pool = NODEPOOL_INIT(DoublyLinkedListNode);
+
+#define DoublyLinkedListNode_alloc() \
+  ((DoublyLinkedListNode *)NodePool_alloc(&DoublyLinkedListNode_pool))
+#define DoublyLinkedListNode_free(n) \
+  NodePool_free(&DoublyLinkedListNode_pool, (n))
+
+/* Frees the chain of nodes starting at n and releases their items. */
+static void
+DoublyLinkedListNode_free_chain(DoublyLinkedListNode *n)
+{
+  DoublyLinkedListNode *tmp;
+
+  while (n) {
+    Py_XDECREF(n->data);
+    tmp = n;
+    n = n->next;
+    DoublyLinkedListNode_free(tmp);
+  }
+}
+
+
+/* DoublyLinkedList
+ * Resizable doubly-linked-node-based implementation of the List interface.
+ * Nodes link both ways and the list keeps head and tail pointers, so either
+ * end is reached, grown or shrunk in O(1) and positional operations walk
+ * from whichever end is nearer to the index. */
+typedef struct {
+  PyObject_HEAD
+  DoublyLinkedListNode *head;
+  DoublyLinkedListNode *tail;
+  Py_ssize_t size;
+  long state;
+#if EDUCOLLECTIONS_STATS
+  ListStats stats;
+#endif
+} DoublyLinkedList;
+
+PyDoc_STRVAR(DoublyLinkedList_doc,
+  "Resizable doubly-linked-node-based implementation of the List interface.\n"
+  "Works at either end in constant time and walks from the nearer end to\n"
+  "reach an index.");
+
+/* DoublyLinkedListType.tp_new */
+static PyObject *
+DoublyLinkedList_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  DoublyLinkedList *self;
+
+  self = (DoublyLinkedList *)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+  self->head = NULL;
+  self->tail = NULL;
+  self->size = 0;
+  self->state = 0;
+  return (PyObject *)self;
+}
+
+/* Returns the node at index, which must be in range, walking from the head
+ * for the first half of the list and from the tail for the second, so no
+ * walk is longer than size / 2 links. */
+static DoublyLinkedListNode *
+DoublyLinkedList_node_at(DoublyLinkedList *self, Py_ssize_t index)
+{
+  DoublyLinkedListNode *n;
+  Py_ssize_t i;
+
+  if (index < self->size / 2) {
+    n = self->head;
+    for (i = 0; i < index; ++i) {
+      n = n->next;
+    }
+    LISTSTATS_ADD(self, walked, index);
+  }
+  else {
+    n = self->tail;
+    for (i = self->size - 1; i > index; --i) {
+      n = n->prev;
+    }
+    LISTSTATS_ADD(self, walked, self->size - 1 - index);
+  }
+  return n;
+}
+
+/* Links a new node holding item in front of next, or at the tail if next is
+ * NULL. */
+static int
+DoublyLinkedList_link_before(DoublyLinkedList *self, DoublyLinkedListNode *next,
+                             PyObject *item)
+{
+  DoublyLinkedListNode *n;
+
+  n = DoublyLinkedListNode_alloc();
+  if (n == NULL) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  Py_INCREF(item);
+  n->data = item;
+  n->next = next;
+  n->prev = next != NULL ? next->prev : self->tail;
+  if (n->prev != NULL) {
+    n->prev->next = n;
+  }
+  else {
+    self->head = n;
+  }
+  if (next != NULL) {
+    next->prev = n;
+  }
+  else {
+    self->tail = n;
+  }
+  ++self->size;
+  ++self->state;
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_PEAK(self);
+  return 0;
+}
+
+/* Unlinks and frees n, returning its item. */
+static PyObject *
+DoublyLinkedList_unlink(DoublyLinkedList *self, DoublyLinkedListNode *n)
+{
+  PyObject *item;
+
+  if (n->prev != NULL) {
+    n->prev->next = n->next;
+  }
+  else {
+    self->head = n->next;
+  }
+  if (n->next != NULL) {
+    n->next->prev = n->prev;
+  }
+  else {
+    self->tail = n->prev;
+  }
+  item = n->data;
+  DoublyLinkedListNode_free(n);
+  --self->size;
+  ++self->state;
+  LISTSTATS_ADD(self, frees, 1);
+  return item;
+}
+
+/* DoublyLinkedListType.tp_init */
+static int
+DoublyLinkedList_init(DoublyLinkedList *self, PyObject *args, PyObject *kwds)
+{
+  return 0;
+}
+
+/* DoublyLinkedListType.tp_vectorcall
+ * The constructor takes no arguments, so the common call allocates the list
+ * directly. */
+static PyObject *
+DoublyLinkedList_vectorcall(PyObject *type, PyObject *const *args,
+                            size_t nargsf, PyObject *kwnames)
+{
+  if (type != (PyObject *)&DoublyLinkedListType ||
+      PyVectorcall_NARGS(nargsf) != 0 ||
+      (kwnames != NULL && PyTuple_GET_SIZE(kwnames) != 0)) {
+    return List_vectorcall_fallback(type, args, nargsf, kwnames);
+  }
+  return DoublyLinkedList_new((PyTypeObject *)type, NULL, NULL);
+}
+
+/* DoublyLinkedListType.tp_traverse */
+static int
+DoublyLinkedList_traverse(DoublyLinkedList *self, visitproc visit, void *arg)
+{
+  DoublyLinkedListNode *n;
+
+  for (n = self->head; n; n = n->next) {
+    Py_VISIT(n->data);
+  }
+  return 0;
+}
+
+/* DoublyLinkedListType.tp_clear
+ * Detaches the chain before releasing its items, which can run arbitrary
+ * code. */
+static int
+DoublyLinkedList_tp_clear(DoublyLinkedList *self)
+{
+  DoublyLinkedListNode *n;
+
+  n = self->head;
+  self->head = NULL;
+  self->tail = NULL;
+  LISTSTATS_ADD(self, frees, self->size);
+  self->size = 0;
+  ++self->state;
+  DoublyLinkedListNode_free_chain(n);
+  return 0;
+}
+
+/* DoublyLinkedListType.tp_dealloc */
+static void
+DoublyLinkedList_dealloc(DoublyLinkedList *self)
+{
+  PyObject_GC_UnTrack(self);
+  DoublyLinkedListNode_free_chain(self->head);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* DoublyLinkedList.append(item) */
+static PyObject *
+DoublyLinkedList_append(DoublyLinkedList *self, PyObject *item)
+{
+  if (DoublyLinkedList_link_before(self, NULL, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* DoublyLinkedList.clear() */
+static PyObject *
+DoublyLinkedList_clear(DoublyLinkedList *self)
+{
+  DoublyLinkedList_tp_clear(self);
+  Py_RETURN_NONE;
+}
+
+/* DoublyLinkedList.extend(iterable)
+ * The new nodes are built as a separate chain and linked in at the end, so
+ * a failure part way through leaves the list untouched. */
+static PyObject *
+DoublyLinkedList_extend(DoublyLinkedList *self, PyObject *iterable)
+{
+  DoublyLinkedListNode *head = NULL, *tail = NULL, *n;
+  PyObject *seq, **items;
+  Py_ssize_t size, i;
+
+  seq = PySequence_Fast(iterable, "LinkedList argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  size = PySequence_Fast_GET_SIZE(seq);
+  items = PySequence_Fast_ITEMS(seq);
+  for (i = 0; i < size; ++i) {
+    n = DoublyLinkedListNode_alloc();
+    if (n == NULL) {
+      Py_DECREF(seq);
+      DoublyLinkedListNode_free_chain(head);
+      return PyErr_NoMemory();
+    }
+    Py_INCREF(items[i]);
+    n->data = items[i];
+    n->prev = tail;
+    n->next = NULL;
+    if (head == NULL) {
+      head = n;
+    }
+    else {
+      tail->next = n;
+    }
+    tail = n;
+  }
+  Py_DECREF(seq);
+  if (size > 0) {
+    head->prev = self->tail;
+    if (self->tail == NULL) {
+      self->head = head;
+    }
+    else {
+      self->tail->next = head;
+    }
+    self->tail = tail;
+    self->size += size;
+    ++self->state;
+    LISTSTATS_ADD(self, allocs, size);
+    LISTSTATS_PEAK(self);
+  }
+  Py_RETURN_NONE;
+}
+
+/* DoublyLinkedList.from_iterable(iterable) */
+static PyObject *
+DoublyLinkedList_from_iterable(PyTypeObject *type, PyObject *iterable)
+{
+  PyObject *self, *result;
+
+  self = PyObject_CallNoArgs((PyObject *)type);
+  if (self == NULL) {
+    return NULL;
+  }
+  result = DoublyLinkedList_extend((DoublyLinkedList *)self, iterable);
+  if (result == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  Py_DECREF(result);
+  return self;
+}
+
+/* DoublyLinkedListType.tp_as_sequence->sq_item */
+static PyObject *
+DoublyLinkedList_item(DoublyLinkedList *self, Py_ssize_t index)
+{
+  PyObject *item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "DoublyLinkedList index out of range");
+    return NULL;
+  }
+  item = DoublyLinkedList_node_at(self, index)->data;
+  Py_INCREF(item);
+  return item;
+}
+
+/* DoublyLinkedList.get(index) */
+static PyObject *
+DoublyLinkedList_get(DoublyLinkedList *self, PyObject *indexobj)
+{
+  Py_ssize_t index;
+
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  return DoublyLinkedList_item(self, index);
+}
+
+/* DoublyLinkedList.insert(index, item) */
+static PyObject *
+DoublyLinkedList_insert(DoublyLinkedList *self, PyObject *const *args,
+                        Py_ssize_t nargs)
+{
+  Py_ssize_t index;
+
+  if (!List_check_nargs("insert", nargs, 2)) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "DoublyLinkedList index out of range");
+    return NULL;
+  }
+  if (DoublyLinkedList_link_before(self, DoublyLinkedList_node_at(self, index),
+                                   args[1]) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* DoublyLinkedList.prepend(item) */
+static PyObject *
+DoublyLinkedList_prepend(DoublyLinkedList *self, PyObject *item)
+{
+  if (DoublyLinkedList_link_before(self, self->head, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* DoublyLinkedList.remove(index) */
+static PyObject *
+DoublyLinkedList_remove(DoublyLinkedList *self, PyObject *indexobj)
+{
+  Py_ssize_t index;
+
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "DoublyLinkedList index out of range");
+    return NULL;
+  }
+  return DoublyLinkedList_unlink(self, DoublyLinkedList_node_at(self, index));
+}
+
+/* DoublyLinkedListType.tp_as_sequence->sq_ass_item
+ * Assigns item at index, or deletes the item at index if item is NULL. */
+static int
+DoublyLinkedList_ass_item(DoublyLinkedList *self, Py_ssize_t index,
+                          PyObject *item)
+{
+  DoublyLinkedListNode *n;
+  PyObject *old_item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "DoublyLinkedList index out of range");
+    return -1;
+  }
+  n = DoublyLinkedList_node_at(self, index);
+  if (item == NULL) {
+    old_item = DoublyLinkedList_unlink(self, n);
+    Py_DECREF(old_item);
+    return 0;
+  }
+  ++self->state;
+  old_item = n->data;
+  Py_INCREF(item);
+  n->data = item;
+  Py_DECREF(old_item);
+  return 0;
+}
+
+/* DoublyLinkedList.set(index, item) */
+static PyObject *
+DoublyLinkedList_set(DoublyLinkedList *self, PyObject *const *args,
+                     Py_ssize_t nargs)
+{
+  Py_ssize_t index;
+
+  if (!List_check_nargs("set", nargs, 2)) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (DoublyLinkedList_ass_item(self, index, args[1]) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* DoublyLinkedList.size() */
+static PyObject *
+DoublyLinkedList_size(DoublyLinkedList *self)
+{
+  return PyLong_FromSsize_t(self->size);
+}
+
+#if EDUCOLLECTIONS_STATS
+/* DoublyLinkedList.stats() */
+static PyObject *
+DoublyLinkedList_stats(DoublyLinkedList *self)
+{
+  return ListStats_dict(&self->stats);
+}
+
+/* DoublyLinkedList.reset_stats() */
+static PyObject *
+DoublyLinkedList_reset_stats(DoublyLinkedList *self)
+{
+  ListStats_reset(&self->stats, self->size);
+  Py_RETURN_NONE;
+}
+#endif
+
+/* DoublyLinkedListType.tp_as_sequence->sq_length */
+static Py_ssize_t
+DoublyLinkedList_length(DoublyLinkedList *self)
+{
+  return self->size;
+}
+
+/* DoublyLinkedListType.tp_as_sequence->sq_contains
+ * A comparison that mutates this DoublyLinkedList may free the node being
+ * visited, so that raises RuntimeError. */
+static int
+DoublyLinkedList_contains(DoublyLinkedList *self, PyObject *item)
+{
+  DoublyLinkedListNode *n;
+  long state = self->state;
+  int cmp = 0;
+
+  for (n = self->head; cmp == 0 && n; n = n->next) {
+    cmp = List_item_eq(n->data, item);
+    if (cmp >= 0 && self->state != state) {
+      PyErr_SetString(PyExc_RuntimeError,
+                      "DoublyLinkedList mutated during search");
+      return -1;
+    }
+  }
+  return cmp;
+}
+
+/* DoublyLinkedListType.tp_as_mapping->mp_subscript
+ * A slice is copied in one walk from its first item, following prev links
+ * for a negative step. */
+static PyObject *
+DoublyLinkedList_subscript(DoublyLinkedList *self, PyObject *key)
+{
+  DoublyLinkedList *result;
+  DoublyLinkedListNode *n;
+  Py_ssize_t index, start, stop, step, slicelength, i, j;
+
+  if (PyIndex_Check(key)) {
+    index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+    if (index < 0) {
+      index += self->size;
+    }
+    return DoublyLinkedList_item(self, index);
+  }
+  if (!PySlice_Check(key)) {
+    PyErr_Format(PyExc_TypeError,
+                 "DoublyLinkedList indices must be integers or slices, "
+                 "not %.200s", Py_TYPE(key)->tp_name);
+    return NULL;
+  }
+  if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+    return NULL;
+  }
+  slicelength = PySlice_AdjustIndices(self->size, &start, &stop, step);
+  result = (DoublyLinkedList *)PyObject_CallNoArgs((PyObject *)Py_TYPE(self));
+  if (result == NULL) {
+    return NULL;
+  }
+  if (slicelength <= 0) {
+    return (PyObject *)result;
+  }
+  n = DoublyLinkedList_node_at(self, start);
+  for (i = 0; i < slicelength; ++i) {
+    if (DoublyLinkedList_link_before(result, NULL, n->data) < 0) {
+      Py_DECREF(result);
+      return NULL;
+    }
+    for (j = 0; n != NULL && j < (step > 0 ? step : -step); ++j) {
+      n = step > 0 ? n->next : n->prev;
+    }
+  }
+  return (PyObject *)result;
+}
+
+/* DoublyLinkedListType.tp_as_sequence->sq_inplace_concat */
+static PyObject *
+DoublyLinkedList_inplace_concat(DoublyLinkedList *self, PyObject *other)
+{
+  PyObject *result;
+
+  result = DoublyLinkedList_extend(self, other);
+  if (result == NULL) {
+    return NULL;
+  }
+  Py_DECREF(result);
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
+
+/* DoublyLinkedListIterator
+ * Iterates over a DoublyLinkedList from head to tail, raising if the list
+ * is mutated before iteration ends. */
+typedef struct {
+  PyObject_HEAD
+  DoublyLinkedList     *list;
+  DoublyLinkedListNode *node;
+  long                 state;
+} DoublyLinkedListIterator;
+
+/* DoublyLinkedListType.tp_iter */
+static PyObject *
+DoublyLinkedList_iter(DoublyLinkedList *self)
+{
+  DoublyLinkedListIterator *it;
+
+  it = PyObject_GC_New(DoublyLinkedListIterator,
+                       &DoublyLinkedListIteratorType);
+  if (it == NULL) {
+    return NULL;
+  }
+  Py_INCREF(self);
+  it->list = self;
+  it->node = self->head;
+  it->state = self->state;
+  PyObject_GC_Track(it);
+  return (PyObject *)it;
+}
+
+/* DoublyLinkedListIteratorType.tp_dealloc */
+static void
+DoublyLinkedListIterator_dealloc(DoublyLinkedListIterator *self)
+{
+  PyObject_GC_UnTrack(self);
+  Py_XDECREF(self->list);
+  PyObject_GC_Del(self);
+}
+
+/* DoublyLinkedListIteratorType.tp_traverse */
+static int
+DoublyLinkedListIterator_traverse(DoublyLinkedListIterator *self,
+                                  visitproc visit, void *arg)
+{
+  Py_VISIT(self->list);
+  return 0;
+}
+
+/* DoublyLinkedListIteratorType.tp_clear
+ * The cursor points into the list, so it is dropped with it. */
+static int
+DoublyLinkedListIterator_clear(DoublyLinkedListIterator *self)
+{
+  self->node = NULL;
+  Py_CLEAR(self->list);
+  return 0;
+}
+
+/* DoublyLinkedListIteratorType.tp_iternext */
+static PyObject *
+DoublyLinkedListIterator_next(DoublyLinkedListIterator *self)
+{
+  PyObject *item;
+
+  if (self->list == NULL) {
+    return NULL;
+  }
+  if (self->list->state != self->state) {
+    PyErr_SetString(PyExc_RuntimeError, "LinkedList mutated during iteration");
+    self->node = NULL;
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  if (self->node == NULL) {
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  item = self->node->data;
+  self->node = self->node->next;
+  Py_INCREF(item);
+  return item;
+}
+
+PyTypeObject DoublyLinkedListIteratorType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.DoublyLinkedListIterator",
+                                        /* tp_name */
+  sizeof(DoublyLinkedListIterator),     /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)DoublyLinkedListIterator_dealloc,
+                                        /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  0,                                    /* tp_repr */
+  0,                                    /* tp_as_number */
+  0,                                    /* tp_as_sequence */
+  0,                                    /* tp_as_mapping */
+  0,                                    /* tp_hash  */
+  0,                                    /* tp_call */
+  0,                                    /* tp_str */
+  PyObject_GenericGetAttr,              /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  0,                                    /* tp_doc */
+  (traverseproc)DoublyLinkedListIterator_traverse,
+                                        /* tp_traverse */
+  (inquiry)DoublyLinkedListIterator_clear,
+                                        /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  PyObject_SelfIter,                    /* tp_iter */
+  (iternextfunc)DoublyLinkedListIterator_next,
+                                        /* tp_iternext */
+};
+
+/* DoublyLinkedListType.tp_repr */
+static PyObject *
+DoublyLinkedList_repr(PyObject *self)
+{
+  return PyUnicode_FromString("[...]");
+}
+
+/* DoublyLinkedListType.tp_str */
+static PyObject *
+DoublyLinkedList_str(PyObject *self)
+{
+  return PyUnicode_FromString("[...]");
+}
+
+static PyMethodDef DoublyLinkedList_methods[] = {
+  {"append",                  (PyCFunction)DoublyLinkedList_append,
+      METH_O,                  List_append_doc},
+  {"clear",                   (PyCFunction)DoublyLinkedList_clear,
+      METH_NOARGS,             List_clear_doc},
+  {"extend",                  (PyCFunction)DoublyLinkedList_extend,
+      METH_O,                  List_extend_doc},
+  {"from_iterable",           (PyCFunction)DoublyLinkedList_from_iterable,
+      METH_O | METH_CLASS,     List_from_iterable_doc},
+  {"get",                     (PyCFunction)DoublyLinkedList_get,
+      METH_O,                  List_get_doc},
+  {"insert",                  (PyCFunction)DoublyLinkedList_insert,
+      METH_FASTCALL,           List_insert_doc},
+  {"prepend",                 (PyCFunction)DoublyLinkedList_prepend,
+      METH_O,                  List_prepend_doc},
+  {"remove",                  (PyCFunction)DoublyLinkedList_remove,
+      METH_O,                  List_remove_doc},
+#if EDUCOLLECTIONS_STATS
+  {"reset_stats",             (PyCFunction)DoublyLinkedList_reset_stats,
+      METH_NOARGS,             List_reset_stats_doc},
+#endif
+  {"set",                     (PyCFunction)DoublyLinkedList_set,
+      METH_FASTCALL,           List_set_doc},
+  {"size",                    (PyCFunction)DoublyLinkedList_size,
+      METH_NOARGS,             List_size_doc},
+#if EDUCOLLECTIONS_STATS
+  {"stats",                   (PyCFunction)DoublyLinkedList_stats,
+      METH_NOARGS,             List_stats_doc},
+#endif
+  {NULL,                      NULL}
+};
+
+static PySequenceMethods DoublyLinkedList_as_sequence = {
+  (lenfunc)DoublyLinkedList_length,     /* sq_length */
+  0,                                    /* sq_concat */
+  0,                                    /* sq_repeat */
+  (ssizeargfunc)DoublyLinkedList_item,  /* sq_item */
+  0,                                    /* was_sq_slice */
+  (ssizeobjargproc)DoublyLinkedList_ass_item,
+                                        /* sq_ass_item */
+  0,                                    /* was_sq_ass_slice */
+  (objobjproc)DoublyLinkedList_contains,
+                                        /* sq_contains */
+  (binaryfunc)DoublyLinkedList_inplace_concat,
+                                        /* sq_inplace_concat */
+  0,                                    /* sq_inplace_repeat */
+};
+
+static PyMappingMethods DoublyLinkedList_as_mapping = {
+  (lenfunc)DoublyLinkedList_length,     /* mp_length */
+  (binaryfunc)DoublyLinkedList_subscript,
+                                        /* mp_subscript */
+  0,                                    /* mp_ass_subscript */
+};
+
+PyTypeObject DoublyLinkedListType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.DoublyLinkedList",   /* tp_name */
+  sizeof(DoublyLinkedList),             /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)DoublyLinkedList_dealloc, /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  DoublyLinkedList_repr,                /* tp_repr */
+  0,                                    /* tp_as_number */
+  &DoublyLinkedList_as_sequence,        /* tp_as_sequence */
+  &DoublyLinkedList_as_mapping,         /* tp_as_mapping */
+  PyObject_HashNotImplemented,          /* tp_hash  */
+  0,                                    /* tp_call */
+  DoublyLinkedList_str,                 /* tp_str */
+  0,                                    /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_BASETYPE |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  DoublyLinkedList_doc,                 /* tp_doc */
+  (traverseproc)DoublyLinkedList_traverse,
+                                        /* tp_traverse */
+  (inquiry)DoublyLinkedList_tp_clear,   /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  (getiterfunc)DoublyLinkedList_iter,   /* tp_iter */
+  0,                                    /* tp_iternext */
+  DoublyLinkedList_methods,             /* tp_methods */
+  0,                                    /* tp_members */
+  0,                                    /* tp_getset */
+  0,                                    /* tp_base */
+  0,                                    /* tp_dict */
+  0,                                    /* tp_descr_get */
+  0,                                    /* tp_descr_set */
+  0,                                    /* tp_dictoffset */
+  (initproc)DoublyLinkedList_init,      /* tp_init */
+  PyType_GenericAlloc,                  /* tp_alloc */
+  DoublyLinkedList_new,                 /* tp_new */
+  PyObject_GC_Del,                      /* tp_free */
+  0,                                    /* tp_is_gc */
+  0,                                    /* tp_bases */
+  0,                                    /* tp_mro */
+  0,                                    /* tp_cache */
+  0,                                    /* tp_subclasses */
+  0,                                    /* tp_weaklist */
+  0,                                    /* tp_del */
+  0,                                    /* tp_version_tag */
+  0,                                    /* tp_finalize */
+  DoublyLinkedList_vectorcall,          /* tp_vectorcall */
+};
+
+
+/* UnrolledLinkedListNode
+ * Holds up to UNROLLEDLIST_NODE_CAPACITY items in a small inline array. */
+
+#define UNROLLEDLIST_NODE_CAPACITY 16
+
+typedef struct UnrolledLinkedListNodeType {
+  struct UnrolledLinkedListNodeType *next;
+  Py_ssize_t count;
+  PyObject *items[UNROLLEDLIST_NODE_CAPACITY];
+} UnrolledLinkedListNode;
+
+static NodePool UnrolledLinkedListNode_pool =
+  NODEPOOL_INIT(UnrolledLinkedListNode);
+
+#define UnrolledLinkedListNode_alloc() \
+  ((UnrolledLinkedListNode *)NodePool_alloc(&UnrolledLinkedListNode_pool))
+#define UnrolledLinkedListNode_free(n) \
+  NodePool_free(&UnrolledLinkedListNode_pool, (n))
+
+/* Frees the chain of nodes starting at n and releases their items. */
+static void
+UnrolledLinkedListNode_free_chain(UnrolledLinkedListNode *n)
+{
+  UnrolledLinkedListNode *tmp;
+  Py_ssize_t i;
+
+  while (n) {
+    for (i = 0; i < n->count; ++i) {
+      Py_DECREF(n->items[i]);
+    }
+    tmp = n;
+    n = n->next;
+    UnrolledLinkedListNode_free(tmp);
+  }
+}
+
+
+/* UnrolledLinkedList
+ * Unrolled-linked-node-based implementation of the List interface.  Every
+ * node but the tail is kept at least half full: a full node is split in two
+ * on insert, and a node that drops below half full on remove borrows from or
+ * merges with its successor.  Walks therefore chase up to K times fewer
+ * pointers than a singly linked list, and items sit contiguously. */
+typedef struct {
+  PyObject_HEAD
+  UnrolledLinkedListNode *head;
+  UnrolledLinkedListNode *tail;
+  Py_ssize_t size;
+  long state;
+#if EDUCOLLECTIONS_STATS
+  ListStats stats;
+#endif
+} UnrolledLinkedList;
+
+PyDoc_STRVAR(UnrolledLinkedList_doc,
+  "Unrolled-linked-node-based implementation of the List interface.\n"
+  "Each node holds a small array of items.");
+
+/* UnrolledLinkedListType.tp_new */
+static PyObject *
+UnrolledLinkedList_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  UnrolledLinkedList *self;
+
+  self = (UnrolledLinkedList *)type->tp_alloc(type, 0);
+  if (self == NULL)
+      return NULL;
+
+  self->head = NULL;
+  self->tail = NULL;
+  self->size = 0;
+  self->state = 0;
+
+  return (PyObject *)self;
+}
+
+/* UnrolledLinkedListType.tp_init */
+static int
+UnrolledLinkedList_init(UnrolledLinkedList *self, PyObject *args,
+                        PyObject *kwds)
+{
+  return 0;
+}
+
+/* UnrolledLinkedListType.tp_traverse */
+static int
+UnrolledLinkedList_traverse(UnrolledLinkedList *self, visitproc visit,
+                            void *arg)
+{
+  UnrolledLinkedListNode *n;
+  Py_ssize_t i;
+
+  for (n = self->head; n; n = n->next) {
+    for (i = 0; i < n->count; ++i) {
+      Py_VISIT(n->items[i]);
+    }
+  }
+  return 0;
+}
+
+/* UnrolledLinkedListType.tp_clear
+ * Detaches the chain before releasing its items, which can run arbitrary
+ * code. */
+static int
+UnrolledLinkedList_tp_clear(UnrolledLinkedList *self)
+{
+  UnrolledLinkedListNode *n;
+
+#if EDUCOLLECTIONS_STATS
+  for (n = self->head; n != NULL; n = n->next) {
+    LISTSTATS_ADD(self, frees, 1);
+  }
+#endif
+  n = self->head;
+  self->head = NULL;
+  self->tail = NULL;
+  self->size = 0;
+  ++self->state;
+  UnrolledLinkedListNode_free_chain(n);
+  return 0;
+}
+
+/* UnrolledLinkedListType.tp_dealloc */
+static void
+UnrolledLinkedList_dealloc(UnrolledLinkedList *self)
+{
+  PyObject_GC_UnTrack(self);
+  UnrolledLinkedListNode_free_chain(self->head);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* Returns the node holding the item at index, which must be in range, and
+ * stores the item's offset within that node in *offsetp. */
+static UnrolledLinkedListNode *
+UnrolledLinkedList_locate(UnrolledLinkedList *self, Py_ssize_t index,
+                          Py_ssize_t *offsetp)
+{
+  UnrolledLinkedListNode *n;
+
+  if (index >= self->size - self->tail->count) {
+    *offsetp = index - (self->size - self->tail->count);
+    return self->tail;
+  }
+  n = self->head;
+  while (index >= n->count) {
+    index -= n->count;
+    n = n->next;
+    LISTSTATS_ADD(self, walked, 1);
+  }
+  *offsetp = index;
+  return n;
+}
+
+/* Moves the upper half of the items in n into a new node linked after it.
+ * Returns the new node, or NULL with an exception set. */
+static UnrolledLinkedListNode *
+UnrolledLinkedList_split(UnrolledLinkedList *self, UnrolledLinkedListNode *n)
+{
+  UnrolledLinkedListNode *m;
+  Py_ssize_t half;
+
+  m = UnrolledLinkedListNode_alloc();
+  if (m == NULL) {
+    PyErr_NoMemory();
+    return NULL;
+  }
+  half = n->count / 2;
+  m->count = n->count - half;
+  memcpy(m->items, n->items + half, m->count * sizeof(PyObject *));
+  n->count = half;
+  m->next = n->next;
+  n->next = m;
+  if (self->tail == n) {
+    self->tail = m;
+  }
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_ADD(self, shifted, m->count);
+  return m;
+}
+
+/* Inserts item so that it ends up at index, which may equal size. */
+static int
+UnrolledLinkedList_insert_index(UnrolledLinkedList *self, Py_ssize_t index,
+                                PyObject *item)
+{
+  UnrolledLinkedListNode *n, *m;
+  Py_ssize_t offset;
+
+  if (self->tail == NULL || (index == self->size &&
+                             self->tail->count == UNROLLEDLIST_NODE_CAPACITY)) {
+    m = UnrolledLinkedListNode_alloc();
+    if (m == NULL) {
+      PyErr_NoMemory();
+      return -1;
+    }
+    m->next = NULL;
+    m->count = 0;
+    if (self->tail == NULL) {
+      self->head = m;
+    }
+    else {
+      self->tail->next = m;
+    }
+    self->tail = m;
+    n = m;
+    offset = 0;
+    LISTSTATS_ADD(self, allocs, 1);
+  }
+  else if (index == self->size) {
+    n = self->tail;
+    offset = n->count;
+  }
+  else {
+    n = UnrolledLinkedList_locate(self, index, &offset);
+    if (n->count == UNROLLEDLIST_NODE_CAPACITY) {
+      m = UnrolledLinkedList_split(self, n);
+      if (m == NULL) {
+        return -1;
+      }
+      if (offset > n->count) {
+        offset -= n->count;
+        n = m;
+      }
+    }
+  }
+  memmove(n->items + offset + 1, n->items + offset,
+          (n->count - offset) * sizeof(PyObject *));
+  LISTSTATS_ADD(self, shifted, n->count - offset);
+  Py_INCREF(item);
+  n->items[offset] = item;
+  ++n->count;
+  ++self->size;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  return 0;
+}
+
+/* Removes and returns the item at index, which must be in range. */
+static PyObject *
+UnrolledLinkedList_remove_index(UnrolledLinkedList *self, Py_ssize_t index)
+{
+  UnrolledLinkedListNode *n, *m, *prev;
+  PyObject *item;
+  Py_ssize_t offset, k;
+
+  n = UnrolledLinkedList_locate(self, index, &offset);
+  item = n->items[offset];
+  memmove(n->items + offset, n->items + offset + 1,
+          (n->count - offset - 1) * sizeof(PyObject *));
+  LISTSTATS_ADD(self, shifted, n->count - offset - 1);
+  --n->count;
+  --self->size;
+  ++self->state;
+
+  if (n->count == 0) {
+    if (n == self->head) {
+      prev = NULL;
+      self->head = n->next;
+    }
+    else {
+      prev = self->head;
+      while (prev->next != n) {
+        prev = prev->next;
+      }
+      prev->next = n->next;
+    }
+    if (self->tail == n) {
+      self->tail = prev;
+    }
+    UnrolledLinkedListNode_free(n);
+    LISTSTATS_ADD(self, frees, 1);
+  }
+  else if (n->count < UNROLLEDLIST_NODE_CAPACITY / 2 && n->next != NULL) {
+    m = n->next;
+    if (n->count + m->count <= UNROLLEDLIST_NODE_CAPACITY) {
+      memcpy(n->items + n->count, m->items, m->count * sizeof(PyObject *));
+      LISTSTATS_ADD(self, shifted, m->count);
+      n->count += m->count;
+      n->next = m->next;
+      if (self->tail == m) {
+        self->tail = n;
+      }
+      UnrolledLinkedListNode_free(m);
+      LISTSTATS_ADD(self, frees, 1);
+    }
+    else {
+      k = UNROLLEDLIST_NODE_CAPACITY / 2 - n->count;
+      memcpy(n->items + n->count, m->items, k * sizeof(PyObject *));
+      memmove(m->items, m->items + k, (m->count - k) * sizeof(PyObject *));
+      LISTSTATS_ADD(self, shifted, m->count);
+      n->count += k;
+      m->count -= k;
+    }
+  }
+  return item;
+}
+
+/* UnrolledLinkedList.append(item) */
+static PyObject *
+UnrolledLinkedList_append(UnrolledLinkedList *self, PyObject *item)
+{
+  if (UnrolledLinkedList_insert_index(self, self->size, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* UnrolledLinkedList.clear() */
+static PyObject *
+UnrolledLinkedList_clear(UnrolledLinkedList *self)
+{
+  UnrolledLinkedList_tp_clear(self);
+  Py_RETURN_NONE;
+}
+
+/* UnrolledLinkedList.extend(iterable)
+ * Every node the new items need is allocated before the list is touched;
+ * the items then fill the tail's free slots and the new nodes in order. */
+static PyObject *
+UnrolledLinkedList_extend(UnrolledLinkedList *self, PyObject *iterable)
+{
+  UnrolledLinkedListNode *first = NULL, *last = NULL, *n;
+  PyObject *seq, **items;
+  Py_ssize_t size, room, needed, i, j, k;
+
+  seq = PySequence_Fast(iterable, "LinkedList argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  size = PySequence_Fast_GET_SIZE(seq);
+  items = PySequence_Fast_ITEMS(seq);
+  room = self->tail ? UNROLLEDLIST_NODE_CAPACITY - self->tail->count : 0;
+  needed = size > room ? (size - room + UNROLLEDLIST_NODE_CAPACITY - 1) /
+                         UNROLLEDLIST_NODE_CAPACITY : 0;
+  for (i = 0; i < needed; ++i) {
+    n = UnrolledLinkedListNode_alloc();
+    if (n == NULL) {
+      UnrolledLinkedListNode_free_chain(first);
+      Py_DECREF(seq);
+      PyErr_NoMemory();
+      return NULL;
+    }
+    n->next = NULL;
+    n->count = 0;
+    if (first == NULL) {
+      first = n;
+    }
+    else {
+      last->next = n;
+    }
+    last = n;
+  }
+
+  j = 0;
+  for (n = room > 0 ? self->tail : first; j < size; n = n->next) {
+    k = UNROLLEDLIST_NODE_CAPACITY - n->count;
+    if (k > size - j) {
+      k = size - j;
+    }
+    for (i = 0; i < k; ++i) {
+      Py_INCREF(items[j + i]);
+      n->items[n->count + i] = items[j + i];
+    }
+    n->count += k;
+    j += k;
+    if (n == self->tail) {
+      n->next = first;
+    }
+  }
+  if (first != NULL) {
+    if (self->head == NULL) {
+      self->head = first;
+    }
+    else {
+      self->tail->next = first;
+    }
+    self->tail = last;
+  }
+  if (size > 0) {
+    self->size += size;
+    ++self->state;
+    LISTSTATS_ADD(self, allocs, needed);
+    LISTSTATS_PEAK(self);
+  }
+  Py_DECREF(seq);
+  Py_RETURN_NONE;
+}
+
+/* UnrolledLinkedList.from_iterable(iterable) */
+static PyObject *
+UnrolledLinkedList_from_iterable(PyTypeObject *type, PyObject *iterable)
+{
+  PyObject *self, *result;
+
+  self = PyObject_CallNoArgs((PyObject *)type);
+  if (self == NULL) {
+    return NULL;
+  }
+  result = UnrolledLinkedList_extend((UnrolledLinkedList *)self, iterable);
+  if (result == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  Py_DECREF(result);
+  return self;
+}
+
+/* UnrolledLinkedListType.tp_as_sequence->sq_item */
+static PyObject *
+UnrolledLinkedList_item(UnrolledLinkedList *self, Py_ssize_t index)
+{
+  UnrolledLinkedListNode *n;
+  Py_ssize_t offset;
+  PyObject *item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "UnrolledLinkedList index out of range");
+    return NULL;
+  }
+  n = UnrolledLinkedList_locate(self, index, &offset);
+  item = n->items[offset];
+  Py_INCREF(item);
+  return item;
+}
+
+/* UnrolledLinkedList.get(index) */
+static PyObject *
+UnrolledLinkedList_get(UnrolledLinkedList *self, PyObject *indexobj)
+{
+  Py_ssize_t index = -1;
+
+  if (indexobj != NULL && indexobj != Py_None) {
+    index = PyLong_AsSsize_t(indexobj);
+    if (index == -1 && PyErr_Occurred())
+      return NULL;
+  }
+  return UnrolledLinkedList_item(self, index);
+}
+
+/* UnrolledLinkedList.insert(index, item) */
+static PyObject *
+UnrolledLinkedList_insert(UnrolledLinkedList *self, PyObject *const *args,
+                          Py_ssize_t nargs)
+{
+  PyObject *indexobj = NULL, *itemobj = NULL;
+  Py_ssize_t index = -1;
+
+  if (!List_check_nargs("insert", nargs, 2)) {
+    return NULL;
+  }
+  indexobj = args[0];
+  itemobj = args[1];
+  if (indexobj != NULL && indexobj != Py_None) {
+    index = PyLong_AsSsize_t(indexobj);
+    if (index == -1 && PyErr_Occurred())
+      return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "UnrolledLinkedList index out of range");
+    return NULL;
+  }
+  if (UnrolledLinkedList_insert_index(self, index, itemobj) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* UnrolledLinkedList.prepend(item) */
+static PyObject *
+UnrolledLinkedList_prepend(UnrolledLinkedList *self, PyObject *item)
+{
+  if (UnrolledLinkedList_insert_index(self, 0, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* UnrolledLinkedList.remove(index) */
+static PyObject *
+UnrolledLinkedList_remove(UnrolledLinkedList *self, PyObject *indexobj)
+{
+  Py_ssize_t index = -1;
+
+  if (indexobj != NULL && indexobj != Py_None) {
+    index = PyLong_AsSsize_t(indexobj);
+    if (index == -1 && PyErr_Occurred())
+      return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "UnrolledLinkedList index out of range");
+    return NULL;
+  }
+  return UnrolledLinkedList_remove_index(self, index);
+}
+
+/* UnrolledLinkedListType.tp_as_sequence->sq_ass_item
+ * Assigns item at index, or deletes the item at index if item is NULL. */
+static int
+UnrolledLinkedList_ass_item(UnrolledLinkedList *self, Py_ssize_t index,
+                            PyObject *item)
+{
+  UnrolledLinkedListNode *n;
+  Py_ssize_t offset;
+  PyObject *old_item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "UnrolledLinkedList index out of range");
+    return -1;
+  }
+  if (item == NULL) {
+    old_item = UnrolledLinkedList_remove_index(self, index);
+    Py_DECREF(old_item);
+    return 0;
+  }
+  n = UnrolledLinkedList_locate(self, index, &offset);
+  ++self->state;
+  old_item = n->items[offset];
+  Py_INCREF(item);
+  n->items[offset] = item;
+  Py_DECREF(old_item);
+  return 0;
+}
+
+/* UnrolledLinkedList.set(index, item) */
+static PyObject *
+UnrolledLinkedList_set(UnrolledLinkedList *self, PyObject *const *args,
+                       Py_ssize_t nargs)
+{
+  PyObject *indexobj = NULL, *itemobj = NULL;
+  Py_ssize_t index = -1;
+
+  if (!List_check_nargs("set", nargs, 2)) {
+    return NULL;
+  }
+  indexobj = args[0];
+  itemobj = args[1];
+  if (indexobj != NULL && indexobj != Py_None) {
+    index = PyLong_AsSsize_t(indexobj);
+    if (index == -1 && PyErr_Occurred())
+      return NULL;
+  }
+  if (UnrolledLinkedList_ass_item(self, index, itemobj) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* UnrolledLinkedList.size() */
+static PyObject *
+UnrolledLinkedList_size(UnrolledLinkedList *self)
+{
+  return PyLong_FromSsize_t(self->size);
+}
+
+#if EDUCOLLECTIONS_STATS
+/* UnrolledLinkedList.stats() */
+static PyObject *
+UnrolledLinkedList_stats(UnrolledLinkedList *self)
+{
+  return ListStats_dict(&self->stats);
+}
+
+/* UnrolledLinkedList.reset_stats() */
+static PyObject *
+UnrolledLinkedList_reset_stats(UnrolledLinkedList *self)
+{
+  ListStats_reset(&self->stats, self->size);
+  Py_RETURN_NONE;
+}
+#endif
+
+/* UnrolledLinkedListIterator
+ * Iterates over an UnrolledLinkedList with a node and offset cursor, raising
+ * if the list is mutated before iteration ends. */
+typedef struct {
+  PyObject_HEAD
+  UnrolledLinkedList     *list;
+  UnrolledLinkedListNode *node;
+  Py_ssize_t             offset;
+  long                   state;
+} UnrolledLinkedListIterator;
+
+/* UnrolledLinkedListType.tp_iter */
+static PyObject *
+UnrolledLinkedList_iter(UnrolledLinkedList *self)
+{
+  UnrolledLinkedListIterator *it;
+
+  it = PyObject_GC_New(UnrolledLinkedListIterator,
+                       &UnrolledLinkedListIteratorType);
+  if (it == NULL) {
+    return NULL;
+  }
+  Py_INCREF(self);
+  it->list = self;
+  it->node = self->head;
+  it->offset = 0;
+  it->state = self->state;
+  PyObject_GC_Track(it);
+  return (PyObject *)it;
+}
+
+/* UnrolledLinkedListIteratorType.tp_dealloc */
+static void
+UnrolledLinkedListIterator_dealloc(UnrolledLinkedListIterator *self)
+{
+  PyObject_GC_UnTrack(self);
+  Py_XDECREF(self->list);
+  PyObject_GC_Del(self);
+}
+
+/* UnrolledLinkedListIteratorType.tp_traverse */
+static int
+UnrolledLinkedListIterator_traverse(UnrolledLinkedListIterator *self,
+                                    visitproc visit, void *arg)
+{
+  Py_VISIT(self->list);
+  return 0;
+}
+
+/* UnrolledLinkedListIteratorType.tp_clear
+ * The cursor points into the list, so it is dropped with it. */
+static int
+UnrolledLinkedListIterator_clear(UnrolledLinkedListIterator *self)
+{
+  self->node = NULL;
+  Py_CLEAR(self->list);
+  return 0;
+}
+
+/* UnrolledLinkedListIteratorType.tp_iternext */
+static PyObject *
+UnrolledLinkedListIterator_next(UnrolledLinkedListIterator *self)
+{
+  PyObject *item;
+
+  if (self->list == NULL) {
+    return NULL;
+  }
+  if (self->list->state != self->state) {
+    PyErr_SetString(PyExc_RuntimeError, "LinkedList mutated during iteration");
+    self->node = NULL;
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  if (self->node == NULL) {
+    Py_CLEAR(self->list);
+    return NULL;
+  }
+  item = self->node->items[self->offset];
+  if (++self->offset == self->node->count) {
+    self->node = self->node->next;
+    self->offset = 0;
+  }
+  Py_INCREF(item);
+  return item;
+}
+
+PyTypeObject UnrolledLinkedListIteratorType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.UnrolledLinkedListIterator",
+                                        /* tp_name */
+  sizeof(UnrolledLinkedListIterator),   /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)UnrolledLinkedListIterator_dealloc,
+                                        /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  0,                                    /* tp_repr */
+  0,                                    /* tp_as_number */
+  0,                                    /* tp_as_sequence */
+  0,                                    /* tp_as_mapping */
+  0,                                    /* tp_hash  */
+  0,                                    /* tp_call */
+  0,                                    /* tp_str */
+  PyObject_GenericGetAttr,              /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  0,                                    /* tp_doc */
+  (traverseproc)UnrolledLinkedListIterator_traverse,
+                                        /* tp_traverse */
+  (inquiry)UnrolledLinkedListIterator_clear,
+                                        /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  PyObject_SelfIter,                    /* tp_iter */
+  (iternextfunc)UnrolledLinkedListIterator_next,
+                                        /* tp_iternext */
+};
+
+/* UnrolledLinkedListType.tp_as_sequence->sq_length */
+static Py_ssize_t
+UnrolledLinkedList_length(UnrolledLinkedList *self)
+{
+  return self->size;
 }
 
-/* ArrayListType.tp_str */
+/* UnrolledLinkedListType.tp_as_sequence->sq_contains
+ * A comparison that mutates this UnrolledLinkedList may free or rearrange
+ * the node being visited, so that raises RuntimeError. */
+static int
+UnrolledLinkedList_contains(UnrolledLinkedList *self, PyObject *item)
+{
+  UnrolledLinkedListNode *n;
+  Py_ssize_t i;
+  long state = self->state;
+  int cmp = 0;
+
+  for (n = self->head; cmp == 0 && n; n = n->next) {
+    for (i = 0; cmp == 0 && i < n->count; ++i) {
+      cmp = List_item_eq(n->items[i], item);
+      if (cmp >= 0 && self->state != state) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "UnrolledLinkedList mutated during search");
+        return -1;
+      }
+    }
+  }
+  return cmp;
+}
+
+/* UnrolledLinkedListType.tp_as_mapping->mp_subscript
+ * A slice is gathered in one walk over the list and loaded with extend(). */
 static PyObject *
-ArrayList_str(PyObject *self)
+UnrolledLinkedList_subscript(UnrolledLinkedList *self, PyObject *key)
 {
-  /* PyObject *aslist; */
-  /* PyObject *result; */
-  /* int i; */
+  UnrolledLinkedListNode *n;
+  PyObject *result, *items, *tmp, *item;
+  Py_ssize_t index, start, stop, step, slicelength, lo, hi, i, j;
 
-  /* i = Py_ReprEnter(self); */
-  /* if (i != 0) { */
-  /*     if (i < 0) */
-  /*         return NULL; */
-  /*     return PyUnicode_FromString("[...]"); */
-  /* } */
-  /* aslist = PySequence_List(self); */
-  /* if (aslist == NULL) { */
-  /*     Py_ReprLeave(self); */
-  /*     return NULL; */
-  /* } */
-  /* result = PyUnicode_FromFormat("%R", aslist); */
-  /* Py_DECREF(aslist); */
-  /* Py_ReprLeave(self); */
-  /* return result; */
+  if (PyIndex_Check(key)) {
+    index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+    if (index < 0) {
+      index += self->size;
+    }
+    return UnrolledLinkedList_item(self, index);
+  }
+  if (!PySlice_Check(key)) {
+    PyErr_Format(PyExc_TypeError,
+                 "UnrolledLinkedList indices must be integers or slices, "
+                 "not %.200s", Py_TYPE(key)->tp_name);
+    return NULL;
+  }
+  if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+    return NULL;
+  }
+  slicelength = PySlice_AdjustIndices(self->size, &start, &stop, step);
+  items = PyList_New(slicelength);
+  if (items == NULL) {
+    return NULL;
+  }
+  if (slicelength > 0) {
+    lo = step > 0 ? start : start + (slicelength - 1) * step;
+    hi = step > 0 ? start + (slicelength - 1) * step : start;
+    for (n = self->head, i = 0; n && i <= hi; n = n->next) {
+      for (j = 0; j < n->count && i <= hi; ++j, ++i) {
+        if (i < lo || (i - start) % step != 0) {
+          continue;
+        }
+        item = n->items[j];
+        Py_INCREF(item);
+        PyList_SET_ITEM(items, (i - start) / step, item);
+      }
+    }
+  }
+  result = PyObject_CallNoArgs((PyObject *)Py_TYPE(self));
+  if (result == NULL) {
+    Py_DECREF(items);
+    return NULL;
+  }
+  tmp = UnrolledLinkedList_extend((UnrolledLinkedList *)result, items);
+  Py_DECREF(items);
+  if (tmp == NULL) {
+    Py_DECREF(result);
+    return NULL;
+  }
+  Py_DECREF(tmp);
+  return result;
+}
+
+/* UnrolledLinkedListType.tp_as_sequence->sq_inplace_concat */
+static PyObject *
+UnrolledLinkedList_inplace_concat(UnrolledLinkedList *self, PyObject *other)
+{
+  PyObject *result;
+
+  result = UnrolledLinkedList_extend(self, other);
+  if (result == NULL) {
+    return NULL;
+  }
+  Py_DECREF(result);
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
+
+/* UnrolledLinkedListType.tp_repr */
+static PyObject *
+UnrolledLinkedList_repr(PyObject *self)
+{
   return PyUnicode_FromString("[...]");
 }
 
-/* ArrayListType.tp_methods */
-static PyMethodDef ArrayList_methods[] = {
-  {"append",                  (PyCFunction)ArrayList_append,
+/* UnrolledLinkedListType.tp_str */
+static PyObject *
+UnrolledLinkedList_str(PyObject *self)
+{
+  return PyUnicode_FromString("[...]");
+}
+
+static PyMethodDef UnrolledLinkedList_methods[] = {
+  {"append",                  (PyCFunction)UnrolledLinkedList_append,
       METH_O,                  List_append_doc},
-  {"capacity",                (PyCFunction)ArrayList_capacity,
-      METH_NOARGS,             ArrayList_capacity_doc},
-  {"clear",                   (PyCFunction)ArrayList_clear,
+  {"clear",                   (PyCFunction)UnrolledLinkedList_clear,
       METH_NOARGS,             List_clear_doc},
-  {"get",                     (PyCFunction)ArrayList_get,
+  {"extend",                  (PyCFunction)UnrolledLinkedList_extend,
+      METH_O,                  List_extend_doc},
+  {"from_iterable",           (PyCFunction)UnrolledLinkedList_from_iterable,
+      METH_O | METH_CLASS,     List_from_iterable_doc},
+  {"get",                     (PyCFunction)UnrolledLinkedList_get,
       METH_O,                  List_get_doc},
-  {"insert",                  (PyCFunction)ArrayList_insert,
-      METH_VARARGS,            List_insert_doc},
-  {"prepend",                 (PyCFunction)ArrayList_prepend,
+  {"insert",                  (PyCFunction)UnrolledLinkedList_insert,
+      METH_FASTCALL,           List_insert_doc},
+  {"prepend",                 (PyCFunction)UnrolledLinkedList_prepend,
       METH_O,                  List_prepend_doc},
-  {"remove",                  (PyCFunction)ArrayList_remove,
+  {"remove",                  (PyCFunction)UnrolledLinkedList_remove,
       METH_O,                  List_remove_doc},
-  {"set",                     (PyCFunction)ArrayList_set,
-      METH_VARARGS,            List_set_doc},
-  {"size",                    (PyCFunction)ArrayList_size,
+#if EDUCOLLECTIONS_STATS
+  {"reset_stats",             (PyCFunction)UnrolledLinkedList_reset_stats,
+      METH_NOARGS,             List_reset_stats_doc},
+#endif
+  {"set",                     (PyCFunction)UnrolledLinkedList_set,
+      METH_FASTCALL,           List_set_doc},
+  {"size",                    (PyCFunction)UnrolledLinkedList_size,
       METH_NOARGS,             List_size_doc},
+#if EDUCOLLECTIONS_STATS
+  {"stats",                   (PyCFunction)UnrolledLinkedList_stats,
+      METH_NOARGS,             List_stats_doc},
+#endif
   {NULL,                      NULL}
 };
 
-PyTypeObject ArrayListType = {
+static PySequenceMethods UnrolledLinkedList_as_sequence = {
+  (lenfunc)UnrolledLinkedList_length,   /* sq_length */
+  0,                                    /* sq_concat */
+  0,                                    /* sq_repeat */
+  (ssizeargfunc)UnrolledLinkedList_item,/* sq_item */
+  0,                                    /* was_sq_slice */
+  (ssizeobjargproc)UnrolledLinkedList_ass_item,
+                                        /* sq_ass_item */
+  0,                                    /* was_sq_ass_slice */
+  (objobjproc)UnrolledLinkedList_contains,
+                                        /* sq_contains */
+  (binaryfunc)UnrolledLinkedList_inplace_concat,
+                                        /* sq_inplace_concat */
+  0,                                    /* sq_inplace_repeat */
+};
+
+static PyMappingMethods UnrolledLinkedList_as_mapping = {
+  (lenfunc)UnrolledLinkedList_length,   /* mp_length */
+  (binaryfunc)UnrolledLinkedList_subscript,
+                                        /* mp_subscript */
+  0,                                    /* mp_ass_subscript */
+};
+
+PyTypeObject UnrolledLinkedListType = {
   PyVarObject_HEAD_INIT(NULL, 0)
-  "_educollections.ArrayList",          /* tp_name */
-  sizeof(ArrayList),                    /* tp_basicsize */
+  "_educollections.UnrolledLinkedList", /* tp_name */
+  sizeof(UnrolledLinkedList),           /* tp_basicsize */
   0,                                    /* tp_itemsize */
-  (destructor)ArrayList_dealloc,        /* tp_dealloc */
+  (destructor)UnrolledLinkedList_dealloc,
+                                        /* tp_dealloc */
   0,                                    /* tp_print */
   0,                                    /* tp_getattr */
   0,                                    /* tp_setattr */
   0,                                    /* tp_reserved */
-  ArrayList_repr,                       /* tp_repr */
+  UnrolledLinkedList_repr,              /* tp_repr */
   0,                                    /* tp_as_number */
-  0,                                    /* tp_as_sequence */
-  0,                                    /* tp_as_mapping */
+  &UnrolledLinkedList_as_sequence,      /* tp_as_sequence */
+  &UnrolledLinkedList_as_mapping,       /* tp_as_mapping */
   PyObject_HashNotImplemented,          /* tp_hash  */
   0,                                    /* tp_call */
-  ArrayList_str,                        /* tp_str */
+  UnrolledLinkedList_str,               /* tp_str */
   0,                                    /* tp_getattro */
   0,                                    /* tp_setattro */
   0,                                    /* tp_as_buffer */
   Py_TPFLAGS_DEFAULT |
-    Py_TPFLAGS_BASETYPE,                /* tp_flags */
-  ArrayList_doc,                        /* tp_doc */
-  0,                                    /* tp_traverse */
-  0,                                    /* tp_clear */
+    Py_TPFLAGS_BASETYPE |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  UnrolledLinkedList_doc,               /* tp_doc */
+  (traverseproc)UnrolledLinkedList_traverse,
+                                        /* tp_traverse */
+  (inquiry)UnrolledLinkedList_tp_clear, /* tp_clear */
   0,                                    /* tp_richcompare */
   0,                                    /* tp_weaklistoffset */
-  0,                                    /* tp_iter */
+  (getiterfunc)UnrolledLinkedList_iter, /* tp_iter */
   0,                                    /* tp_iternext */
-  ArrayList_methods,                    /* tp_methods */
+  UnrolledLinkedList_methods,           /* tp_methods */
   0,                                    /* tp_members */
   0,                                    /* tp_getset */
   0,                                    /* tp_base */
@@ -445,428 +9363,872 @@ PyTypeObject ArrayListType = {
   0,                                    /* tp_descr_get */
   0,                                    /* tp_descr_set */
   0,                                    /* tp_dictoffset */
-  (initproc)ArrayList_init,             /* tp_init */
+  (initproc)UnrolledLinkedList_init,    /* tp_init */
   PyType_GenericAlloc,                  /* tp_alloc */
-  ArrayList_new,                        /* tp_new */
+  UnrolledLinkedList_new,               /* tp_new */
+  PyObject_GC_Del,                      /* tp_free */
 };
 
 
-/* SinglyLinkedListNode */
-typedef struct SinglyLinkedListNodeType {
-  PyObject *data;
-  struct SinglyLinkedListNodeType *next;
-} SinglyLinkedListNode;
+/* IndexableSkipList
+ * Skip-list-based implementation of the List interface.  Every link records
+ * its width, the number of level-0 steps it skips, so a walk can count
+ * positions on the way down and get, set, insert and remove by index take
+ * expected O(log n) time.  A node is promoted one more level with
+ * probability p, giving 1 / (1 - p) links per node on average: a smaller p
+ * saves memory and makes walks longer.
+ *
+ * head is a sentinel at position -1 with room for every level.  A link whose
+ * next is NULL has the width that would reach position size, so inserting or
+ * removing only ever adjusts widths by the same rules at every level. */
 
+#define SKIPLIST_MAX_LEVEL 32
+
+typedef struct IndexableSkipListNode IndexableSkipListNode;
+
+typedef struct {
+  IndexableSkipListNode *next;
+  Py_ssize_t            width;
+} IndexableSkipListLink;
+
+struct IndexableSkipListNode {
+  PyObject              *data;
+  int                   level;
+  IndexableSkipListLink links[1];
+};
+
+#define IndexableSkipListNode_SIZE(level)                                 \
+  (offsetof(IndexableSkipListNode, links) +                               \
+   (level) * sizeof(IndexableSkipListLink))
 
-/* SinglyLinkedList1
- * Resizable singly-linked-node-based implementation of the List interface. */
 typedef struct {
   PyObject_HEAD
-  SinglyLinkedListNode *head;
-  Py_ssize_t size;
-  long state;
-} SinglyLinkedList1;
+  IndexableSkipListNode *head;
+  Py_ssize_t            size;
+  int                   level;
+  double                p;
+  uint64_t              rng;
+  long                  state;
+#if EDUCOLLECTIONS_STATS
+  ListStats             stats;
+#endif
+} IndexableSkipList;
 
-PyDoc_STRVAR(SinglyLinkedList1_doc,
-  "Resizable singly-linked-node-based implementation of the List interface.");
+PyDoc_STRVAR(IndexableSkipList_doc,
+  "IndexableSkipList(p=0.5)\n"
+  "\n"
+  "Skip-list-based implementation of the List interface with expected\n"
+  "O(log n) access, insertion and removal by index.  Each node is promoted\n"
+  "to the next level with probability p, so nodes carry 1 / (1 - p) links\n"
+  "on average; lower p trades speed for memory.");
+
+/* Draws a node level from the geometric distribution with parameter p,
+ * using this list's xorshift64* generator. */
+static int
+IndexableSkipList_random_level(IndexableSkipList *self)
+{
+  uint64_t x;
+  int level = 1;
+
+  while (level < SKIPLIST_MAX_LEVEL) {
+    x = self->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    self->rng = x;
+    if (((x * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0) >=
+        self->p) {
+      break;
+    }
+    ++level;
+  }
+  return level;
+}
+
+/* Returns the node at index, which must be in range. */
+static IndexableSkipListNode *
+IndexableSkipList_node_at(IndexableSkipList *self, Py_ssize_t index)
+{
+  IndexableSkipListNode *n = self->head;
+  Py_ssize_t pos = -1;
+  int level;
+
+  for (level = self->level - 1; level >= 0; --level) {
+    while (n->links[level].next != NULL &&
+           pos + n->links[level].width <= index) {
+      pos += n->links[level].width;
+      n = n->links[level].next;
+      LISTSTATS_ADD(self, walked, 1);
+    }
+  }
+  return n;
+}
+
+/* Fills update with the last node before index on each level in use, and
+ * pos with that node's position. */
+static void
+IndexableSkipList_find(IndexableSkipList *self, Py_ssize_t index,
+                       IndexableSkipListNode **update, Py_ssize_t *pos)
+{
+  IndexableSkipListNode *n = self->head;
+  Py_ssize_t p = -1;
+  int level = self->level;
+
+  /* self->level is never below 1, so update[0] is always filled. */
+  do {
+    --level;
+    while (n->links[level].next != NULL &&
+           p + n->links[level].width < index) {
+      p += n->links[level].width;
+      n = n->links[level].next;
+      LISTSTATS_ADD(self, walked, 1);
+    }
+    update[level] = n;
+    pos[level] = p;
+  } while (level > 0);
+}
+
+/* Inserts item so that it ends up at index, which may equal size. */
+static int
+IndexableSkipList_insert_index(IndexableSkipList *self, Py_ssize_t index,
+                               PyObject *item)
+{
+  IndexableSkipListNode *update[SKIPLIST_MAX_LEVEL], *n;
+  Py_ssize_t pos[SKIPLIST_MAX_LEVEL];
+  int height, level;
+
+  height = IndexableSkipList_random_level(self);
+  n = PyMem_Malloc(IndexableSkipListNode_SIZE(height));
+  if (n == NULL) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  IndexableSkipList_find(self, index, update, pos);
+  for (level = self->level; level < height; ++level) {
+    self->head->links[level].next = NULL;
+    self->head->links[level].width = self->size + 1;
+    update[level] = self->head;
+    pos[level] = -1;
+  }
+  if (height > self->level) {
+    self->level = height;
+  }
+  Py_INCREF(item);
+  n->data = item;
+  n->level = height;
+  for (level = 0; level < self->level; ++level) {
+    if (level < height) {
+      n->links[level].next = update[level]->links[level].next;
+      n->links[level].width =
+        pos[level] + update[level]->links[level].width + 1 - index;
+      update[level]->links[level].next = n;
+      update[level]->links[level].width = index - pos[level];
+    }
+    else {
+      ++update[level]->links[level].width;
+    }
+  }
+  ++self->size;
+  ++self->state;
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_PEAK(self);
+  return 0;
+}
+
+/* Removes and returns the item at index, which must be in range. */
+static PyObject *
+IndexableSkipList_remove_index(IndexableSkipList *self, Py_ssize_t index)
+{
+  IndexableSkipListNode *update[SKIPLIST_MAX_LEVEL], *n;
+  Py_ssize_t pos[SKIPLIST_MAX_LEVEL];
+  PyObject *item;
+  int level;
+
+  IndexableSkipList_find(self, index, update, pos);
+  n = update[0]->links[0].next;
+  for (level = 0; level < self->level; ++level) {
+    if (update[level]->links[level].next == n) {
+      update[level]->links[level].width += n->links[level].width - 1;
+      update[level]->links[level].next = n->links[level].next;
+    }
+    else {
+      --update[level]->links[level].width;
+    }
+  }
+  while (self->level > 1 &&
+         self->head->links[self->level - 1].next == NULL) {
+    --self->level;
+  }
+  item = n->data;
+  PyMem_Free(n);
+  --self->size;
+  ++self->state;
+  LISTSTATS_ADD(self, frees, 1);
+  return item;
+}
+
+/* Releases a level-0 chain of nodes and their items. */
+static void
+IndexableSkipListNode_free_chain(IndexableSkipListNode *n)
+{
+  IndexableSkipListNode *next;
+
+  while (n != NULL) {
+    next = n->links[0].next;
+    Py_DECREF(n->data);
+    PyMem_Free(n);
+    n = next;
+  }
+}
+
+/* IndexableSkipListType.tp_new */
+static PyObject *
+IndexableSkipList_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  IndexableSkipList *self;
+
+  self = (IndexableSkipList *)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+  self->head = PyMem_Malloc(IndexableSkipListNode_SIZE(SKIPLIST_MAX_LEVEL));
+  if (self->head == NULL) {
+    Py_DECREF(self);
+    return PyErr_NoMemory();
+  }
+  self->head->data = NULL;
+  self->head->level = SKIPLIST_MAX_LEVEL;
+  self->head->links[0].next = NULL;
+  self->head->links[0].width = 1;
+  self->size = 0;
+  self->level = 1;
+  self->p = 0.5;
+  self->rng = (uint64_t)(uintptr_t)self ^ 0x9E3779B97F4A7C15ULL;
+  self->state = 0;
+  return (PyObject *)self;
+}
+
+/* IndexableSkipListType.tp_init */
+static int
+IndexableSkipList_init(IndexableSkipList *self, PyObject *args,
+                       PyObject *kwds)
+{
+  double p = 0.5;
+  static char *kwlist[] = {"p", NULL};
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|d", kwlist, &p)) {
+    return -1;
+  }
+  if (!(p > 0.0 && p < 1.0)) {
+    PyErr_SetString(PyExc_ValueError, "p must be in (0.0, 1.0)");
+    return -1;
+  }
+  self->p = p;
+  return 0;
+}
+
+/* IndexableSkipListType.tp_traverse */
+static int
+IndexableSkipList_traverse(IndexableSkipList *self, visitproc visit, void *arg)
+{
+  IndexableSkipListNode *n;
+
+  if (self->head == NULL) {
+    return 0;
+  }
+  for (n = self->head->links[0].next; n; n = n->links[0].next) {
+    Py_VISIT(n->data);
+  }
+  return 0;
+}
+
+/* IndexableSkipListType.tp_clear
+ * Detaches the level-0 chain before releasing its items, which can run
+ * arbitrary code. */
+static int
+IndexableSkipList_tp_clear(IndexableSkipList *self)
+{
+  IndexableSkipListNode *n;
+
+  if (self->head == NULL) {
+    return 0;
+  }
+  n = self->head->links[0].next;
+  self->head->links[0].next = NULL;
+  self->head->links[0].width = 1;
+  self->level = 1;
+  LISTSTATS_ADD(self, frees, self->size);
+  self->size = 0;
+  ++self->state;
+  IndexableSkipListNode_free_chain(n);
+  return 0;
+}
+
+/* IndexableSkipListType.tp_dealloc */
+static void
+IndexableSkipList_dealloc(IndexableSkipList *self)
+{
+  PyObject_GC_UnTrack(self);
+  if (self->head != NULL) {
+    IndexableSkipListNode_free_chain(self->head->links[0].next);
+    PyMem_Free(self->head);
+  }
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* IndexableSkipList.append(item) */
+static PyObject *
+IndexableSkipList_append(IndexableSkipList *self, PyObject *item)
+{
+  if (IndexableSkipList_insert_index(self, self->size, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* IndexableSkipList.clear() */
+static PyObject *
+IndexableSkipList_clear(IndexableSkipList *self)
+{
+  IndexableSkipList_tp_clear(self);
+  Py_RETURN_NONE;
+}
 
-/* SinglyLinkedList1Type.tp_new */
+/* IndexableSkipList.extend(iterable) */
 static PyObject *
-SinglyLinkedList1_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+IndexableSkipList_extend(IndexableSkipList *self, PyObject *iterable)
 {
-  SinglyLinkedList1 *self;
+  PyObject *seq, **items;
+  Py_ssize_t n, i;
 
-  self = (SinglyLinkedList1 *)type->tp_alloc(type, 0);
-  if (self == NULL)
+  seq = PySequence_Fast(iterable,
+                        "IndexableSkipList.extend() argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  items = PySequence_Fast_ITEMS(seq);
+  for (i = 0; i < n; ++i) {
+    if (IndexableSkipList_insert_index(self, self->size, items[i]) < 0) {
+      Py_DECREF(seq);
       return NULL;
+    }
+  }
+  Py_DECREF(seq);
+  Py_RETURN_NONE;
+}
 
-  self->head = NULL;
-  self->size = 0;
-  self->state = 0;
+/* IndexableSkipList.from_iterable(iterable, **kwds)
+ * kwds are passed to the constructor. */
+static PyObject *
+IndexableSkipList_from_iterable(PyTypeObject *type, PyObject *args,
+                                PyObject *kwds)
+{
+  PyObject *iterable, *self, *result, *noargs;
 
-  return (PyObject *)self;
+  if (!PyArg_UnpackTuple(args, "from_iterable", 1, 1, &iterable)) {
+    return NULL;
+  }
+  noargs = PyTuple_New(0);
+  if (noargs == NULL) {
+    return NULL;
+  }
+  self = PyObject_Call((PyObject *)type, noargs, kwds);
+  Py_DECREF(noargs);
+  if (self == NULL) {
+    return NULL;
+  }
+  result = IndexableSkipList_extend((IndexableSkipList *)self, iterable);
+  if (result == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  Py_DECREF(result);
+  return self;
 }
 
-/* SinglyLinkedList1Type.tp_init */
-static int
-SinglyLinkedList1_init(SinglyLinkedList1 *self, PyObject *args, PyObject *kwds)
+/* IndexableSkipListType.tp_as_sequence->sq_item */
+static PyObject *
+IndexableSkipList_item(IndexableSkipList *self, Py_ssize_t index)
 {
-  return 0;
+  PyObject *item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "IndexableSkipList index out of range");
+    return NULL;
+  }
+  item = IndexableSkipList_node_at(self, index)->data;
+  Py_INCREF(item);
+  return item;
 }
 
-/* SinglyLinkedList1Type.tp_dealloc */
-static void
-SinglyLinkedList1_dealloc(SinglyLinkedList1 *self)
+/* IndexableSkipList.get(index) */
+static PyObject *
+IndexableSkipList_get(IndexableSkipList *self, PyObject *indexobj)
 {
-  SinglyLinkedListNode *n, *tmp;
+  Py_ssize_t index;
 
-  n = self->head;
-  while (n) {
-      Py_XDECREF(n->data);
-      tmp = n;
-      n = n->next;
-      PyMem_Free(tmp);
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
   }
-  Py_TYPE(self)->tp_free((PyObject*)self);
+  return IndexableSkipList_item(self, index);
 }
 
-/* SinglyLinkedList1.append(item) */
+/* IndexableSkipList.insert(index, item) */
 static PyObject *
-SinglyLinkedList1_append(SinglyLinkedList1 *self, PyObject *item)
+IndexableSkipList_insert(IndexableSkipList *self, PyObject *const *args,
+                         Py_ssize_t nargs)
 {
-  SinglyLinkedListNode *n;
+  Py_ssize_t index;
 
-  ++self->state;
-  n = PyMem_Malloc(sizeof(SinglyLinkedListNode));
-  if (n == NULL) {
-      PyErr_NoMemory();
-      return NULL;
+  if (!List_check_nargs("insert", nargs, 2)) {
+    return NULL;
   }
-  n->next = NULL;
-  Py_INCREF(item);
-  ++self->size;
-  n->data = item;
-  if (self->head == NULL) {
-    self->head = n;
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
   }
-  else {
-    /* TODO(nkraft): Walk list and append. */
-    /*self->tail->next = n;
-    self->tail = n;*/
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "IndexableSkipList index out of range");
+    return NULL;
+  }
+  if (IndexableSkipList_insert_index(self, index, args[1]) < 0) {
+    return NULL;
   }
   Py_RETURN_NONE;
 }
 
-/* SinglyLinkedList1.clear() */
+/* IndexableSkipList.prepend(item) */
 static PyObject *
-SinglyLinkedList1_clear(SinglyLinkedList1 *self)
+IndexableSkipList_prepend(IndexableSkipList *self, PyObject *item)
 {
-  SinglyLinkedListNode *n, *tmp;
-
-  n = self->head;
-  while (n) {
-      Py_XDECREF(n->data);
-      tmp = n;
-      n = n->next;
-      PyMem_Free(tmp);
+  if (IndexableSkipList_insert_index(self, 0, item) < 0) {
+    return NULL;
   }
-  self->head = NULL;
-  self->size = 0;
-  self->state = 0;
   Py_RETURN_NONE;
 }
 
-/* SinglyLinkedList1.get(index) */
+/* IndexableSkipList.remove(index) */
 static PyObject *
-SinglyLinkedList1_get(SinglyLinkedList1 *self, PyObject *indexobj)
+IndexableSkipList_remove(IndexableSkipList *self, PyObject *indexobj)
 {
-  SinglyLinkedListNode *n;
-  PyObject *item;
-  Py_ssize_t index = -1;
-  int i;
+  Py_ssize_t index;
 
-  if (indexobj != NULL && indexobj != Py_None) {
   index = PyLong_AsSsize_t(indexobj);
-  if (index == -1 && PyErr_Occurred())
+  if (index == -1 && PyErr_Occurred()) {
     return NULL;
   }
   if (index < 0 || index > self->size - 1) {
-  PyErr_SetString(PyExc_IndexError, "LinkedList index out of range");
-  return NULL;
+    PyErr_SetString(PyExc_IndexError, "IndexableSkipList index out of range");
+    return NULL;
   }
+  return IndexableSkipList_remove_index(self, index);
+}
 
-  n = self->head;
-  for (i = 0; i < index; ++i)
-  n = n->next;
-  item = n->data;
+/* IndexableSkipListType.tp_as_sequence->sq_ass_item
+ * Assigns item at index, or deletes the item at index if item is NULL. */
+static int
+IndexableSkipList_ass_item(IndexableSkipList *self, Py_ssize_t index,
+                           PyObject *item)
+{
+  IndexableSkipListNode *n;
+  PyObject *old_item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "IndexableSkipList index out of range");
+    return -1;
+  }
+  if (item == NULL) {
+    old_item = IndexableSkipList_remove_index(self, index);
+    Py_DECREF(old_item);
+    return 0;
+  }
+  n = IndexableSkipList_node_at(self, index);
+  ++self->state;
+  old_item = n->data;
   Py_INCREF(item);
-  return item;
+  n->data = item;
+  Py_DECREF(old_item);
+  return 0;
 }
 
-static PyObject * SinglyLinkedList1_prepend(SinglyLinkedList1 *self, PyObject *item);
-
-/* SinglyLinkedList1.insert(index, item) */
+/* IndexableSkipList.set(index, item) */
 static PyObject *
-SinglyLinkedList1_insert(SinglyLinkedList1 *self, PyObject *args)
+IndexableSkipList_set(IndexableSkipList *self, PyObject *const *args,
+                      Py_ssize_t nargs)
 {
-  SinglyLinkedListNode *n, *tmp;
-  PyObject *indexobj = NULL, *itemobj = NULL;
-  Py_ssize_t index = -1;
-  int i;
+  Py_ssize_t index;
 
-  if (!PyArg_ParseTuple(args, "OO", &indexobj, &itemobj)) {
-  return NULL;
-  }
-  if (indexobj != NULL && indexobj != Py_None) {
-  index = PyLong_AsSsize_t(indexobj);
-  if (index == -1 && PyErr_Occurred())
+  if (!List_check_nargs("set", nargs, 2)) {
     return NULL;
   }
-  if (index < 0 || index > self->size - 1) {
-  PyErr_SetString(PyExc_IndexError, "SinglyLinkedList1 index out of range");
-  return NULL;
-  }
-  if (itemobj == NULL) {
-  PyErr_SetString(PyExc_ValueError, "item == NULL");
-  return NULL;
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
   }
-
-  if (index == 0)
-  return SinglyLinkedList1_prepend(self, itemobj);
-  n = self->head;
-  for (i = 0; i < index - 1; ++i)
-  n = n->next;
-  tmp = PyMem_Malloc(sizeof(SinglyLinkedListNode));
-  if (tmp == NULL) {
-    PyErr_NoMemory();
+  if (IndexableSkipList_ass_item(self, index, args[1]) < 0) {
     return NULL;
   }
-  ++self->state;
-  ++self->size;
-  Py_INCREF(itemobj);
-  tmp->data = itemobj;
-  tmp->next = n->next;
-  n->next = tmp;
   Py_RETURN_NONE;
 }
 
-/* SinglyLinkedList1.prepend(item) */
+/* IndexableSkipList.size() */
 static PyObject *
-SinglyLinkedList1_prepend(SinglyLinkedList1 *self, PyObject *item)
+IndexableSkipList_size(IndexableSkipList *self)
 {
-  SinglyLinkedListNode *n;
+  return PyLong_FromSsize_t(self->size);
+}
 
-  ++self->state;
-  n = PyMem_Malloc(sizeof(SinglyLinkedListNode));
-  if (n == NULL) {
-      PyErr_NoMemory();
-      return NULL;
-  }
-  n->next = self->head;
-  Py_INCREF(item);
-  ++self->size;
-  n->data = item;
-  self->head = n;
+#if EDUCOLLECTIONS_STATS
+/* IndexableSkipList.stats() */
+static PyObject *
+IndexableSkipList_stats(IndexableSkipList *self)
+{
+  return ListStats_dict(&self->stats);
+}
+
+/* IndexableSkipList.reset_stats() */
+static PyObject *
+IndexableSkipList_reset_stats(IndexableSkipList *self)
+{
+  ListStats_reset(&self->stats, self->size);
   Py_RETURN_NONE;
 }
+#endif
 
-/* SinglyLinkedList1.remove(index) */
+/* IndexableSkipListType.tp_as_sequence->sq_length */
+static Py_ssize_t
+IndexableSkipList_length(IndexableSkipList *self)
+{
+  return self->size;
+}
+
+/* IndexableSkipListType.tp_as_sequence->sq_contains
+ * A comparison that mutates this IndexableSkipList may free the node being
+ * visited, so that raises RuntimeError. */
+static int
+IndexableSkipList_contains(IndexableSkipList *self, PyObject *item)
+{
+  IndexableSkipListNode *n;
+  long state = self->state;
+  int cmp = 0;
+
+  for (n = self->head->links[0].next; cmp == 0 && n; n = n->links[0].next) {
+    cmp = List_item_eq(n->data, item);
+    if (cmp >= 0 && self->state != state) {
+      PyErr_SetString(PyExc_RuntimeError,
+                      "IndexableSkipList mutated during search");
+      return -1;
+    }
+  }
+  return cmp;
+}
+
+/* IndexableSkipListType.tp_as_mapping->mp_subscript
+ * Slicing returns a new IndexableSkipList with the same p.  A forward slice
+ * is gathered in one level-0 walk from its first item. */
 static PyObject *
-SinglyLinkedList1_remove(SinglyLinkedList1 *self, PyObject *indexobj)
+IndexableSkipList_subscript(IndexableSkipList *self, PyObject *key)
 {
-  PyObject *item;
-  SinglyLinkedListNode *n, *remove;
-  Py_ssize_t index = -1;
-  int i;
+  IndexableSkipListNode *n;
+  PyObject *result, *items, *tmp, *item;
+  Py_ssize_t index, start, stop, step, slicelength, i, j;
 
-  if (indexobj != NULL && indexobj != Py_None) {
-  index = PyLong_AsSsize_t(indexobj);
-  if (index == -1 && PyErr_Occurred())
+  if (PyIndex_Check(key)) {
+    index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+    if (index < 0) {
+      index += self->size;
+    }
+    return IndexableSkipList_item(self, index);
+  }
+  if (!PySlice_Check(key)) {
+    PyErr_Format(PyExc_TypeError,
+                 "IndexableSkipList indices must be integers or slices, "
+                 "not %.200s", Py_TYPE(key)->tp_name);
     return NULL;
   }
-  if (index < 0 || index > self->size - 1) {
-  PyErr_SetString(PyExc_IndexError, "SinglyLinkedList1 index out of range");
-  return NULL;
+  if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+    return NULL;
   }
-
-  if (index == 0) {
-    if (self->size == 0) {
-      PyErr_SetString(PyExc_IndexError, "remove from an empty LinkedList");
-      return NULL;
+  slicelength = PySlice_AdjustIndices(self->size, &start, &stop, step);
+  items = PyList_New(slicelength);
+  if (items == NULL) {
+    return NULL;
+  }
+  if (slicelength > 0 && step > 0) {
+    n = IndexableSkipList_node_at(self, start);
+    for (i = 0; i < slicelength; ++i) {
+      item = n->data;
+      Py_INCREF(item);
+      PyList_SET_ITEM(items, i, item);
+      for (j = 0; j < step && n != NULL; ++j) {
+        n = n->links[0].next;
+      }
     }
-    item = self->head->data;
-    --self->size;
-    ++self->state;
-    n = self->head;
-    self->head = self->head->next;
-    PyMem_Free(n);
-    return item;
   }
-  if (index == self->size - 1) {
-    if (self->size == 0) {
-      PyErr_SetString(PyExc_IndexError, "remove from an empty LinkedList");
-      return NULL;
+  else {
+    for (i = 0; i < slicelength; ++i) {
+      item = IndexableSkipList_node_at(self, start + i * step)->data;
+      Py_INCREF(item);
+      PyList_SET_ITEM(items, i, item);
     }
-    /* TODO(nkraft): Initialize item correctly. */
-    item = self->head->data;
+  }
+  result = PyObject_CallNoArgs((PyObject *)Py_TYPE(self));
+  if (result == NULL) {
+    Py_DECREF(items);
+    return NULL;
+  }
+  ((IndexableSkipList *)result)->p = self->p;
+  tmp = IndexableSkipList_extend((IndexableSkipList *)result, items);
+  Py_DECREF(items);
+  if (tmp == NULL) {
+    Py_DECREF(result);
+    return NULL;
+  }
+  Py_DECREF(tmp);
+  return result;
+}
 
-    n = self->head;
-    for (i = 0; i < self->size - 2; ++i) {
-      n = n->next;
-    }
-    PyMem_Free(n->next);
-    --self->size;
-    ++self->state;
-    if (self->size == 0) {
-      self->head = NULL;
-    } else {
-    /* TODO(nkraft): Walk list and append. */
-      /* self->tail = n; */
-      /* self->tail->next = NULL; */
-    }
-    return item;
+/* IndexableSkipListType.tp_as_sequence->sq_inplace_concat */
+static PyObject *
+IndexableSkipList_inplace_concat(IndexableSkipList *self, PyObject *other)
+{
+  PyObject *result;
+
+  result = IndexableSkipList_extend(self, other);
+  if (result == NULL) {
+    return NULL;
   }
+  Py_DECREF(result);
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
 
-  n = self->head;
-  for (i = 0; i < index - 1; ++i) {
-    n = n->next;
+/* IndexableSkipListIterator
+ * Iterates over an IndexableSkipList along level 0, raising if the list is
+ * mutated before iteration ends. */
+typedef struct {
+  PyObject_HEAD
+  IndexableSkipList     *list;
+  IndexableSkipListNode *node;
+  long                  state;
+} IndexableSkipListIterator;
+
+/* IndexableSkipListType.tp_iter */
+static PyObject *
+IndexableSkipList_iter(IndexableSkipList *self)
+{
+  IndexableSkipListIterator *it;
+
+  it = PyObject_GC_New(IndexableSkipListIterator,
+                       &IndexableSkipListIteratorType);
+  if (it == NULL) {
+    return NULL;
   }
-  remove = n->next;
-  item = remove->data;
-  n->next = remove->next;
-  PyMem_Free(remove);
-  --self->size;
-  ++self->state;
-  return item;
+  Py_INCREF(self);
+  it->list = self;
+  it->node = self->head->links[0].next;
+  it->state = self->state;
+  PyObject_GC_Track(it);
+  return (PyObject *)it;
+}
+
+/* IndexableSkipListIteratorType.tp_dealloc */
+static void
+IndexableSkipListIterator_dealloc(IndexableSkipListIterator *self)
+{
+  PyObject_GC_UnTrack(self);
+  Py_XDECREF(self->list);
+  PyObject_GC_Del(self);
 }
 
-/* SinglyLinkedList1.set(index, item) */
+/* IndexableSkipListIteratorType.tp_traverse */
+static int
+IndexableSkipListIterator_traverse(IndexableSkipListIterator *self,
+                                   visitproc visit, void *arg)
+{
+  Py_VISIT(self->list);
+  return 0;
+}
+
+/* IndexableSkipListIteratorType.tp_clear
+ * The cursor points into the list, so it is dropped with it. */
+static int
+IndexableSkipListIterator_clear(IndexableSkipListIterator *self)
+{
+  self->node = NULL;
+  Py_CLEAR(self->list);
+  return 0;
+}
+
+/* IndexableSkipListIteratorType.tp_iternext */
 static PyObject *
-SinglyLinkedList1_set(SinglyLinkedList1 *self, PyObject *args)
+IndexableSkipListIterator_next(IndexableSkipListIterator *self)
 {
-  SinglyLinkedListNode *n;
-  PyObject *indexobj = NULL, *itemobj = NULL, *old_item = NULL;
-  Py_ssize_t index = -1;
-  int i;
+  PyObject *item;
 
-  if (!PyArg_ParseTuple(args, "OO", &indexobj, &itemobj)) {
+  if (self->list == NULL) {
     return NULL;
   }
-  if (indexobj != NULL && indexobj != Py_None) {
-  index = PyLong_AsSsize_t(indexobj);
-  if (index == -1 && PyErr_Occurred())
-    return NULL;
-  }
-  if (index < 0 || index > self->size - 1) {
-    PyErr_SetString(PyExc_IndexError, "SinglyLinkedList1 index out of range");
+  if (self->list->state != self->state) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "IndexableSkipList mutated during iteration");
+    self->node = NULL;
+    Py_CLEAR(self->list);
     return NULL;
   }
-  if (itemobj == NULL) {
-    PyErr_SetString(PyExc_ValueError, "item == NULL");
+  if (self->node == NULL) {
+    Py_CLEAR(self->list);
     return NULL;
   }
-
-  n = self->head;
-  for (i = 0; i < index; ++i) {
-    n = n->next;
-  }
-  ++self->state;
-  old_item = n->data;
-  Py_XDECREF(old_item);
-  Py_INCREF(itemobj);
-  n->data = itemobj;
-  Py_RETURN_NONE;
+  item = self->node->data;
+  self->node = self->node->links[0].next;
+  Py_INCREF(item);
+  return item;
 }
 
-/* SinglyLinkedList1.size() */
-static PyObject *
-SinglyLinkedList1_size(SinglyLinkedList1 *self)
-{
-  return PyLong_FromSsize_t(self->size);
-}
+PyTypeObject IndexableSkipListIteratorType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.IndexableSkipListIterator",
+                                        /* tp_name */
+  sizeof(IndexableSkipListIterator),    /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)IndexableSkipListIterator_dealloc,
+                                        /* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  0,                                    /* tp_repr */
+  0,                                    /* tp_as_number */
+  0,                                    /* tp_as_sequence */
+  0,                                    /* tp_as_mapping */
+  0,                                    /* tp_hash  */
+  0,                                    /* tp_call */
+  0,                                    /* tp_str */
+  PyObject_GenericGetAttr,              /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  0,                                    /* tp_doc */
+  (traverseproc)IndexableSkipListIterator_traverse,
+                                        /* tp_traverse */
+  (inquiry)IndexableSkipListIterator_clear,
+                                        /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  PyObject_SelfIter,                    /* tp_iter */
+  (iternextfunc)IndexableSkipListIterator_next,
+                                        /* tp_iternext */
+};
 
-/* SinglyLinkedList1Type.tp_repr */
+/* IndexableSkipListType.tp_repr */
 static PyObject *
-SinglyLinkedList1_repr(PyObject *self)
+IndexableSkipList_repr(PyObject *self)
 {
-  /* PyObject *aslist, *result; */
-  /* int i; */
-
-  /* i = Py_ReprEnter(self); */
-  /* if (i != 0) { */
-  /*     if (i < 0) */
-  /*         return NULL; */
-  /*     return PyUnicode_FromString("[...]"); */
-  /* } */
-
-  /* aslist = PySequence_List(self); */
-  /* if (aslist == NULL) { */
-  /*     Py_ReprLeave(self); */
-  /*     return NULL; */
-  /* } */
-  /* result = PyUnicode_FromFormat("%R", aslist); */
-  /* Py_DECREF(aslist); */
-  /* Py_ReprLeave(self); */
-  /* return result; */
   return PyUnicode_FromString("[...]");
 }
 
-/* SinglyLinkedList1Type.tp_str */
+/* IndexableSkipListType.tp_str */
 static PyObject *
-SinglyLinkedList1_str(PyObject *self)
+IndexableSkipList_str(PyObject *self)
 {
-  /* PyObject *aslist, *result; */
-  /* int i; */
-
-  /* i = Py_ReprEnter(self); */
-  /* if (i != 0) { */
-  /*     if (i < 0) */
-  /*         return NULL; */
-  /*     return PyUnicode_FromString("[...]"); */
-  /* } */
-
-  /* aslist = PySequence_List(self); */
-  /* if (aslist == NULL) { */
-  /*     Py_ReprLeave(self); */
-  /*     return NULL; */
-  /* } */
-  /* result = PyUnicode_FromFormat("%R", aslist); */
-  /* Py_DECREF(aslist); */
-  /* Py_ReprLeave(self); */
-  /* return result; */
   return PyUnicode_FromString("[...]");
 }
 
-static PyMethodDef SinglyLinkedList1_methods[] = {
-  {"append",                  (PyCFunction)SinglyLinkedList1_append,
+static PyMethodDef IndexableSkipList_methods[] = {
+  {"append",                  (PyCFunction)IndexableSkipList_append,
       METH_O,                  List_append_doc},
-  {"clear",                   (PyCFunction)SinglyLinkedList1_clear,
+  {"clear",                   (PyCFunction)IndexableSkipList_clear,
       METH_NOARGS,             List_clear_doc},
-  {"get",                     (PyCFunction)SinglyLinkedList1_get,
+  {"extend",                  (PyCFunction)IndexableSkipList_extend,
+      METH_O,                  List_extend_doc},
+  {"from_iterable",           (PyCFunction)IndexableSkipList_from_iterable,
+      METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+                               List_from_iterable_doc},
+  {"get",                     (PyCFunction)IndexableSkipList_get,
       METH_O,                  List_get_doc},
-  {"insert",                  (PyCFunction)SinglyLinkedList1_insert,
-      METH_VARARGS,            List_insert_doc},
-  {"prepend",                 (PyCFunction)SinglyLinkedList1_prepend,
+  {"insert",                  (PyCFunction)IndexableSkipList_insert,
+      METH_FASTCALL,           List_insert_doc},
+  {"prepend",                 (PyCFunction)IndexableSkipList_prepend,
       METH_O,                  List_prepend_doc},
-  {"remove",                  (PyCFunction)SinglyLinkedList1_remove,
+  {"remove",                  (PyCFunction)IndexableSkipList_remove,
       METH_O,                  List_remove_doc},
-  {"set",                     (PyCFunction)SinglyLinkedList1_set,
-      METH_VARARGS,            List_set_doc},
-  {"size",                    (PyCFunction)SinglyLinkedList1_size,
+#if EDUCOLLECTIONS_STATS
+  {"reset_stats",             (PyCFunction)IndexableSkipList_reset_stats,
+      METH_NOARGS,             List_reset_stats_doc},
+#endif
+  {"set",                     (PyCFunction)IndexableSkipList_set,
+      METH_FASTCALL,           List_set_doc},
+  {"size",                    (PyCFunction)IndexableSkipList_size,
       METH_NOARGS,             List_size_doc},
+#if EDUCOLLECTIONS_STATS
+  {"stats",                   (PyCFunction)IndexableSkipList_stats,
+      METH_NOARGS,             List_stats_doc},
+#endif
   {NULL,                      NULL}
 };
 
-PyTypeObject SinglyLinkedListType1 = {
+static PySequenceMethods IndexableSkipList_as_sequence = {
+  (lenfunc)IndexableSkipList_length,    /* sq_length */
+  0,                                    /* sq_concat */
+  0,                                    /* sq_repeat */
+  (ssizeargfunc)IndexableSkipList_item, /* sq_item */
+  0,                                    /* was_sq_slice */
+  (ssizeobjargproc)IndexableSkipList_ass_item,
+                                        /* sq_ass_item */
+  0,                                    /* was_sq_ass_slice */
+  (objobjproc)IndexableSkipList_contains,
+                                        /* sq_contains */
+  (binaryfunc)IndexableSkipList_inplace_concat,
+                                        /* sq_inplace_concat */
+  0,                                    /* sq_inplace_repeat */
+};
+
+static PyMappingMethods IndexableSkipList_as_mapping = {
+  (lenfunc)IndexableSkipList_length,    /* mp_length */
+  (binaryfunc)IndexableSkipList_subscript,
+                                        /* mp_subscript */
+  0,                                    /* mp_ass_subscript */
+};
+
+PyTypeObject IndexableSkipListType = {
   PyVarObject_HEAD_INIT(NULL, 0)
-  "_educollections.SinglyLinkedList1",  /* tp_name */
-  sizeof(SinglyLinkedList1),            /* tp_basicsize */
+  "_educollections.IndexableSkipList",  /* tp_name */
+  sizeof(IndexableSkipList),            /* tp_basicsize */
   0,                                    /* tp_itemsize */
-  (destructor)SinglyLinkedList1_dealloc,/* tp_dealloc */
+  (destructor)IndexableSkipList_dealloc,/* tp_dealloc */
   0,                                    /* tp_print */
   0,                                    /* tp_getattr */
   0,                                    /* tp_setattr */
   0,                                    /* tp_reserved */
-  SinglyLinkedList1_repr,               /* tp_repr */
+  IndexableSkipList_repr,               /* tp_repr */
   0,                                    /* tp_as_number */
-  0,                                    /* tp_as_sequence */
-  0,                                    /* tp_as_mapping */
+  &IndexableSkipList_as_sequence,       /* tp_as_sequence */
+  &IndexableSkipList_as_mapping,        /* tp_as_mapping */
   PyObject_HashNotImplemented,          /* tp_hash  */
   0,                                    /* tp_call */
-  SinglyLinkedList1_str,                /* tp_str */
+  IndexableSkipList_str,                /* tp_str */
   0,                                    /* tp_getattro */
   0,                                    /* tp_setattro */
   0,                                    /* tp_as_buffer */
   Py_TPFLAGS_DEFAULT |
-    Py_TPFLAGS_BASETYPE,                /* tp_flags */
-  SinglyLinkedList1_doc,                /* tp_doc */
-  0,                                    /* tp_traverse */
-  0,                                    /* tp_clear */
+    Py_TPFLAGS_BASETYPE |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  IndexableSkipList_doc,                /* tp_doc */
+  (traverseproc)IndexableSkipList_traverse,
+                                        /* tp_traverse */
+  (inquiry)IndexableSkipList_tp_clear,  /* tp_clear */
   0,                                    /* tp_richcompare */
   0,                                    /* tp_weaklistoffset */
-  0,                                    /* tp_iter */
+  (getiterfunc)IndexableSkipList_iter,  /* tp_iter */
   0,                                    /* tp_iternext */
-  SinglyLinkedList1_methods,            /* tp_methods */
+  IndexableSkipList_methods,            /* tp_methods */
   0,                                    /* tp_members */
   0,                                    /* tp_getset */
   0,                                    /* tp_base */
@@ -874,426 +10236,1319 @@ PyTypeObject SinglyLinkedListType1 = {
   0,                                    /* tp_descr_get */
   0,                                    /* tp_descr_set */
   0,                                    /* tp_dictoffset */
-  (initproc)SinglyLinkedList1_init,     /* tp_init */
+  (initproc)IndexableSkipList_init,     /* tp_init */
   PyType_GenericAlloc,                  /* tp_alloc */
-  SinglyLinkedList1_new,                /* tp_new */
+  IndexableSkipList_new,                /* tp_new */
+  PyObject_GC_Del,                      /* tp_free */
 };
 
+/* BTreeList
+ * B+tree-based implementation of the List interface, after blist.  Items
+ * live in leaves of up to BTREELIST_LEAF_CAPACITY items, chained left to
+ * right, and each branch records the number of items under each of its
+ * children, so get, set, insert and remove descend in O(log n) and a full
+ * scan reads whole leaves in order.  Inserts split full nodes on the way
+ * down and removals merge or rebalance thin nodes on the way back up, so
+ * every change leaves a valid tree even if an allocation fails.
+ *
+ * Slicing bulk-loads the selected items into a fresh tree, and extend()
+ * bulk-loads the new items and joins the two trees along their facing
+ * edges, so both cost O(k + log n) for k items. */
+
+#define BTREELIST_LEAF_CAPACITY 64
+#define BTREELIST_BRANCH_CAPACITY 32
+#define BTREELIST_MAX_HEIGHT 64
+
+typedef struct {
+  int count;
+} BTreeListNode;
+
+typedef struct BTreeListLeafType {
+  BTreeListNode            node;
+  struct BTreeListLeafType *next;
+  PyObject                 *items[BTREELIST_LEAF_CAPACITY];
+} BTreeListLeaf;
+
+typedef struct {
+  BTreeListNode node;
+  BTreeListNode *children[BTREELIST_BRANCH_CAPACITY];
+  Py_ssize_t    sizes[BTREELIST_BRANCH_CAPACITY];
+} BTreeListBranch;
+
+static NodePool BTreeListLeaf_pool = NODEPOOL_INIT(BTreeListLeaf);
+static NodePool BTreeListBranch_pool = NODEPOOL_INIT(BTreeListBranch);
+
+#define BTreeListLeaf_alloc() \
+  ((BTreeListLeaf *)NodePool_alloc(&BTreeListLeaf_pool))
+#define BTreeListBranch_alloc() \
+  ((BTreeListBranch *)NodePool_alloc(&BTreeListBranch_pool))
+
+/* The most entries a node at height can hold; leaves are at height 0. */
+#define BTreeListNode_CAPACITY(height) \
+  ((height) == 0 ? BTREELIST_LEAF_CAPACITY : BTREELIST_BRANCH_CAPACITY)
+
+typedef struct {
+  PyObject_HEAD
+  BTreeListNode *root;
+  Py_ssize_t    size;
+  int           height;
+  long          state;
+#if EDUCOLLECTIONS_STATS
+  ListStats     stats;
+#endif
+} BTreeList;
+
+PyDoc_STRVAR(BTreeList_doc,
+  "B+tree-based implementation of the List interface.\n"
+  "Access, insertion and removal by index take O(log n) time; slicing and\n"
+  "extending take time proportional to the number of items copied.");
+
+/* Frees the subtree rooted at n, whose leaves are height levels down, and
+ * releases its items. */
+static void
+BTreeListNode_free(BTreeListNode *n, int height)
+{
+  BTreeListBranch *b;
+  BTreeListLeaf *leaf;
+  int i;
+
+  if (height == 0) {
+    leaf = (BTreeListLeaf *)n;
+    for (i = 0; i < n->count; ++i) {
+      Py_DECREF(leaf->items[i]);
+    }
+    NodePool_free(&BTreeListLeaf_pool, leaf);
+    return;
+  }
+  b = (BTreeListBranch *)n;
+  for (i = 0; i < n->count; ++i) {
+    BTreeListNode_free(b->children[i], height - 1);
+  }
+  NodePool_free(&BTreeListBranch_pool, b);
+}
+
+#if EDUCOLLECTIONS_STATS
+/* Returns the number of nodes in the subtree rooted at n, whose leaves are
+ * height levels down. */
+static Py_ssize_t
+BTreeListNode_count(BTreeListNode *n, int height)
+{
+  Py_ssize_t count = 1;
+  int i;
+
+  if (height > 0) {
+    for (i = 0; i < n->count; ++i) {
+      count += BTreeListNode_count(((BTreeListBranch *)n)->children[i],
+                                   height - 1);
+    }
+  }
+  return count;
+}
+#endif
+
+/* Returns the first or, if last is true, the last leaf under n. */
+static BTreeListLeaf *
+BTreeListNode_edge_leaf(BTreeListNode *n, int height, int last)
+{
+  for (; height > 0; --height) {
+    n = ((BTreeListBranch *)n)->children[last ? n->count - 1 : 0];
+  }
+  return (BTreeListLeaf *)n;
+}
+
+/* Returns an empty leaf, setting an exception on failure. */
+static BTreeListNode *
+BTreeListNode_new_leaf(void)
+{
+  BTreeListLeaf *leaf;
+
+  leaf = BTreeListLeaf_alloc();
+  if (leaf == NULL) {
+    PyErr_NoMemory();
+    return NULL;
+  }
+  leaf->node.count = 0;
+  leaf->next = NULL;
+  return &leaf->node;
+}
+
+/* Builds a tree holding new references to items[0:n], spreading them evenly
+ * over as few leaves, and then branches, as will hold them. */
+static int
+BTreeListNode_build(PyObject **items, Py_ssize_t n, BTreeListNode **rootp,
+                    int *heightp)
+{
+  BTreeListNode **nodes;
+  BTreeListBranch *b;
+  BTreeListLeaf *leaf, *prev = NULL;
+  Py_ssize_t *sizes, count, parents, built, off, k, i, j, per;
+  int height = 0;
+
+  if (n == 0) {
+    *rootp = BTreeListNode_new_leaf();
+    *heightp = 0;
+    return *rootp != NULL ? 0 : -1;
+  }
+  count = (n + BTREELIST_LEAF_CAPACITY - 1) / BTREELIST_LEAF_CAPACITY;
+  nodes = PyMem_New(BTreeListNode *, count);
+  sizes = PyMem_New(Py_ssize_t, count);
+  if (nodes == NULL || sizes == NULL) {
+    PyMem_Del(nodes);
+    PyMem_Del(sizes);
+    PyErr_NoMemory();
+    return -1;
+  }
+  for (k = 0, off = 0; k < count; ++k) {
+    leaf = BTreeListLeaf_alloc();
+    if (leaf == NULL) {
+      for (i = 0; i < k; ++i) {
+        BTreeListNode_free(nodes[i], 0);
+      }
+      goto fail;
+    }
+    per = n / count + (k < n % count);
+    for (i = 0; i < per; ++i) {
+      Py_INCREF(items[off + i]);
+      leaf->items[i] = items[off + i];
+    }
+    leaf->node.count = (int)per;
+    leaf->next = NULL;
+    if (prev != NULL) {
+      prev->next = leaf;
+    }
+    prev = leaf;
+    nodes[k] = &leaf->node;
+    sizes[k] = per;
+    off += per;
+  }
+  /* Each pass groups the nodes of one level under new parents, written
+   * back over the front of the same arrays. */
+  while (count > 1) {
+    parents = (count + BTREELIST_BRANCH_CAPACITY - 1) /
+              BTREELIST_BRANCH_CAPACITY;
+    for (k = 0, off = 0; k < parents; ++k) {
+      b = BTreeListBranch_alloc();
+      if (b == NULL) {
+        for (i = 0; i < k; ++i) {
+          BTreeListNode_free(nodes[i], height + 1);
+        }
+        for (i = off; i < count; ++i) {
+          BTreeListNode_free(nodes[i], height);
+        }
+        goto fail;
+      }
+      per = count / parents + (k < count % parents);
+      built = 0;
+      for (j = 0; j < per; ++j) {
+        b->children[j] = nodes[off + j];
+        b->sizes[j] = sizes[off + j];
+        built += sizes[off + j];
+      }
+      b->node.count = (int)per;
+      nodes[k] = &b->node;
+      sizes[k] = built;
+      off += per;
+    }
+    count = parents;
+    ++height;
+  }
+  *rootp = nodes[0];
+  *heightp = height;
+  PyMem_Del(nodes);
+  PyMem_Del(sizes);
+  return 0;
+
+fail:
+  PyMem_Del(nodes);
+  PyMem_Del(sizes);
+  PyErr_NoMemory();
+  return -1;
+}
+
+/* Splits parent's full child i, whose leaves are height levels down, into
+ * two nodes; parent must have room for one more child. */
+static int
+BTreeListBranch_split_child(BTreeListBranch *parent, int i, int height)
+{
+  BTreeListBranch *b, *rb;
+  BTreeListLeaf *leaf, *rleaf;
+  BTreeListNode *right;
+  Py_ssize_t rsize = 0;
+  int half, j;
+
+  if (height == 0) {
+    leaf = (BTreeListLeaf *)parent->children[i];
+    rleaf = BTreeListLeaf_alloc();
+    if (rleaf == NULL) {
+      PyErr_NoMemory();
+      return -1;
+    }
+    half = leaf->node.count / 2;
+    rleaf->node.count = leaf->node.count - half;
+    memcpy(rleaf->items, leaf->items + half,
+           rleaf->node.count * sizeof(PyObject *));
+    leaf->node.count = half;
+    rleaf->next = leaf->next;
+    leaf->next = rleaf;
+    rsize = rleaf->node.count;
+    right = &rleaf->node;
+  }
+  else {
+    b = (BTreeListBranch *)parent->children[i];
+    rb = BTreeListBranch_alloc();
+    if (rb == NULL) {
+      PyErr_NoMemory();
+      return -1;
+    }
+    half = b->node.count / 2;
+    rb->node.count = b->node.count - half;
+    for (j = 0; j < rb->node.count; ++j) {
+      rb->children[j] = b->children[half + j];
+      rb->sizes[j] = b->sizes[half + j];
+      rsize += rb->sizes[j];
+    }
+    b->node.count = half;
+    right = &rb->node;
+  }
+  memmove(parent->children + i + 2, parent->children + i + 1,
+          (parent->node.count - i - 1) * sizeof(BTreeListNode *));
+  memmove(parent->sizes + i + 2, parent->sizes + i + 1,
+          (parent->node.count - i - 1) * sizeof(Py_ssize_t));
+  parent->children[i + 1] = right;
+  parent->sizes[i + 1] = rsize;
+  parent->sizes[i] -= rsize;
+  ++parent->node.count;
+  return 0;
+}
+
+/* Gives the tree rooted at *rootp a new root above it, splitting the old
+ * root, which must be full.  size is the number of items in the tree. */
+static int
+BTreeListNode_grow(BTreeListNode **rootp, int *heightp, Py_ssize_t size)
+{
+  BTreeListBranch *b;
+
+  b = BTreeListBranch_alloc();
+  if (b == NULL) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  b->node.count = 1;
+  b->children[0] = *rootp;
+  b->sizes[0] = size;
+  if (BTreeListBranch_split_child(b, 0, *heightp) < 0) {
+    NodePool_free(&BTreeListBranch_pool, b);
+    return -1;
+  }
+  *rootp = &b->node;
+  ++*heightp;
+  return 0;
+}
+
+/* Returns the leaf holding the item at *index, which must be in range, and
+ * replaces *index with the item's offset in that leaf. */
+static BTreeListLeaf *
+BTreeList_leaf_at(BTreeList *self, Py_ssize_t *index)
+{
+  BTreeListBranch *b;
+  BTreeListNode *n = self->root;
+  Py_ssize_t i = *index;
+  int h, j;
+
+  for (h = self->height; h > 0; --h) {
+    b = (BTreeListBranch *)n;
+    for (j = 0; i >= b->sizes[j]; ++j) {
+      i -= b->sizes[j];
+    }
+    n = b->children[j];
+  }
+  LISTSTATS_ADD(self, walked, self->height);
+  *index = i;
+  return (BTreeListLeaf *)n;
+}
+
+/* Inserts item so that it ends up at index, which may equal size.  Full
+ * nodes on the way down are split first, so the leaf always has room and
+ * subtree sizes are only updated once nothing else can fail. */
+static int
+BTreeList_insert_index(BTreeList *self, Py_ssize_t index, PyObject *item)
+{
+  BTreeListBranch *path[BTREELIST_MAX_HEIGHT], *b;
+  BTreeListLeaf *leaf;
+  BTreeListNode *n;
+  int slots[BTREELIST_MAX_HEIGHT];
+  int depth = 0, h, i;
+
+  if (self->root->count == BTreeListNode_CAPACITY(self->height)) {
+    if (BTreeListNode_grow(&self->root, &self->height, self->size) < 0) {
+      return -1;
+    }
+    LISTSTATS_ADD(self, allocs, 2);
+  }
+  n = self->root;
+  for (h = self->height; h > 0; --h) {
+    b = (BTreeListBranch *)n;
+    for (i = 0; i < b->node.count - 1 && index > b->sizes[i]; ++i) {
+      index -= b->sizes[i];
+    }
+    if (b->children[i]->count == BTreeListNode_CAPACITY(h - 1)) {
+      if (BTreeListBranch_split_child(b, i, h - 1) < 0) {
+        return -1;
+      }
+      LISTSTATS_ADD(self, allocs, 1);
+      if (index > b->sizes[i]) {
+        index -= b->sizes[i];
+        ++i;
+      }
+    }
+    path[depth] = b;
+    slots[depth] = i;
+    ++depth;
+    n = b->children[i];
+  }
+  leaf = (BTreeListLeaf *)n;
+  memmove(leaf->items + index + 1, leaf->items + index,
+          (leaf->node.count - index) * sizeof(PyObject *));
+  LISTSTATS_ADD(self, walked, self->height);
+  LISTSTATS_ADD(self, shifted, leaf->node.count - index);
+  Py_INCREF(item);
+  leaf->items[index] = item;
+  ++leaf->node.count;
+  while (depth > 0) {
+    --depth;
+    ++path[depth]->sizes[slots[depth]];
+  }
+  ++self->size;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  return 0;
+}
+
+/* Refills parent's child i, whose leaves are height levels down, once it
+ * holds fewer than half its capacity, by merging it with a neighbour if
+ * both fit in one node and otherwise evening out the pair.  Returns 1 if a
+ * node was merged away and freed, else 0. */
+static int
+BTreeListBranch_fix_child(BTreeListBranch *parent, int i, int height)
+{
+  BTreeListLeaf *ll, *rl;
+  BTreeListBranch *lb, *rb;
+  Py_ssize_t moved;
+  int capacity = BTreeListNode_CAPACITY(height);
+  int left, total, k, j;
+
+  if (parent->children[i]->count >= capacity / 2 || parent->node.count < 2) {
+    return 0;
+  }
+  left = i > 0 ? i - 1 : i;
+  total = parent->children[left]->count + parent->children[left + 1]->count;
+  if (height == 0) {
+    ll = (BTreeListLeaf *)parent->children[left];
+    rl = (BTreeListLeaf *)parent->children[left + 1];
+    if (total <= capacity) {
+      memcpy(ll->items + ll->node.count, rl->items,
+             rl->node.count * sizeof(PyObject *));
+      ll->node.count = total;
+      ll->next = rl->next;
+      NodePool_free(&BTreeListLeaf_pool, rl);
+      goto merged;
+    }
+    k = total / 2 - ll->node.count;
+    if (k > 0) {
+      memcpy(ll->items + ll->node.count, rl->items, k * sizeof(PyObject *));
+      memmove(rl->items, rl->items + k,
+              (rl->node.count - k) * sizeof(PyObject *));
+    }
+    else {
+      memmove(rl->items - k, rl->items, rl->node.count * sizeof(PyObject *));
+      memcpy(rl->items, ll->items + total / 2, -k * sizeof(PyObject *));
+    }
+    ll->node.count += k;
+    rl->node.count -= k;
+    parent->sizes[left] += k;
+    parent->sizes[left + 1] -= k;
+    return 0;
+  }
+  lb = (BTreeListBranch *)parent->children[left];
+  rb = (BTreeListBranch *)parent->children[left + 1];
+  if (total <= capacity) {
+    memcpy(lb->children + lb->node.count, rb->children,
+           rb->node.count * sizeof(BTreeListNode *));
+    memcpy(lb->sizes + lb->node.count, rb->sizes,
+           rb->node.count * sizeof(Py_ssize_t));
+    lb->node.count = total;
+    NodePool_free(&BTreeListBranch_pool, rb);
+    goto merged;
+  }
+  k = total / 2 - lb->node.count;
+  moved = 0;
+  if (k > 0) {
+    for (j = 0; j < k; ++j) {
+      moved += rb->sizes[j];
+    }
+    memcpy(lb->children + lb->node.count, rb->children,
+           k * sizeof(BTreeListNode *));
+    memcpy(lb->sizes + lb->node.count, rb->sizes, k * sizeof(Py_ssize_t));
+    memmove(rb->children, rb->children + k,
+            (rb->node.count - k) * sizeof(BTreeListNode *));
+    memmove(rb->sizes, rb->sizes + k,
+            (rb->node.count - k) * sizeof(Py_ssize_t));
+  }
+  else {
+    for (j = total / 2; j < lb->node.count; ++j) {
+      moved -= lb->sizes[j];
+    }
+    memmove(rb->children - k, rb->children,
+            rb->node.count * sizeof(BTreeListNode *));
+    memmove(rb->sizes - k, rb->sizes, rb->node.count * sizeof(Py_ssize_t));
+    memcpy(rb->children, lb->children + total / 2,
+           -k * sizeof(BTreeListNode *));
+    memcpy(rb->sizes, lb->sizes + total / 2, -k * sizeof(Py_ssize_t));
+  }
+  lb->node.count += k;
+  rb->node.count -= k;
+  parent->sizes[left] += moved;
+  parent->sizes[left + 1] -= moved;
+  return 0;
+
+merged:
+  parent->sizes[left] += parent->sizes[left + 1];
+  memmove(parent->children + left + 1, parent->children + left + 2,
+          (parent->node.count - left - 2) * sizeof(BTreeListNode *));
+  memmove(parent->sizes + left + 1, parent->sizes + left + 2,
+          (parent->node.count - left - 2) * sizeof(Py_ssize_t));
+  --parent->node.count;
+  return 1;
+}
+
+/* Removes and returns the item at index, which must be in range. */
+static PyObject *
+BTreeList_remove_index(BTreeList *self, Py_ssize_t index)
+{
+  BTreeListBranch *path[BTREELIST_MAX_HEIGHT], *b;
+  BTreeListLeaf *leaf;
+  BTreeListNode *n;
+  PyObject *item;
+  int slots[BTREELIST_MAX_HEIGHT];
+  int depth = 0, h, i;
 
-/* SinglyLinkedList2
- * Resizable singly-linked-node-based implementation of the List interface.
- * Uses a tail pointer to make appending more efficient. */
-typedef struct {
-  PyObject_HEAD
-  SinglyLinkedListNode *head;
-  SinglyLinkedListNode *tail;
-  Py_ssize_t size;
-  long state;
-} SinglyLinkedList2;
+  n = self->root;
+  for (h = self->height; h > 0; --h) {
+    b = (BTreeListBranch *)n;
+    for (i = 0; index >= b->sizes[i]; ++i) {
+      index -= b->sizes[i];
+    }
+    --b->sizes[i];
+    path[depth] = b;
+    slots[depth] = i;
+    ++depth;
+    n = b->children[i];
+  }
+  leaf = (BTreeListLeaf *)n;
+  item = leaf->items[index];
+  memmove(leaf->items + index, leaf->items + index + 1,
+          (leaf->node.count - index - 1) * sizeof(PyObject *));
+  LISTSTATS_ADD(self, walked, self->height);
+  LISTSTATS_ADD(self, shifted, leaf->node.count - index - 1);
+  --leaf->node.count;
+  for (h = 0; depth > 0; ++h) {
+    --depth;
+    if (BTreeListBranch_fix_child(path[depth], slots[depth], h)) {
+      LISTSTATS_ADD(self, frees, 1);
+    }
+  }
+  while (self->height > 0 && self->root->count == 1) {
+    b = (BTreeListBranch *)self->root;
+    self->root = b->children[0];
+    --self->height;
+    NodePool_free(&BTreeListBranch_pool, b);
+    LISTSTATS_ADD(self, frees, 1);
+  }
+  --self->size;
+  ++self->state;
+  return item;
+}
 
-PyDoc_STRVAR(SinglyLinkedList2_doc,
-  "Resizable singly-linked-node-based implementation of the List interface.\n"
-  "Uses a tail pointer to make appending more efficient.");
+/* Appends the tree at *rootp, holding size items with leaves *heightp
+ * levels down, to this list, taking ownership of it.  The shorter tree is
+ * hung off the facing edge of the taller one at the matching height,
+ * splitting full nodes on the way down.  On failure the tree at *rootp,
+ * which may have gained a level, still belongs to the caller. */
+static int
+BTreeList_join(BTreeList *self, BTreeListNode **rootp, int *heightp,
+               Py_ssize_t size)
+{
+  BTreeListBranch *path[BTREELIST_MAX_HEIGHT], *b;
+  BTreeListLeaf *last, *first;
+  BTreeListNode **tallp, *n, *shorter;
+  Py_ssize_t tall_size, short_size;
+  int slots[BTREELIST_MAX_HEIGHT];
+  int *tall_heightp, short_height, append, depth = 0, h, i;
 
-/* SinglyLinkedList2Type.tp_new */
+  LISTSTATS_ADD(self, allocs, BTreeListNode_count(*rootp, *heightp));
+  if (size == 0) {
+    LISTSTATS_ADD(self, frees, 1);
+    BTreeListNode_free(*rootp, *heightp);
+    return 0;
+  }
+  if (self->size == 0) {
+    LISTSTATS_ADD(self, frees, 1);
+    BTreeListNode_free(self->root, self->height);
+    self->root = *rootp;
+    self->height = *heightp;
+    goto joined;
+  }
+  last = BTreeListNode_edge_leaf(self->root, self->height, 1);
+  first = BTreeListNode_edge_leaf(*rootp, *heightp, 0);
+  if (self->height == *heightp) {
+    b = BTreeListBranch_alloc();
+    if (b == NULL) {
+      PyErr_NoMemory();
+      return -1;
+    }
+    b->node.count = 2;
+    b->children[0] = self->root;
+    b->sizes[0] = self->size;
+    b->children[1] = *rootp;
+    b->sizes[1] = size;
+    LISTSTATS_ADD(self, allocs, 1);
+    self->root = &b->node;
+    ++self->height;
+    last->next = first;
+    goto joined;
+  }
+  append = self->height > *heightp;
+  if (append) {
+    tallp = &self->root;
+    tall_heightp = &self->height;
+    tall_size = self->size;
+    shorter = *rootp;
+    short_height = *heightp;
+    short_size = size;
+  }
+  else {
+    tallp = rootp;
+    tall_heightp = heightp;
+    tall_size = size;
+    shorter = self->root;
+    short_height = self->height;
+    short_size = self->size;
+  }
+  if ((*tallp)->count == BTREELIST_BRANCH_CAPACITY) {
+    if (BTreeListNode_grow(tallp, tall_heightp, tall_size) < 0) {
+      return -1;
+    }
+    LISTSTATS_ADD(self, allocs, 2);
+  }
+  n = *tallp;
+  for (h = *tall_heightp; h > short_height + 1; --h) {
+    b = (BTreeListBranch *)n;
+    i = append ? b->node.count - 1 : 0;
+    if (b->children[i]->count == BTREELIST_BRANCH_CAPACITY) {
+      if (BTreeListBranch_split_child(b, i, h - 1) < 0) {
+        return -1;
+      }
+      LISTSTATS_ADD(self, allocs, 1);
+      i = append ? b->node.count - 1 : 0;
+    }
+    path[depth] = b;
+    slots[depth] = i;
+    ++depth;
+    n = b->children[i];
+  }
+  b = (BTreeListBranch *)n;
+  i = append ? b->node.count : 0;
+  memmove(b->children + i + 1, b->children + i,
+          (b->node.count - i) * sizeof(BTreeListNode *));
+  memmove(b->sizes + i + 1, b->sizes + i,
+          (b->node.count - i) * sizeof(Py_ssize_t));
+  b->children[i] = shorter;
+  b->sizes[i] = short_size;
+  ++b->node.count;
+  while (depth > 0) {
+    --depth;
+    path[depth]->sizes[slots[depth]] += short_size;
+  }
+  if (!append) {
+    self->root = *rootp;
+    self->height = *heightp;
+  }
+  last->next = first;
+
+joined:
+  self->size += size;
+  ++self->state;
+  LISTSTATS_PEAK(self);
+  return 0;
+}
+
+/* BTreeListType.tp_new */
 static PyObject *
-SinglyLinkedList2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+BTreeList_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-  SinglyLinkedList2 *self;
-
-  self = (SinglyLinkedList2 *)type->tp_alloc(type, 0);
-  if (self == NULL)
-      return NULL;
+  BTreeList *self;
 
-  self->head = NULL;
-  self->tail = NULL;
+  self = (BTreeList *)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+  self->root = BTreeListNode_new_leaf();
+  if (self->root == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
   self->size = 0;
+  self->height = 0;
   self->state = 0;
-
   return (PyObject *)self;
 }
 
-/* SinglyLinkedList2Type.tp_init */
+/* BTreeListType.tp_init */
 static int
-SinglyLinkedList2_init(SinglyLinkedList2 *self, PyObject *args, PyObject *kwds)
+BTreeList_init(BTreeList *self, PyObject *args, PyObject *kwds)
 {
   return 0;
 }
 
-/* SinglyLinkedList2Type.tp_dealloc */
-static void
-SinglyLinkedList2_dealloc(SinglyLinkedList2 *self)
+/* BTreeListType.tp_vectorcall
+ * The constructor takes no arguments, so the common call allocates the list
+ * directly. */
+static PyObject *
+BTreeList_vectorcall(PyObject *type, PyObject *const *args, size_t nargsf,
+                     PyObject *kwnames)
 {
-  SinglyLinkedListNode *n, *tmp;
+  if (type != (PyObject *)&BTreeListType || PyVectorcall_NARGS(nargsf) != 0 ||
+      (kwnames != NULL && PyTuple_GET_SIZE(kwnames) != 0)) {
+    return List_vectorcall_fallback(type, args, nargsf, kwnames);
+  }
+  return BTreeList_new((PyTypeObject *)type, NULL, NULL);
+}
 
-  n = self->head;
-  while (n) {
-      Py_XDECREF(n->data);
-      tmp = n;
-      n = n->next;
-      PyMem_Free(tmp);
+/* BTreeListType.tp_traverse */
+static int
+BTreeList_traverse(BTreeList *self, visitproc visit, void *arg)
+{
+  BTreeListLeaf *leaf;
+  int i;
+
+  if (self->root == NULL) {
+    return 0;
+  }
+  leaf = BTreeListNode_edge_leaf(self->root, self->height, 0);
+  for (; leaf != NULL; leaf = leaf->next) {
+    for (i = 0; i < leaf->node.count; ++i) {
+      Py_VISIT(leaf->items[i]);
+    }
+  }
+  return 0;
+}
+
+/* BTreeListType.tp_clear
+ * Swaps in an empty root before releasing the old tree's items, which can
+ * run arbitrary code.  If no leaf can be allocated for the new root, the
+ * items are instead removed from the end one at a time, which allocates
+ * nothing. */
+static int
+BTreeList_tp_clear(BTreeList *self)
+{
+  BTreeListNode *root, *old_root;
+  PyObject *item;
+  int old_height;
+
+  if (self->root == NULL) {
+    return 0;
+  }
+  root = BTreeListNode_new_leaf();
+  if (root == NULL) {
+    PyErr_Clear();
+    while (self->size > 0) {
+      item = BTreeList_remove_index(self, self->size - 1);
+      Py_DECREF(item);
+    }
+    return 0;
+  }
+  old_root = self->root;
+  old_height = self->height;
+  self->root = root;
+  self->height = 0;
+  self->size = 0;
+  ++self->state;
+  LISTSTATS_ADD(self, allocs, 1);
+  LISTSTATS_ADD(self, frees, BTreeListNode_count(old_root, old_height));
+  BTreeListNode_free(old_root, old_height);
+  return 0;
+}
+
+/* BTreeListType.tp_dealloc */
+static void
+BTreeList_dealloc(BTreeList *self)
+{
+  PyObject_GC_UnTrack(self);
+  if (self->root != NULL) {
+    BTreeListNode_free(self->root, self->height);
   }
   Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
-/* SinglyLinkedList2.append(item) */
+/* BTreeList.append(item) */
 static PyObject *
-SinglyLinkedList2_append(SinglyLinkedList2 *self, PyObject *item)
+BTreeList_append(BTreeList *self, PyObject *item)
 {
-  SinglyLinkedListNode *n;
+  if (BTreeList_insert_index(self, self->size, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
 
-  ++self->state;
-  n = PyMem_Malloc(sizeof(SinglyLinkedListNode));
-  if (n == NULL) {
-      PyErr_NoMemory();
-      return NULL;
+/* BTreeList.clear() */
+static PyObject *
+BTreeList_clear(BTreeList *self)
+{
+  BTreeList_tp_clear(self);
+  Py_RETURN_NONE;
+}
+
+/* BTreeList.extend(iterable)
+ * A few items are inserted one at a time; more are bulk-loaded into a tree
+ * of their own, which is then joined on, so the leaves stay well filled. */
+static PyObject *
+BTreeList_extend(BTreeList *self, PyObject *iterable)
+{
+  BTreeListNode *root;
+  PyObject *seq, **items;
+  Py_ssize_t n, i;
+  int height;
+
+  seq = PySequence_Fast(iterable,
+                        "BTreeList.extend() argument must be iterable");
+  if (seq == NULL) {
+    return NULL;
   }
-  n->next = NULL;
-  Py_INCREF(item);
-  ++self->size;
-  n->data = item;
-  if (self->head == NULL) {
-    self->head = self->tail = n;
+  n = PySequence_Fast_GET_SIZE(seq);
+  items = PySequence_Fast_ITEMS(seq);
+  if (n < BTREELIST_LEAF_CAPACITY) {
+    for (i = 0; i < n; ++i) {
+      if (BTreeList_insert_index(self, self->size, items[i]) < 0) {
+        Py_DECREF(seq);
+        return NULL;
+      }
+    }
+    Py_DECREF(seq);
+    Py_RETURN_NONE;
   }
-  else {
-    self->tail->next = n;
-    self->tail = n;
+  if (BTreeListNode_build(items, n, &root, &height) < 0) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  Py_DECREF(seq);
+  if (BTreeList_join(self, &root, &height, n) < 0) {
+    BTreeListNode_free(root, height);
+    return NULL;
   }
   Py_RETURN_NONE;
 }
 
-/* SinglyLinkedList2.clear() */
+/* BTreeList.from_iterable(iterable) */
 static PyObject *
-SinglyLinkedList2_clear(SinglyLinkedList2 *self)
+BTreeList_from_iterable(PyTypeObject *type, PyObject *iterable)
 {
-  SinglyLinkedListNode *n, *tmp;
+  PyObject *self, *result;
 
-  n = self->head;
-  while (n) {
-      Py_XDECREF(n->data);
-      tmp = n;
-      n = n->next;
-      PyMem_Free(tmp);
+  self = PyObject_CallNoArgs((PyObject *)type);
+  if (self == NULL) {
+    return NULL;
   }
-  self->head = NULL;
-  self->tail = NULL;
-  self->size = 0;
-  self->state = 0;
-  Py_RETURN_NONE;
+  result = BTreeList_extend((BTreeList *)self, iterable);
+  if (result == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  Py_DECREF(result);
+  return self;
 }
 
-/* SinglyLinkedList2.get(index) */
+/* BTreeListType.tp_as_sequence->sq_item */
 static PyObject *
-SinglyLinkedList2_get(SinglyLinkedList2 *self, PyObject *indexobj)
+BTreeList_item(BTreeList *self, Py_ssize_t index)
 {
-  SinglyLinkedListNode *n;
+  BTreeListLeaf *leaf;
   PyObject *item;
-  Py_ssize_t index = -1;
-  int i;
 
-  if (indexobj != NULL && indexobj != Py_None) {
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "BTreeList index out of range");
+    return NULL;
+  }
+  leaf = BTreeList_leaf_at(self, &index);
+  item = leaf->items[index];
+  Py_INCREF(item);
+  return item;
+}
+
+/* BTreeList.get(index) */
+static PyObject *
+BTreeList_get(BTreeList *self, PyObject *indexobj)
+{
+  Py_ssize_t index;
+
   index = PyLong_AsSsize_t(indexobj);
-  if (index == -1 && PyErr_Occurred())
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  return BTreeList_item(self, index);
+}
+
+/* BTreeList.insert(index, item) */
+static PyObject *
+BTreeList_insert(BTreeList *self, PyObject *const *args, Py_ssize_t nargs)
+{
+  Py_ssize_t index;
+
+  if (!List_check_nargs("insert", nargs, 2)) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
     return NULL;
   }
   if (index < 0 || index > self->size - 1) {
-  PyErr_SetString(PyExc_IndexError, "LinkedList index out of range");
-  return NULL;
+    PyErr_SetString(PyExc_IndexError, "BTreeList index out of range");
+    return NULL;
+  }
+  if (BTreeList_insert_index(self, index, args[1]) < 0) {
+    return NULL;
   }
+  Py_RETURN_NONE;
+}
 
-  n = self->head;
-  for (i = 0; i < index; ++i)
-  n = n->next;
-  item = n->data;
+/* BTreeList.prepend(item) */
+static PyObject *
+BTreeList_prepend(BTreeList *self, PyObject *item)
+{
+  if (BTreeList_insert_index(self, 0, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* BTreeList.remove(index) */
+static PyObject *
+BTreeList_remove(BTreeList *self, PyObject *indexobj)
+{
+  Py_ssize_t index;
+
+  index = PyLong_AsSsize_t(indexobj);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "BTreeList index out of range");
+    return NULL;
+  }
+  return BTreeList_remove_index(self, index);
+}
+
+/* BTreeListType.tp_as_sequence->sq_ass_item
+ * Assigns item at index, or deletes the item at index if item is NULL. */
+static int
+BTreeList_ass_item(BTreeList *self, Py_ssize_t index, PyObject *item)
+{
+  BTreeListLeaf *leaf;
+  PyObject *old_item;
+
+  if (index < 0 || index > self->size - 1) {
+    PyErr_SetString(PyExc_IndexError, "BTreeList index out of range");
+    return -1;
+  }
+  if (item == NULL) {
+    old_item = BTreeList_remove_index(self, index);
+    Py_DECREF(old_item);
+    return 0;
+  }
+  leaf = BTreeList_leaf_at(self, &index);
+  ++self->state;
+  old_item = leaf->items[index];
   Py_INCREF(item);
-  return item;
+  leaf->items[index] = item;
+  Py_DECREF(old_item);
+  return 0;
 }
 
-static PyObject * SinglyLinkedList2_prepend(SinglyLinkedList2 *self, PyObject *item);
+/* BTreeList.set(index, item) */
+static PyObject *
+BTreeList_set(BTreeList *self, PyObject *const *args, Py_ssize_t nargs)
+{
+  Py_ssize_t index;
 
-/* SinglyLinkedList2.insert(index, item) */
+  if (!List_check_nargs("set", nargs, 2)) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (BTreeList_ass_item(self, index, args[1]) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* BTreeList.size() */
+static PyObject *
+BTreeList_size(BTreeList *self)
+{
+  return PyLong_FromSsize_t(self->size);
+}
+
+#if EDUCOLLECTIONS_STATS
+/* BTreeList.stats() */
+static PyObject *
+BTreeList_stats(BTreeList *self)
+{
+  return ListStats_dict(&self->stats);
+}
+
+/* BTreeList.reset_stats() */
+static PyObject *
+BTreeList_reset_stats(BTreeList *self)
+{
+  ListStats_reset(&self->stats, self->size);
+  Py_RETURN_NONE;
+}
+#endif
+
+/* BTreeListType.tp_as_sequence->sq_length */
+static Py_ssize_t
+BTreeList_length(BTreeList *self)
+{
+  return self->size;
+}
+
+/* BTreeListType.tp_as_sequence->sq_contains
+ * A comparison that mutates this BTreeList may free or split the leaf being
+ * visited, so that raises RuntimeError. */
+static int
+BTreeList_contains(BTreeList *self, PyObject *item)
+{
+  BTreeListLeaf *leaf;
+  long state = self->state;
+  int cmp = 0, i;
+
+  leaf = BTreeListNode_edge_leaf(self->root, self->height, 0);
+  for (; cmp == 0 && leaf; leaf = leaf->next) {
+    for (i = 0; cmp == 0 && i < leaf->node.count; ++i) {
+      cmp = List_item_eq(leaf->items[i], item);
+      if (cmp >= 0 && self->state != state) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "BTreeList mutated during search");
+        return -1;
+      }
+    }
+  }
+  return cmp;
+}
+
+/* BTreeListType.tp_as_mapping->mp_subscript
+ * The selected items are gathered along the leaf chain from the first of
+ * them and bulk-loaded into the new BTreeList. */
 static PyObject *
-SinglyLinkedList2_insert(SinglyLinkedList2 *self, PyObject *args)
+BTreeList_subscript(BTreeList *self, PyObject *key)
 {
-  SinglyLinkedListNode *n, *tmp;
-  PyObject *indexobj = NULL, *itemobj = NULL;
-  Py_ssize_t index = -1;
-  int i;
+  BTreeList *result;
+  BTreeListLeaf *leaf;
+  BTreeListNode *root;
+  PyObject **items;
+  Py_ssize_t index, start, stop, step, slicelength, offset, stride, j;
+  int height;
 
-  if (!PyArg_ParseTuple(args, "OO", &indexobj, &itemobj)) {
-  return NULL;
+  if (PyIndex_Check(key)) {
+    index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (index == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+    if (index < 0) {
+      index += self->size;
+    }
+    return BTreeList_item(self, index);
   }
-  if (indexobj != NULL && indexobj != Py_None) {
-  index = PyLong_AsSsize_t(indexobj);
-  if (index == -1 && PyErr_Occurred())
+  if (!PySlice_Check(key)) {
+    PyErr_Format(PyExc_TypeError,
+                 "BTreeList indices must be integers or slices, not %.200s",
+                 Py_TYPE(key)->tp_name);
     return NULL;
   }
-  if (index < 0 || index > self->size - 1) {
-  PyErr_SetString(PyExc_IndexError, "SinglyLinkedList2 index out of range");
-  return NULL;
+  if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+    return NULL;
   }
-  if (itemobj == NULL) {
-  PyErr_SetString(PyExc_ValueError, "item == NULL");
-  return NULL;
+  slicelength = PySlice_AdjustIndices(self->size, &start, &stop, step);
+  result = (BTreeList *)PyObject_CallNoArgs((PyObject *)Py_TYPE(self));
+  if (result == NULL || slicelength <= 0) {
+    return (PyObject *)result;
   }
-
-  if (index == 0)
-  return SinglyLinkedList2_prepend(self, itemobj);
-  n = self->head;
-  for (i = 0; i < index - 1; ++i)
-  n = n->next;
-  tmp = PyMem_Malloc(sizeof(SinglyLinkedListNode));
-  if (tmp == NULL) {
-    PyErr_NoMemory();
+  items = PyMem_New(PyObject *, slicelength);
+  if (items == NULL) {
+    Py_DECREF(result);
+    return PyErr_NoMemory();
+  }
+  if (step < 0) {
+    offset = start + (slicelength - 1) * step;
+    stride = -step;
+  }
+  else {
+    offset = start;
+    stride = step;
+  }
+  leaf = BTreeList_leaf_at(self, &offset);
+  for (j = 0; j < slicelength; ++j) {
+    while (offset >= leaf->node.count) {
+      offset -= leaf->node.count;
+      leaf = leaf->next;
+    }
+    items[step < 0 ? slicelength - 1 - j : j] = leaf->items[offset];
+    offset += stride;
+  }
+  if (BTreeListNode_build(items, slicelength, &root, &height) < 0) {
+    PyMem_Del(items);
+    Py_DECREF(result);
     return NULL;
   }
-  ++self->state;
-  ++self->size;
-  Py_INCREF(itemobj);
-  tmp->data = itemobj;
-  tmp->next = n->next;
-  n->next = tmp;
-  Py_RETURN_NONE;
+  PyMem_Del(items);
+  BTreeListNode_free(result->root, result->height);
+  result->root = root;
+  result->height = height;
+  result->size = slicelength;
+  LISTSTATS_ADD(result, allocs, BTreeListNode_count(root, height));
+  LISTSTATS_PEAK(result);
+  return (PyObject *)result;
 }
 
-/* SinglyLinkedList2.prepend(item) */
+/* BTreeListType.tp_as_sequence->sq_inplace_concat */
 static PyObject *
-SinglyLinkedList2_prepend(SinglyLinkedList2 *self, PyObject *item)
+BTreeList_inplace_concat(BTreeList *self, PyObject *other)
 {
-  SinglyLinkedListNode *n;
+  PyObject *result;
 
-  ++self->state;
-  n = PyMem_Malloc(sizeof(SinglyLinkedListNode));
-  if (n == NULL) {
-      PyErr_NoMemory();
-      return NULL;
+  result = BTreeList_extend(self, other);
+  if (result == NULL) {
+    return NULL;
   }
-  n->next = self->head;
-  Py_INCREF(item);
-  ++self->size;
-  n->data = item;
-  if (self->head == self->tail)
-    self->tail = n;
-  self->head = n;
-  Py_RETURN_NONE;
+  Py_DECREF(result);
+  Py_INCREF(self);
+  return (PyObject *)self;
 }
 
-/* SinglyLinkedList2.remove(index) */
+/* BTreeListIterator
+ * Iterates over a BTreeList along its leaf chain, raising if the list is
+ * mutated before iteration ends. */
+typedef struct {
+  PyObject_HEAD
+  BTreeList     *list;
+  BTreeListLeaf *leaf;
+  int           offset;
+  long          state;
+} BTreeListIterator;
+
+/* BTreeListType.tp_iter */
 static PyObject *
-SinglyLinkedList2_remove(SinglyLinkedList2 *self, PyObject *indexobj)
+BTreeList_iter(BTreeList *self)
 {
-  PyObject *item;
-  SinglyLinkedListNode *n, *remove;
-  Py_ssize_t index = -1;
-  int i;
+  BTreeListIterator *it;
 
-  if (indexobj != NULL && indexobj != Py_None) {
-  index = PyLong_AsSsize_t(indexobj);
-  if (index == -1 && PyErr_Occurred())
+  it = PyObject_GC_New(BTreeListIterator, &BTreeListIteratorType);
+  if (it == NULL) {
     return NULL;
   }
-  if (index < 0 || index > self->size - 1) {
-  PyErr_SetString(PyExc_IndexError, "SinglyLinkedList2 index out of range");
-  return NULL;
-  }
+  Py_INCREF(self);
+  it->list = self;
+  it->leaf = BTreeListNode_edge_leaf(self->root, self->height, 0);
+  it->offset = 0;
+  it->state = self->state;
+  PyObject_GC_Track(it);
+  return (PyObject *)it;
+}
 
-  if (index == 0) {
-    if (self->size == 0) {
-      PyErr_SetString(PyExc_IndexError, "remove from an empty LinkedList");
-      return NULL;
-    }
-    item = self->head->data;
-    --self->size;
-    ++self->state;
-    n = self->head;
-    self->head = self->head->next;
-    if (self->size == 0) {
-      self->tail = NULL;
-    }
-    PyMem_Free(n);
-    return item;
-  }
-  if (index == self->size - 1) {
-    if (self->size == 0) {
-      PyErr_SetString(PyExc_IndexError, "remove from an empty LinkedList");
-      return NULL;
-    }
-    item = self->tail->data;
-    n = self->head;
-    for (i = 0; i < self->size - 2; ++i) {
-      n = n->next;
-    }
-    PyMem_Free(n->next);
-    --self->size;
-    ++self->state;
-    if (self->size == 0) {
-      self->head = self->tail = NULL;
-    } else {
-      self->tail = n;
-      self->tail->next = NULL;
-    }
-    return item;
-  }
+/* BTreeListIteratorType.tp_dealloc */
+static void
+BTreeListIterator_dealloc(BTreeListIterator *self)
+{
+  PyObject_GC_UnTrack(self);
+  Py_XDECREF(self->list);
+  PyObject_GC_Del(self);
+}
 
-  n = self->head;
-  for (i = 0; i < index - 1; ++i) {
-    n = n->next;
-  }
-  remove = n->next;
-  item = remove->data;
-  n->next = remove->next;
-  PyMem_Free(remove);
-  --self->size;
-  ++self->state;
-  return item;
+/* BTreeListIteratorType.tp_traverse */
+static int
+BTreeListIterator_traverse(BTreeListIterator *self, visitproc visit, void *arg)
+{
+  Py_VISIT(self->list);
+  return 0;
 }
 
-/* SinglyLinkedList2.set(index, item) */
+/* BTreeListIteratorType.tp_clear
+ * The cursor points into the list, so it is dropped with it. */
+static int
+BTreeListIterator_clear(BTreeListIterator *self)
+{
+  self->leaf = NULL;
+  Py_CLEAR(self->list);
+  return 0;
+}
+
+/* BTreeListIteratorType.tp_iternext */
 static PyObject *
-SinglyLinkedList2_set(SinglyLinkedList2 *self, PyObject *args)
+BTreeListIterator_next(BTreeListIterator *self)
 {
-  SinglyLinkedListNode *n;
-  PyObject *indexobj = NULL, *itemobj = NULL, *old_item = NULL;
-  Py_ssize_t index = -1;
-  int i;
+  PyObject *item;
 
-  if (!PyArg_ParseTuple(args, "OO", &indexobj, &itemobj)) {
-  return NULL;
+  if (self->list == NULL) {
+    return NULL;
   }
-  if (indexobj != NULL && indexobj != Py_None) {
-  index = PyLong_AsSsize_t(indexobj);
-  if (index == -1 && PyErr_Occurred())
+  if (self->list->state != self->state) {
+    PyErr_SetString(PyExc_RuntimeError, "BTreeList mutated during iteration");
+    self->leaf = NULL;
+    Py_CLEAR(self->list);
     return NULL;
   }
-  if (index < 0 || index > self->size - 1) {
-  PyErr_SetString(PyExc_IndexError, "SinglyLinkedList2 index out of range");
-  return NULL;
+  while (self->leaf != NULL && self->offset >= self->leaf->node.count) {
+    self->leaf = self->leaf->next;
+    self->offset = 0;
   }
-  if (itemobj == NULL) {
-  PyErr_SetString(PyExc_ValueError, "item == NULL");
-  return NULL;
+  if (self->leaf == NULL) {
+    Py_CLEAR(self->list);
+    return NULL;
   }
-
-  n = self->head;
-  for (i = 0; i < index; ++i)
-  n = n->next;
-  ++self->state;
-  old_item = n->data;
-  Py_XDECREF(old_item);
-  Py_INCREF(itemobj);
-  n->data = itemobj;
-  Py_RETURN_NONE;
+  item = self->leaf->items[self->offset++];
+  Py_INCREF(item);
+  return item;
 }
 
-/* SinglyLinkedList2.size() */
-static PyObject *
-SinglyLinkedList2_size(SinglyLinkedList2 *self)
-{
-  return PyLong_FromSsize_t(self->size);
-}
+PyTypeObject BTreeListIteratorType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_educollections.BTreeListIterator",  /* tp_name */
+  sizeof(BTreeListIterator),            /* tp_basicsize */
+  0,                                    /* tp_itemsize */
+  (destructor)BTreeListIterator_dealloc,/* tp_dealloc */
+  0,                                    /* tp_print */
+  0,                                    /* tp_getattr */
+  0,                                    /* tp_setattr */
+  0,                                    /* tp_reserved */
+  0,                                    /* tp_repr */
+  0,                                    /* tp_as_number */
+  0,                                    /* tp_as_sequence */
+  0,                                    /* tp_as_mapping */
+  0,                                    /* tp_hash  */
+  0,                                    /* tp_call */
+  0,                                    /* tp_str */
+  PyObject_GenericGetAttr,              /* tp_getattro */
+  0,                                    /* tp_setattro */
+  0,                                    /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  0,                                    /* tp_doc */
+  (traverseproc)BTreeListIterator_traverse,
+                                        /* tp_traverse */
+  (inquiry)BTreeListIterator_clear,     /* tp_clear */
+  0,                                    /* tp_richcompare */
+  0,                                    /* tp_weaklistoffset */
+  PyObject_SelfIter,                    /* tp_iter */
+  (iternextfunc)BTreeListIterator_next, /* tp_iternext */
+};
 
-/* SinglyLinkedList2Type.tp_repr */
+/* BTreeListType.tp_repr */
 static PyObject *
-SinglyLinkedList2_repr(PyObject *self)
+BTreeList_repr(PyObject *self)
 {
-  /* PyObject *aslist, *result; */
-  /* int i; */
-
-  /* i = Py_ReprEnter(self); */
-  /* if (i != 0) { */
-  /*     if (i < 0) */
-  /*         return NULL; */
-  /*     return PyUnicode_FromString("[...]"); */
-  /* } */
-
-  /* aslist = PySequence_List(self); */
-  /* if (aslist == NULL) { */
-  /*     Py_ReprLeave(self); */
-  /*     return NULL; */
-  /* } */
-  /* result = PyUnicode_FromFormat("%R", aslist); */
-  /* Py_DECREF(aslist); */
-  /* Py_ReprLeave(self); */
-  /* return result; */
   return PyUnicode_FromString("[...]");
 }
 
-/* SinglyLinkedList2Type.tp_str */
+/* BTreeListType.tp_str */
 static PyObject *
-SinglyLinkedList2_str(PyObject *self)
+BTreeList_str(PyObject *self)
 {
-  /* PyObject *aslist, *result; */
-  /* int i; */
-
-  /* i = Py_ReprEnter(self); */
-  /* if (i != 0) { */
-  /*     if (i < 0) */
-  /*         return NULL; */
-  /*     return PyUnicode_FromString("[...]"); */
-  /* } */
-
-  /* aslist = PySequence_List(self); */
-  /* if (aslist == NULL) { */
-  /*     Py_ReprLeave(self); */
-  /*     return NULL; */
-  /* } */
-  /* result = PyUnicode_FromFormat("%R", aslist); */
-  /* Py_DECREF(aslist); */
-  /* Py_ReprLeave(self); */
-  /* return result; */
   return PyUnicode_FromString("[...]");
 }
 
-static PyMethodDef SinglyLinkedList2_methods[] = {
-  {"append",                  (PyCFunction)SinglyLinkedList2_append,
+static PyMethodDef BTreeList_methods[] = {
+  {"append",                  (PyCFunction)BTreeList_append,
       METH_O,                  List_append_doc},
-  {"clear",                   (PyCFunction)SinglyLinkedList2_clear,
+  {"clear",                   (PyCFunction)BTreeList_clear,
       METH_NOARGS,             List_clear_doc},
-  {"get",                     (PyCFunction)SinglyLinkedList2_get,
+  {"extend",                  (PyCFunction)BTreeList_extend,
+      METH_O,                  List_extend_doc},
+  {"from_iterable",           (PyCFunction)BTreeList_from_iterable,
+      METH_O | METH_CLASS,     List_from_iterable_doc},
+  {"get",                     (PyCFunction)BTreeList_get,
       METH_O,                  List_get_doc},
-  {"insert",                  (PyCFunction)SinglyLinkedList2_insert,
-      METH_VARARGS,            List_insert_doc},
-  {"prepend",                 (PyCFunction)SinglyLinkedList2_prepend,
+  {"insert",                  (PyCFunction)BTreeList_insert,
+      METH_FASTCALL,           List_insert_doc},
+  {"prepend",                 (PyCFunction)BTreeList_prepend,
       METH_O,                  List_prepend_doc},
-  {"remove",                  (PyCFunction)SinglyLinkedList2_remove,
+  {"remove",                  (PyCFunction)BTreeList_remove,
       METH_O,                  List_remove_doc},
-  {"set",                     (PyCFunction)SinglyLinkedList2_set,
-      METH_VARARGS,            List_set_doc},
-  {"size",                    (PyCFunction)SinglyLinkedList2_size,
+#if EDUCOLLECTIONS_STATS
+  {"reset_stats",             (PyCFunction)BTreeList_reset_stats,
+      METH_NOARGS,             List_reset_stats_doc},
+#endif
+  {"set",                     (PyCFunction)BTreeList_set,
+      METH_FASTCALL,           List_set_doc},
+  {"size",                    (PyCFunction)BTreeList_size,
       METH_NOARGS,             List_size_doc},
+#if EDUCOLLECTIONS_STATS
+  {"stats",                   (PyCFunction)BTreeList_stats,
+      METH_NOARGS,             List_stats_doc},
+#endif
   {NULL,                      NULL}
 };
 
-PyTypeObject SinglyLinkedListType2 = {
+static PySequenceMethods BTreeList_as_sequence = {
+  (lenfunc)BTreeList_length,            /* sq_length */
+  0,                                    /* sq_concat */
+  0,                                    /* sq_repeat */
+  (ssizeargfunc)BTreeList_item,         /* sq_item */
+  0,                                    /* was_sq_slice */
+  (ssizeobjargproc)BTreeList_ass_item,  /* sq_ass_item */
+  0,                                    /* was_sq_ass_slice */
+  (objobjproc)BTreeList_contains,       /* sq_contains */
+  (binaryfunc)BTreeList_inplace_concat, /* sq_inplace_concat */
+  0,                                    /* sq_inplace_repeat */
+};
+
+static PyMappingMethods BTreeList_as_mapping = {
+  (lenfunc)BTreeList_length,            /* mp_length */
+  (binaryfunc)BTreeList_subscript,      /* mp_subscript */
+  0,                                    /* mp_ass_subscript */
+};
+
+PyTypeObject BTreeListType = {
   PyVarObject_HEAD_INIT(NULL, 0)
-  "_educollections.SinglyLinkedList2",  /* tp_name */
-  sizeof(SinglyLinkedList2),            /* tp_basicsize */
+  "_educollections.BTreeList",          /* tp_name */
+  sizeof(BTreeList),                    /* tp_basicsize */
   0,                                    /* tp_itemsize */
-  (destructor)SinglyLinkedList2_dealloc,/* tp_dealloc */
+  (destructor)BTreeList_dealloc,        /* tp_dealloc */
   0,                                    /* tp_print */
   0,                                    /* tp_getattr */
   0,                                    /* tp_setattr */
   0,                                    /* tp_reserved */
-  SinglyLinkedList2_repr,               /* tp_repr */
+  BTreeList_repr,                       /* tp_repr */
   0,                                    /* tp_as_number */
-  0,                                    /* tp_as_sequence */
-  0,                                    /* tp_as_mapping */
+  &BTreeList_as_sequence,               /* tp_as_sequence */
+  &BTreeList_as_mapping,                /* tp_as_mapping */
   PyObject_HashNotImplemented,          /* tp_hash  */
   0,                                    /* tp_call */
-  SinglyLinkedList2_str,                /* tp_str */
+  BTreeList_str,                        /* tp_str */
   0,                                    /* tp_getattro */
   0,                                    /* tp_setattro */
   0,                                    /* tp_as_buffer */
   Py_TPFLAGS_DEFAULT |
-    Py_TPFLAGS_BASETYPE,                /* tp_flags */
-  SinglyLinkedList2_doc,                /* tp_doc */
-  0,                                    /* tp_traverse */
-  0,                                    /* tp_clear */
+    Py_TPFLAGS_BASETYPE |
+    Py_TPFLAGS_HAVE_GC,                 /* tp_flags */
+  BTreeList_doc,                        /* tp_doc */
+  (traverseproc)BTreeList_traverse,     /* tp_traverse */
+  (inquiry)BTreeList_tp_clear,          /* tp_clear */
   0,                                    /* tp_richcompare */
   0,                                    /* tp_weaklistoffset */
-  0,                                    /* tp_iter */
+  (getiterfunc)BTreeList_iter,          /* tp_iter */
   0,                                    /* tp_iternext */
-  SinglyLinkedList2_methods,            /* tp_methods */
+  BTreeList_methods,                    /* tp_methods */
   0,                                    /* tp_members */
   0,                                    /* tp_getset */
   0,                                    /* tp_base */
@@ -1301,7 +11556,53 @@ PyTypeObject SinglyLinkedListType2 = {
   0,                                    /* tp_descr_get */
   0,                                    /* tp_descr_set */
   0,                                    /* tp_dictoffset */
-  (initproc)SinglyLinkedList2_init,     /* tp_init */
+  (initproc)BTreeList_init,             /* tp_init */
   PyType_GenericAlloc,                  /* tp_alloc */
-  SinglyLinkedList2_new,                /* tp_new */
+  BTreeList_new,                        /* tp_new */
+  PyObject_GC_Del,                      /* tp_free */
+  0,                                    /* tp_is_gc */
+  0,                                    /* tp_bases */
+  0,                                    /* tp_mro */
+  0,                                    /* tp_cache */
+  0,                                    /* tp_subclasses */
+  0,                                    /* tp_weaklist */
+  0,                                    /* tp_del */
+  0,                                    /* tp_version_tag */
+  0,                                    /* tp_finalize */
+  BTreeList_vectorcall,                 /* tp_vectorcall */
 };
+
+/* Node pool statistics */
+
+static NodePool *NodePool_all[] = {
+  &SinglyLinkedListNode_pool,
+  &DoublyLinkedListNode_pool,
+  &UnrolledLinkedListNode_pool,
+  &BTreeListLeaf_pool,
+  &BTreeListBranch_pool,
+  NULL
+};
+
+/* _educollections.node_pool_stats() */
+PyObject *
+NodePool_stats(PyObject *module, PyObject *unused)
+{
+  NodePool **pool;
+  PyObject *result, *stats;
+
+  result = PyDict_New();
+  if (result == NULL) {
+    return NULL;
+  }
+  for (pool = NodePool_all; *pool != NULL; ++pool) {
+    stats = NodePool_stats_dict(*pool);
+    if (stats == NULL ||
+        PyDict_SetItemString(result, (*pool)->name, stats) < 0) {
+      Py_XDECREF(stats);
+      Py_DECREF(result);
+      return NULL;
+    }
+    Py_DECREF(stats);
+  }
+  return result;
+}
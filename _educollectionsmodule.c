@@ -17,16 +17,43 @@ PyDoc_STRVAR(module_doc,
 "\n"
 "Collection Implementations:\n"
 "  ArrayList --- Fixed-size-array-based implementation of the List interface.\n"
+"  ArrayDeque --- Circular-array-based implementation with constant-time ends.\n"
+"  GapBufferList --- Array with a movable gap for constant-time edits at a cursor.\n"
+"  Int64ArrayList --- ArrayList of unboxed 64-bit signed integers.\n"
+"  Float64ArrayList --- ArrayList of unboxed 64-bit floats.\n"
 "  SinglyLinkedList1 --- Resizable singly-linked-node-based implementation of the List interface.\n"
 "  SinglyLinkedList2 --- Uses a tail pointer to make appending more efficient.\n"
+"  DoublyLinkedList --- Constant-time work at both ends; walks from the nearer end.\n"
+"  UnrolledLinkedList --- Linked list whose nodes each hold a small array of items.\n"
+"  IndexableSkipList --- Skip list with O(log n) expected access by index.\n"
+"  BTreeList --- B+tree with O(log n) access and cheap slicing and extending.\n"
+"\n"
+"Functions:\n"
+"  array_list_alloc_stats --- Free-list and inline-buffer counters for ArrayList.\n"
+"  node_pool_stats --- Slab occupancy of the linked-list node pools.\n"
 );
 
+PyDoc_STRVAR(array_list_alloc_stats_doc,
+"Returns counters of ArrayList objects taken from or missing the free list\n"
+"and of item buffers placed inline or on the heap.");
+
+PyDoc_STRVAR(node_pool_stats_doc,
+"Returns slab occupancy statistics for each linked-list node pool.");
+
+static PyMethodDef _educollections_methods[] = {
+  {"array_list_alloc_stats",  (PyCFunction)ArrayList_alloc_stats,
+      METH_NOARGS,             array_list_alloc_stats_doc},
+  {"node_pool_stats",         (PyCFunction)NodePool_stats,
+      METH_NOARGS,             node_pool_stats_doc},
+  {NULL,                      NULL}
+};
+
 static PyModuleDef _educollections_module = {
   PyModuleDef_HEAD_INIT,
   "_educollections",
   module_doc,
   -1,
-  NULL,
+  _educollections_methods,
   NULL,
   NULL,
   NULL,
@@ -54,8 +81,28 @@ PyInit__educollections(void)
   }
 
   ADD_TYPE(ArrayListType, "ArrayList");
+  ADD_TYPE(ArrayDequeType, "ArrayDeque");
+  ADD_TYPE(GapBufferListType, "GapBufferList");
+  ADD_TYPE(Int64ArrayListType, "Int64ArrayList");
+  ADD_TYPE(Float64ArrayListType, "Float64ArrayList");
   ADD_TYPE(SinglyLinkedListType1, "SinglyLinkedList1");
   ADD_TYPE(SinglyLinkedListType2, "SinglyLinkedList2");
+  ADD_TYPE(DoublyLinkedListType, "DoublyLinkedList");
+  ADD_TYPE(UnrolledLinkedListType, "UnrolledLinkedList");
+  ADD_TYPE(IndexableSkipListType, "IndexableSkipList");
+  ADD_TYPE(BTreeListType, "BTreeList");
+
+  if (PyType_Ready(&ArrayListIteratorType) < 0 ||
+      PyType_Ready(&ArrayDequeIteratorType) < 0 ||
+      PyType_Ready(&GapBufferListIteratorType) < 0 ||
+      PyType_Ready(&TypedArrayListIteratorType) < 0 ||
+      PyType_Ready(&SinglyLinkedListIteratorType) < 0 ||
+      PyType_Ready(&DoublyLinkedListIteratorType) < 0 ||
+      PyType_Ready(&UnrolledLinkedListIteratorType) < 0 ||
+      PyType_Ready(&IndexableSkipListIteratorType) < 0 ||
+      PyType_Ready(&BTreeListIteratorType) < 0) {
+    goto fail;
+  }
 
   return m;
 
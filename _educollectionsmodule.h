@@ -7,10 +7,41 @@
  * copy at http://github.com/nkraft/educollections/LICENSE)
  */
 
+/* Build configuration */
+
+/* Per-instance operation counters behind stats()/reset_stats().  Build with
+ * -DEDUCOLLECTIONS_STATS=0 to compile them out. */
+#ifndef EDUCOLLECTIONS_STATS
+#define EDUCOLLECTIONS_STATS 1
+#endif
+
 /* ABCs */
 extern PyTypeObject ListType;
 
 /* Concrete classes */
 extern PyTypeObject ArrayListType;
+extern PyTypeObject ArrayDequeType;
+extern PyTypeObject GapBufferListType;
+extern PyTypeObject Int64ArrayListType;
+extern PyTypeObject Float64ArrayListType;
 extern PyTypeObject SinglyLinkedListType1;
 extern PyTypeObject SinglyLinkedListType2;
+extern PyTypeObject DoublyLinkedListType;
+extern PyTypeObject UnrolledLinkedListType;
+extern PyTypeObject IndexableSkipListType;
+extern PyTypeObject BTreeListType;
+
+/* Iterators */
+extern PyTypeObject ArrayListIteratorType;
+extern PyTypeObject ArrayDequeIteratorType;
+extern PyTypeObject GapBufferListIteratorType;
+extern PyTypeObject TypedArrayListIteratorType;
+extern PyTypeObject SinglyLinkedListIteratorType;
+extern PyTypeObject DoublyLinkedListIteratorType;
+extern PyTypeObject UnrolledLinkedListIteratorType;
+extern PyTypeObject IndexableSkipListIteratorType;
+extern PyTypeObject BTreeListIteratorType;
+
+/* Functions */
+extern PyObject *ArrayList_alloc_stats(PyObject *module, PyObject *unused);
+extern PyObject *NodePool_stats(PyObject *module, PyObject *unused);
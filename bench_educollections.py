@@ -0,0 +1,355 @@
+"""Empirical complexity benchmarks for the educollections List types.
+
+Times append, prepend, insert, get, set, remove and clear on every List
+implementation, plus the builtin list and collections.deque as baselines,
+over a range of sizes.  The collect operation times a full garbage
+collection while the container is alive, which shows what traversing it
+costs the cyclic collector.  For each operation the growth exponent k in
+time ~ n**k is fit by least squares on a log-log scale and mapped to the
+nearest order (O(1), O(n), O(n^2)).
+
+Results can be written as JSON with --json and compared against an earlier
+run with --baseline.  The script exits with status 1 if any operation moved
+to a worse order.  Single timings vary too much from run to run to gate on
+by default; with --tolerance, an operation also fails if it got slower than
+the baseline by more than that fraction (and by more than --floor seconds
+per call) at the largest common size, after the baseline is scaled by how
+much faster or slower this run was overall.
+
+    python3 bench_educollections.py --json bench.json
+    python3 bench_educollections.py --max-size 100000 --baseline bench.json
+    python3 bench_educollections.py --baseline bench.json --min-time 0.05 \
+        --tolerance 1.0
+"""
+
+import argparse
+import collections
+import gc
+import json
+import math
+import statistics
+import platform
+import sys
+import time
+
+import educollections
+
+
+OPERATIONS = ['append', 'prepend', 'insert', 'get', 'set', 'remove', 'clear',
+              'collect']
+
+ORDERS = [(0.0, 'O(1)'), (1.0, 'O(n)'), (2.0, 'O(n^2)')]
+
+# How far the fitted exponent must rise before a move to a worse order is
+# reported, so that an exponent hovering near the boundary between two
+# orders does not flip between them from run to run.
+ORDER_MARGIN = 0.5
+
+
+class Adapter:
+    """Maps the benchmarked operations onto one container type.
+
+    Positional operations (insert, get, set, remove) alternate between the
+    quarter points of the container, see probe(), so that index-walking
+    implementations pay their average cost rather than their best case.
+    """
+
+    def __init__(self, name, build, ops):
+        self.name = name
+        self.build = build
+        self.ops = ops
+
+
+def probe(size, i):
+    """Returns the index the i-th positional call acts on.  Successive calls
+    alternate between the first and third quarter points, so every call
+    walks about half the container from whichever end or cached position
+    (such as a singly linked list's finger) it starts from, where repeating
+    the middle index would let a cache make every call after the first
+    free."""
+    return size // 4 if i % 2 else size * 3 // 4
+
+
+def educollections_adapter(name):
+    cls = getattr(educollections, name)
+    if hasattr(cls, 'capacity'):
+        def build(n):
+            return cls.from_iterable(range(n), growable=True)
+    else:
+        def build(n):
+            return cls.from_iterable(range(n))
+    return Adapter(name, build, {
+        'append': lambda c, i: c.append(i),
+        'prepend': lambda c, i: c.prepend(i),
+        'insert': lambda c, i: c.insert(probe(c.size(), i), i),
+        'get': lambda c, i: c.get(probe(c.size(), i)),
+        'set': lambda c, i: c.set(probe(c.size(), i), i),
+        'remove': lambda c, i: c.remove(probe(c.size(), i)),
+        'clear': lambda c, i: c.clear(),
+        'collect': lambda c, i: gc.collect(),
+    })
+
+
+def builtin_adapter(name, cls):
+    def remove(c, i):
+        del c[probe(len(c), i)]
+
+    def set_(c, i):
+        c[probe(len(c), i)] = i
+
+    return Adapter(name, lambda n: cls(range(n)), {
+        'append': lambda c, i: c.append(i),
+        'prepend': (lambda c, i: c.appendleft(i)) if cls is collections.deque
+                   else (lambda c, i: c.insert(0, i)),
+        'insert': lambda c, i: c.insert(probe(len(c), i), i),
+        'get': lambda c, i: c[probe(len(c), i)],
+        'set': set_,
+        'remove': remove,
+        'clear': lambda c, i: c.clear(),
+        'collect': lambda c, i: gc.collect(),
+    })
+
+
+def all_adapters():
+    adapters = [educollections_adapter(name)
+                for name in educollections.__all__ if name != 'List']
+    adapters.append(builtin_adapter('list', list))
+    adapters.append(builtin_adapter('deque', collections.deque))
+    return adapters
+
+
+def time_operation(adapter, op, n, batch, repeat, min_time):
+    """Returns the best observed time per call of op on a container of
+    size n.
+
+    A single call can take well under a microsecond, which is too short to
+    time on its own, so each repetition times rounds of calls until at least
+    min_time has been spent in timed code, doubling the batch from one round
+    to the next.  Every round builds a fresh container and makes one untimed
+    call so that growth triggered by the build is not charged to the batch.
+    The batch is kept no larger than n for operations that change the size,
+    so it stays within [n/2, 2n] while a round runs, and no larger than 10
+    for collect, whose calls are slow on large containers.  clear is timed
+    over a batch of freshly built containers holding at most about a
+    million items between them."""
+    func = adapter.ops[op]
+    if op == 'clear':
+        limit = max(1, 10 ** 6 // n)
+    elif op == 'collect':
+        limit = 10
+    elif op == 'remove':
+        limit = max(1, n // 2 - 1)
+    elif op in ('get', 'set'):
+        limit = math.inf
+    else:
+        limit = n
+    best = math.inf
+    for _ in range(repeat):
+        total = 0.0
+        calls = 0
+        size = max(1, min(batch, limit))
+        while total < min_time:
+            if op == 'clear':
+                func(adapter.build(1), -1)
+                containers = [adapter.build(n) for _ in range(size)]
+            else:
+                containers = [adapter.build(n)]
+                func(containers[0], -1)
+            gc.disable()
+            try:
+                start = time.perf_counter()
+                if op == 'clear':
+                    for i, container in enumerate(containers):
+                        func(container, i)
+                else:
+                    container = containers[0]
+                    for i in range(size):
+                        func(container, i)
+                elapsed = time.perf_counter() - start
+            finally:
+                gc.enable()
+            del container, containers
+            total += elapsed
+            calls += size
+            size = max(1, min(size * 2, limit))
+        best = min(best, total / calls)
+    return best
+
+
+def fit_exponent(times):
+    """Least-squares slope of log(time) against log(n)."""
+    points = [(math.log(n), math.log(t)) for n, t in times.items() if t > 0]
+    if len(points) < 2:
+        return 0.0
+    mx = sum(x for x, _ in points) / len(points)
+    my = sum(y for _, y in points) / len(points)
+    sxx = sum((x - mx) ** 2 for x, _ in points)
+    sxy = sum((x - mx) * (y - my) for x, y in points)
+    return sxy / sxx if sxx else 0.0
+
+
+def classify(exponent):
+    return min(ORDERS, key=lambda order: abs(order[0] - exponent))[1]
+
+
+def order_rank(order):
+    return [name for _, name in ORDERS].index(order)
+
+
+def run(adapters, operations, sizes, batch, repeat, min_time, fit_from,
+        verbose):
+    results = {}
+    for adapter in adapters:
+        results[adapter.name] = {}
+        for op in operations:
+            times = {}
+            for n in sizes:
+                times[n] = time_operation(adapter, op, n, batch, repeat,
+                                          min_time)
+            # Constant overheads dominate small sizes and flatten the fit,
+            # so only the upper sizes are used when there are enough.
+            fitted = {n: t for n, t in times.items() if n >= fit_from}
+            if len(fitted) < 2:
+                fitted = times
+            exponent = fit_exponent(fitted)
+            results[adapter.name][op] = {
+                'times': {str(n): t for n, t in times.items()},
+                'exponent': round(exponent, 3),
+                'order': classify(exponent),
+            }
+            if verbose:
+                print('%-20s %-8s %-7s k=%5.2f  %.3g s/op at n=%d' % (
+                    adapter.name, op, classify(exponent), exponent,
+                    times[sizes[-1]], sizes[-1]), flush=True)
+    return results
+
+
+def largest_common_size(current, previous):
+    common = set(current['times']) & set(previous['times'])
+    return max(common, key=int) if common else None
+
+
+def run_scale(results, baseline):
+    """Returns the median, over every operation both runs timed, of how much
+    slower it ran in results than in baseline at their largest common size.
+    A change to one container barely moves the median, while a machine that
+    is busier or clocked lower than when baseline was taken moves all of
+    it."""
+    ratios = []
+    for name, ops in results.items():
+        for op, current in ops.items():
+            previous = baseline.get(name, {}).get(op)
+            if previous is None:
+                continue
+            n = largest_common_size(current, previous)
+            if n is not None and previous['times'][n] > 0:
+                ratios.append(current['times'][n] / previous['times'][n])
+    return statistics.median(ratios) if ratios else 1.0
+
+
+def compare(results, baseline, tolerance, floor):
+    """Returns a list of regressions of results against baseline.  A move
+    to a worse order only counts if the exponent rose by ORDER_MARGIN.
+    Timings are only compared if tolerance is not None: the baseline time
+    is scaled by run_scale(), and a slowdown then only counts if it exceeds
+    both tolerance, as a fraction of the scaled time, and floor, in seconds
+    per call, so that jitter on calls that take a fraction of a microsecond
+    is not reported."""
+    regressions = []
+    scale = run_scale(results, baseline) if tolerance is not None else 1.0
+    for name, ops in results.items():
+        for op, current in ops.items():
+            previous = baseline.get(name, {}).get(op)
+            if previous is None:
+                continue
+            if (order_rank(current['order']) > order_rank(previous['order'])
+                    and current['exponent'] - previous['exponent'] >=
+                    ORDER_MARGIN):
+                regressions.append('%s.%s: %s -> %s' % (
+                    name, op, previous['order'], current['order']))
+            n = largest_common_size(current, previous)
+            if tolerance is None or n is None:
+                continue
+            was, now = previous['times'][n] * scale, current['times'][n]
+            if now > was * (1.0 + tolerance) and now - was > floor:
+                regressions.append('%s.%s: %.3g -> %.3g s/op at n=%s' % (
+                    name, op, was, now, n))
+    return regressions
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--types', nargs='+', metavar='TYPE',
+                        help='container types to run (default: all)')
+    parser.add_argument('--ops', nargs='+', choices=OPERATIONS,
+                        default=OPERATIONS, metavar='OP',
+                        help='operations to run (default: all)')
+    parser.add_argument('--min-size', type=int, default=10)
+    parser.add_argument('--max-size', type=int, default=10 ** 6)
+    parser.add_argument('--batch', type=int, default=100,
+                        help='calls timed in the first round of each '
+                             'repetition (default: 100)')
+    parser.add_argument('--repeat', type=int, default=5,
+                        help='repetitions per size; the best is kept')
+    parser.add_argument('--min-time', type=float, default=0.005,
+                        help='seconds of timed calls per repetition '
+                             '(default: 0.005)')
+    parser.add_argument('--json', metavar='PATH',
+                        help='write results as JSON to PATH ("-" for stdout)')
+    parser.add_argument('--baseline', metavar='PATH',
+                        help='JSON from an earlier run to check against')
+    parser.add_argument('--tolerance', type=float,
+                        help='also fail on a slowdown against the baseline '
+                             'of more than this fraction (default: only '
+                             'fail on a worse order)')
+    parser.add_argument('--floor', type=float, default=1e-7,
+                        help='slowdowns of at most this many seconds per '
+                             'call are ignored (default: 1e-7)')
+    args = parser.parse_args(argv)
+
+    sizes = []
+    n = args.min_size
+    while n <= args.max_size:
+        sizes.append(n)
+        n *= 10
+    if not sizes:
+        parser.error('--min-size must not exceed --max-size')
+
+    adapters = all_adapters()
+    if args.types:
+        known = {adapter.name for adapter in adapters}
+        unknown = set(args.types) - known
+        if unknown:
+            parser.error('unknown types: %s' % ', '.join(sorted(unknown)))
+        adapters = [a for a in adapters if a.name in args.types]
+
+    results = run(adapters, args.ops, sizes, args.batch, args.repeat,
+                  args.min_time, fit_from=min(1000, sizes[-1]),
+                  verbose=args.json != '-')
+    report = {
+        'python': platform.python_version(),
+        'platform': platform.platform(),
+        'sizes': sizes,
+        'results': results,
+    }
+    if args.json == '-':
+        json.dump(report, sys.stdout, indent=2)
+        print()
+    elif args.json:
+        with open(args.json, 'w') as f:
+            json.dump(report, f, indent=2)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)['results']
+        regressions = compare(results, baseline, args.tolerance,
+                              args.floor)
+        for regression in regressions:
+            print('REGRESSION', regression, file=sys.stderr)
+        if regressions:
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
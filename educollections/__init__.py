@@ -7,11 +7,18 @@
 """Collections for demonstrating order notation."""
 
 
-__all__ = ['List', 'ArrayList', 'SinglyLinkedList1', 'SinglyLinkedList2']
+__all__ = ['List', 'ArrayList', 'ArrayDeque', 'GapBufferList',
+           'Int64ArrayList', 'Float64ArrayList', 'SinglyLinkedList1',
+           'SinglyLinkedList2', 'DoublyLinkedList', 'UnrolledLinkedList',
+           'IndexableSkipList', 'BTreeList']
 
 
 import abc
-from _educollections import ArrayList, SinglyLinkedList1, SinglyLinkedList2
+from _educollections import (ArrayList, ArrayDeque, GapBufferList,
+                             Int64ArrayList, Float64ArrayList,
+                             SinglyLinkedList1, SinglyLinkedList2,
+                             DoublyLinkedList, UnrolledLinkedList,
+                             IndexableSkipList, BTreeList)
 
 
 class Collection(metaclass=abc.ABCMeta):
@@ -57,5 +64,13 @@ class List(Collection):
 
 
 List.register(ArrayList)
+List.register(ArrayDeque)
+List.register(GapBufferList)
+List.register(Int64ArrayList)
+List.register(Float64ArrayList)
 List.register(SinglyLinkedList1)
 List.register(SinglyLinkedList2)
+List.register(DoublyLinkedList)
+List.register(UnrolledLinkedList)
+List.register(IndexableSkipList)
+List.register(BTreeList)
@@ -1,4 +1,16 @@
-from educollections import ArrayList
+import array
+import gc
+import random
+import weakref
+
+import _educollections
+
+import educollections
+from educollections import (ArrayDeque, ArrayList, BTreeList,
+                            DoublyLinkedList, Float64ArrayList, GapBufferList,
+                            IndexableSkipList, Int64ArrayList,
+                            SinglyLinkedList1, SinglyLinkedList2,
+                            UnrolledLinkedList)
 
 
 def print_list_state(lst):
@@ -51,3 +63,647 @@ for i in [2, 3, 0, 7, 8]:
     print('Insert', i + 10, 'at index', i)
     arr.insert(i, i + 10)
     print_list_state(arr)
+
+arr = ArrayList(2, growable=True, shrink_threshold=0.25)
+print('Capacity is', arr.capacity())
+
+for i in range(10):
+    print('Append', i)
+    arr.append(i)
+    print('Capacity is', arr.capacity())
+print_list_state(arr)
+
+for i in range(8):
+    item = arr.remove(0)
+    print('Removed', item, 'from index', 0)
+    print('Capacity is', arr.capacity())
+print_list_state(arr)
+
+arr.reserve(20)
+print('Capacity after reserve(20) is', arr.capacity())
+arr.shrink_to_fit()
+print('Capacity after shrink_to_fit() is', arr.capacity())
+
+for cls in [ArrayList, SinglyLinkedList1, SinglyLinkedList2]:
+    print(cls.__name__)
+    lst = cls.from_iterable(range(10))
+    print('Removed', lst.remove_if(lambda x: x % 3 == 0), 'multiples of 3')
+    print('Items are', list(lst))
+    assert list(lst) == [1, 2, 4, 5, 7, 8]
+
+    def stop_at_5(x):
+        if x == 5:
+            raise ValueError('stop at 5')
+        return x % 2 == 0
+
+    try:
+        lst.remove_if(stop_at_5)
+    except ValueError as e:
+        print('remove_if raised', repr(e))
+    print('Items are', list(lst))
+    assert list(lst) == [1, 5, 7, 8]
+
+    def mutate(x):
+        lst.set(0, -1)
+        return True
+
+    try:
+        lst.remove_if(mutate)
+    except RuntimeError as e:
+        print('remove_if raised', repr(e))
+    print('Items are', list(lst))
+    assert list(lst) == [-1, 5, 7, 8]
+    print()
+
+for cls, items in [(Int64ArrayList, [3, -1, 2**62]),
+                   (Float64ArrayList, [0.5, -2.0, 1e300])]:
+    print(cls.__name__)
+    lst = cls.from_iterable(items, growable=True)
+    print('Items are', list(lst))
+    assert list(lst) == items
+    lst.insert(1, items[2])
+    lst.set(0, items[1])
+    lst.prepend(items[0])
+    print('Items are', list(lst))
+    assert list(lst) == [items[0], items[1], items[2], items[1], items[2]]
+    assert lst.remove(1) == items[1]
+    try:
+        lst.append('x')
+    except TypeError as e:
+        print('append raised', repr(e))
+    try:
+        lst.extend([items[0], 'x'])
+    except TypeError as e:
+        print('extend raised', repr(e))
+    assert list(lst) == [items[0], items[2], items[1], items[2]]
+    print()
+
+
+class Reentrant:
+    """Runs action on this list while it is being converted to int64."""
+
+    def __init__(self, action, value=7):
+        self.action = action
+        self.value = value
+
+    def __index__(self):
+        self.action()
+        return self.value
+
+
+ints = Int64ArrayList(2, growable=True)
+ints.extend([1, 2])
+ints.extend([Reentrant(lambda: ints.reserve(1 << 16)), 3])
+print('extend with a reserve() callback gives', list(ints))
+assert list(ints) == [1, 2, 7, 3]
+
+try:
+    ints.set(0, Reentrant(lambda: (ints.clear(), ints.shrink_to_fit())))
+except IndexError as e:
+    print('set raised', repr(e))
+assert list(ints) == []
+
+ints.extend([1, 2, 3])
+try:
+    ints.insert(1, Reentrant(ints.clear))
+except IndexError as e:
+    print('insert raised', repr(e))
+assert list(ints) == [] and ints.size() == 0
+print()
+
+print('ArrayList.insert_many and remove_range')
+arr = ArrayList.from_iterable(range(5), growable=True)
+arr.insert_many(2, [10, 11, 12])
+arr.insert_many(arr.size(), (20,))
+print('Items are', list(arr))
+assert list(arr) == [0, 1, 10, 11, 12, 2, 3, 4, 20]
+arr.remove_range(2, 5)
+print('Items are', list(arr))
+assert list(arr) == [0, 1, 2, 3, 4, 20]
+
+
+def clearing_items():
+    arr.clear()
+    yield 99
+
+
+try:
+    arr.insert_many(4, clearing_items())
+except IndexError as e:
+    print('insert_many raised', repr(e))
+print('Items are', list(arr))
+assert list(arr) == [] and arr.size() == 0
+print()
+
+print('Buffer protocol')
+ints = Int64ArrayList.from_iterable(range(10))
+view = memoryview(ints)
+print('Format is', view.format, 'and shape is', view.shape)
+assert view.format == 'q' and view.shape == (10,) and view.tolist() == list(range(10))
+view[3] = -3
+ints.set(4, -4)
+assert ints.get(3) == -3 and view[4] == -4
+for name, call in [('append', lambda: ints.append(1)),
+                   ('remove', lambda: ints.remove(0)),
+                   ('clear', ints.clear),
+                   ('__init__', lambda: ints.__init__(10))]:
+    try:
+        call()
+    except BufferError as e:
+        print(name, 'raised', repr(e))
+    else:
+        raise AssertionError(name + ' resized an exported list')
+assert ints.size() == 10 and ints.capacity() == 10
+view.release()
+ints.__init__(3)
+assert ints.size() == 0 and ints.capacity() == 3
+
+floats = Float64ArrayList.frombuffer(array.array('d', [1.5, -2.5]))
+assert list(floats) == [1.5, -2.5]
+ints = Int64ArrayList.frombuffer(array.array('q', [7, 8]).tobytes())
+assert list(ints) == [7, 8]
+try:
+    Int64ArrayList.frombuffer(array.array('d', [1.0]))
+except TypeError as e:
+    print('frombuffer raised', repr(e))
+else:
+    raise AssertionError('frombuffer accepted a float64 buffer')
+print()
+
+
+class Meddler:
+    """Runs action while being compared against a list's items."""
+
+    def __init__(self, action):
+        self.action = action
+
+    def __eq__(self, other):
+        self.action()
+        return False
+
+    __hash__ = None
+
+
+print('ArrayDeque')
+deq = ArrayDeque(4)
+for i in range(3):
+    deq.append(i)
+assert deq.pop_front() == 0
+deq.append(3)
+deq.prepend(-1)
+print('Items are', list(deq))
+assert list(deq) == [-1, 1, 2, 3]
+try:
+    deq.append(4)
+except RuntimeError as e:
+    print('append raised', repr(e))
+assert deq.pop_back() == 3 and deq.pop_front() == -1
+deq.insert(1, 9)
+deq.set(0, 8)
+assert list(deq) == [8, 9, 2] and deq.remove(1) == 9
+assert 2 in deq and 5 not in deq
+try:
+    Meddler(deq.clear) in deq
+except RuntimeError as e:
+    print('contains raised', repr(e))
+else:
+    raise AssertionError('contains ignored a mutation')
+assert list(deq) == []
+print()
+
+print('GapBufferList')
+gap = GapBufferList.from_iterable('abcde', growable=True)
+gap.move_cursor(2)
+gap.insert_at_cursor('X')
+gap.insert_at_cursor('Y')
+print('Items are', list(gap), 'and cursor is', gap.cursor())
+assert list(gap) == list('abXYcde') and gap.cursor() == 4
+assert gap.remove_before_cursor() == 'Y' and gap.remove_after_cursor() == 'c'
+assert list(gap) == list('abXde') and gap.cursor() == 3
+gap.move_cursor(gap.size())
+gap.insert(0, '<')
+gap.append('>')
+assert list(gap) == list('<abXde>') and gap.get(3) == 'X'
+try:
+    gap.move_cursor(gap.size() + 1)
+except IndexError as e:
+    print('move_cursor raised', repr(e))
+assert 'X' in gap and 'c' not in gap
+try:
+    Meddler(gap.clear) in gap
+except RuntimeError as e:
+    print('contains raised', repr(e))
+else:
+    raise AssertionError('contains ignored a mutation')
+assert list(gap) == [] and gap.cursor() == 0
+print()
+
+print('Node pools')
+before = _educollections.node_pool_stats()['SinglyLinkedListNode']
+chain = SinglyLinkedList1.from_iterable(range(100000))
+peak = _educollections.node_pool_stats()['SinglyLinkedListNode']
+del chain
+after = _educollections.node_pool_stats()['SinglyLinkedListNode']
+print('Slabs before, at peak and after are', before['slabs'], peak['slabs'],
+      after['slabs'], 'with', after['spare_slabs'], 'spare')
+assert peak['in_use'] == before['in_use'] + 100000
+assert after['in_use'] == before['in_use']
+assert after['slabs'] - after['spare_slabs'] <= before['slabs']
+assert after['slabs'] < peak['slabs'] // 4
+print()
+
+
+def exercise(lst, steps, seed):
+    """Applies steps random operations to lst and to a builtin list holding
+    the same items, checking after each that the two agree."""
+    rng = random.Random(seed)
+    model = list(lst)
+    for step in range(steps):
+        op = rng.randrange(8)
+        if op == 0:
+            lst.append(step)
+            model.append(step)
+        elif op == 1:
+            lst.prepend(step)
+            model.insert(0, step)
+        elif op == 2 and model:
+            i = rng.randrange(len(model))
+            lst.insert(i, step)
+            model.insert(i, step)
+        elif op == 3 and model:
+            i = rng.randrange(len(model))
+            assert lst.remove(i) == model.pop(i)
+        elif op == 4 and model:
+            i = rng.randrange(len(model))
+            lst.set(i, -step)
+            model[i] = -step
+        elif op == 5 and model:
+            i = rng.randrange(-len(model), len(model))
+            assert lst[i] == model[i] and lst.get(i % len(model)) == model[i]
+        elif op == 6:
+            i, j = sorted(rng.randrange(len(model) + 1) for _ in range(2))
+            assert list(lst[i:j]) == model[i:j]
+            assert list(lst[j:i:-1]) == model[j:i:-1]
+        elif op == 7 and model:
+            i = rng.randrange(len(model))
+            del lst[i]
+            del model[i]
+        assert lst.size() == len(lst) == len(model)
+    assert list(lst) == model
+    for i in (-1, len(model)):
+        try:
+            lst.get(i)
+        except IndexError:
+            pass
+        else:
+            raise AssertionError('get(%d) did not raise IndexError' % i)
+
+
+def check_search_guard(lst):
+    """Checks that a membership test stops when __eq__ clears lst."""
+    try:
+        Meddler(lst.clear) in lst
+    except RuntimeError as e:
+        print('contains raised', repr(e))
+    else:
+        raise AssertionError('contains ignored a mutation')
+    assert list(lst) == []
+
+
+print('DoublyLinkedList')
+dll = DoublyLinkedList.from_iterable(range(5))
+dll.prepend(-1)
+assert dll.remove(dll.size() - 1) == 4 and dll.remove(0) == -1
+print('Items are', list(dll))
+assert list(dll) == [0, 1, 2, 3]
+exercise(dll, 3000, 16)
+print('Items after random operations are', len(dll), 'long')
+check_search_guard(dll)
+print()
+
+print('UnrolledLinkedList')
+unrolled = UnrolledLinkedList.from_iterable(range(40))
+for i in range(0, 40, 3):
+    unrolled.insert(i, 'x')
+assert list(unrolled)[:4] == ['x', 0, 1, 'x'] and unrolled.size() == 54
+while unrolled.size() > 5:
+    unrolled.remove(unrolled.size() // 2)
+print('Items are', list(unrolled))
+exercise(unrolled, 3000, 6)
+print('Items after random operations are', len(unrolled), 'long')
+check_search_guard(unrolled)
+print()
+
+print('IndexableSkipList')
+for p in [0.25, 0.5, 0.75]:
+    skip = IndexableSkipList(p=p)
+    skip.extend(range(200))
+    assert [skip.get(i) for i in range(0, 200, 50)] == [0, 50, 100, 150]
+    exercise(skip, 2000, int(p * 100))
+    print('Items after random operations with p =', p, 'are', len(skip),
+          'long')
+for p in [0.0, 1.0]:
+    try:
+        IndexableSkipList(p=p)
+    except ValueError as e:
+        print('IndexableSkipList(p=%r) raised' % p, repr(e))
+    else:
+        raise AssertionError('IndexableSkipList accepted p=%r' % p)
+check_search_guard(skip)
+print()
+
+print('BTreeList')
+# Enough items for three levels, so splits and merges reach a branch.
+tree = BTreeList.from_iterable(range(5000))
+exercise(tree, 3000, 18)
+rng = random.Random(18)
+model = list(tree)
+while model:
+    i = rng.randrange(len(model))
+    assert tree.remove(i) == model.pop(i)
+    if len(model) % 97 == 0:
+        assert list(tree) == model
+print('Items after removing them all are', list(tree))
+tree.append(0)
+for i in range(1, 3000):
+    tree.insert(rng.randrange(tree.size()), i)
+assert sorted(tree) == list(range(3000))
+check_search_guard(tree)
+print()
+
+print('sort')
+for cls in [ArrayList, SinglyLinkedList1, SinglyLinkedList2]:
+    print(cls.__name__)
+    words = ['pear', 'fig', 'apple', 'kiwi', 'date', 'plum', 'lime']
+    lst = cls.from_iterable(words)
+    lst.sort()
+    assert list(lst) == sorted(words)
+    lst.sort(reverse=True)
+    assert list(lst) == sorted(words, reverse=True)
+    lst.remove(0)
+    lst.append('zucchini')
+    assert list(lst)[-2:] == ['apple', 'zucchini']
+    lst = cls.from_iterable(words)
+    lst.sort(key=len)
+    print('Sorted by length', list(lst))
+    assert list(lst) == sorted(words, key=len)
+    lst = cls.from_iterable(words)
+    lst.sort(key=len, reverse=True)
+    assert list(lst) == sorted(words, key=len, reverse=True)
+    lst = cls.from_iterable([(i % 3, i) for i in range(30)])
+    lst.sort(key=lambda pair: pair[0])
+    assert list(lst) == sorted(((i % 3, i) for i in range(30)),
+                               key=lambda pair: pair[0])
+    lst = cls.from_iterable(range(50))
+    lst.sort(key=lambda x: -x)
+    assert list(lst) == list(range(49, -1, -1))
+
+    def bad_key(x):
+        if x == 'kiwi':
+            raise KeyError(x)
+        return x
+
+    lst = cls.from_iterable(words)
+    try:
+        lst.sort(key=bad_key)
+    except KeyError as e:
+        print('sort raised', repr(e))
+    assert list(lst) == words
+
+    lst = cls.from_iterable([3, 'a', 1])
+    try:
+        lst.sort()
+    except TypeError as e:
+        print('sort raised', repr(e))
+    assert sorted(lst, key=str) == [1, 3, 'a'] and lst.size() == 3
+
+    def meddling_key(x):
+        lst.set(0, 9)
+        return x
+
+    lst = cls.from_iterable([2, 1])
+    try:
+        lst.sort(key=meddling_key)
+    except ValueError as e:
+        print('sort raised', repr(e))
+    else:
+        raise AssertionError('sort ignored a mutation')
+    assert list(lst) == [9, 1]
+    cls.from_iterable([]).sort()
+    print()
+
+print('Searching')
+for cls in [ArrayList, SinglyLinkedList1, SinglyLinkedList2]:
+    print(cls.__name__)
+    lst = cls.from_iterable([1, 2, 1, 3, 1])
+    assert lst.index_of(1) == 0 and lst.index_of(1, 1) == 2
+    assert lst.index_of(1, 3, 5) == 4 and lst.index_of(1, -2) == 4
+    assert lst.count(1) == 3 and lst.count(4) == 0
+    assert lst.contains(3) and not lst.contains(4)
+    try:
+        lst.index_of(3, 0, 3)
+    except ValueError as e:
+        print('index_of raised', repr(e))
+    else:
+        raise AssertionError('index_of searched past stop')
+    for method in ['index_of', 'count', 'contains']:
+        lst = cls.from_iterable(range(5))
+        try:
+            getattr(lst, method)(Meddler(lst.clear))
+        except (RuntimeError, ValueError) as e:
+            print(method, 'raised', repr(e))
+        assert list(lst) == []
+    print()
+
+
+class Clearing:
+    """Orders below everything, clearing lst when compared."""
+
+    def __lt__(self, other):
+        lst.clear()
+        return True
+
+    def __gt__(self, other):
+        lst.clear()
+        return False
+
+
+lst = ArrayList.from_iterable([1, 2, 2, 2, 5])
+assert lst.bisect_left(2) == 1 and lst.bisect_right(2) == 4
+assert lst.bisect_left(2, 2) == 2 and lst.bisect_right(2, 0, 2) == 2
+assert lst.bisect_left(0) == 0 and lst.bisect_right(9) == 5
+print('bisect with a clearing comparison returns',
+      lst.bisect_left(Clearing()))
+assert list(lst) == []
+print()
+
+print('SinglyLinkedList2 splicing')
+lst = SinglyLinkedList2.from_iterable(range(5))
+other = SinglyLinkedList2.from_iterable('ab')
+lst.splice(other, 2)
+assert list(lst) == [0, 1, 'a', 'b', 2, 3, 4] and list(other) == []
+lst.splice(SinglyLinkedList2.from_iterable('c'), 0)
+lst.splice(SinglyLinkedList2.from_iterable('d'))
+assert list(lst) == ['c', 0, 1, 'a', 'b', 2, 3, 4, 'd']
+assert [lst.get(i) for i in range(3)] == ['c', 0, 1]
+other = SinglyLinkedList2.from_iterable('ef')
+lst.concat(other)
+assert lst.get(2) == 1 and lst.get(9) == 'e' and other.size() == 0
+other.append('g')
+assert list(other) == ['g']
+rest = lst.split_at(4)
+print('Split into', list(lst), 'and', list(rest))
+assert list(lst) == ['c', 0, 1, 'a'] and lst.size() == 4
+assert list(rest) == ['b', 2, 3, 4, 'd', 'e', 'f'] and rest.size() == 7
+lst.append('h')
+rest.append('i')
+assert list(lst)[-1] == 'h' and list(rest)[-1] == 'i'
+assert list(lst.split_at(lst.size())) == [] and lst.size() == 5
+everything = lst.split_at(0)
+assert list(lst) == [] and list(everything) == ['c', 0, 1, 'a', 'h']
+lst.append('j')
+assert list(lst) == ['j']
+rest.reverse()
+assert list(rest) == ['i', 'f', 'e', 'd', 4, 3, 2, 'b']
+rest.append('k')
+assert list(rest)[-2:] == ['b', 'k']
+for bad in [lambda: rest.splice(rest), lambda: rest.concat(rest),
+            lambda: rest.splice([1]), lambda: rest.split_at(-1),
+            lambda: rest.split_at(rest.size() + 1)]:
+    try:
+        bad()
+    except (ValueError, TypeError, IndexError) as e:
+        print('raised', repr(e))
+    else:
+        raise AssertionError('bad splice was accepted')
+assert rest.size() == 9
+arr = ArrayList.from_iterable(range(6))
+arr.reverse()
+assert list(arr) == [5, 4, 3, 2, 1, 0]
+ArrayList.from_iterable([]).reverse()
+print()
+
+
+def make(cls, items=()):
+    """Returns a new growable cls holding items."""
+    if hasattr(cls, 'capacity'):
+        return cls.from_iterable(items, growable=True)
+    return cls.from_iterable(items)
+
+
+LIST_TYPES = [getattr(educollections, name)
+              for name in educollections.__all__ if name != 'List']
+OBJECT_LIST_TYPES = [cls for cls in LIST_TYPES
+                     if cls not in (Int64ArrayList, Float64ArrayList)]
+
+
+class Canary:
+    pass
+
+
+class Peeker:
+    """Reads the list holding it when released."""
+
+    seen = []
+
+    def __init__(self, lst):
+        self.lst = lst
+
+    def __del__(self):
+        Peeker.seen.append(len(list(self.lst)))
+
+
+print('Garbage collection')
+for cls in OBJECT_LIST_TYPES:
+    subclass = type('Sub' + cls.__name__, (cls,), {})
+    for cycle in ['self', 'iterator']:
+        lst = make(subclass, range(100))
+        canary = Canary()
+        alive = weakref.ref(canary)
+        lst.append(canary)
+        if cycle == 'self':
+            lst.append(lst)
+        else:
+            lst.append(iter(lst))
+        del lst, canary
+        gc.collect()
+        assert alive() is None, (cls.__name__, cycle)
+    lst = make(cls, range(50))
+    for i in range(0, 50, 10):
+        lst.insert(i, Peeker(lst))
+    del lst
+    gc.collect()
+    assert len(Peeker.seen) == 5
+    del Peeker.seen[:]
+    print(cls.__name__, 'cycles are collected')
+    assert gc.is_tracked(make(cls)) and gc.is_tracked(iter(make(cls)))
+print()
+
+print('Operation counters')
+# Building with EDUCOLLECTIONS_STATS=0 compiles the counters out.
+if hasattr(SinglyLinkedList1, 'stats'):
+    for cls in LIST_TYPES:
+        lst = make(cls, range(1000))
+        assert set(lst.stats()) == {'walked', 'shifted', 'allocs', 'frees',
+                                    'peak_size'}
+        lst.reset_stats()
+        assert lst.stats() == {'walked': 0, 'shifted': 0, 'allocs': 0,
+                               'frees': 0, 'peak_size': 1000}
+        lst.get(300)
+        walked = lst.stats()['walked']
+        lst.reset_stats()
+        lst.insert(1, 1)
+        shifted = lst.stats()['shifted']
+        print('%-18s get(300) walked %3d, insert(1, x) shifted %3d'
+              % (cls.__name__, walked, shifted))
+        if cls in (ArrayList, Int64ArrayList, Float64ArrayList):
+            assert walked == 0 and shifted == 999
+        elif cls in (SinglyLinkedList1, SinglyLinkedList2, DoublyLinkedList):
+            assert walked == 300 and shifted == 0
+        elif cls in (IndexableSkipList, BTreeList):
+            assert 0 < walked < 100
+        for i in range(500):
+            lst.remove(0)
+        assert lst.stats()['peak_size'] == 1001
+        lst = make(cls)
+        lst.extend(range(5000))
+        for i in range(0, 5000, 7):
+            lst.remove(lst.size() // 2)
+        lst.clear()
+        stats = lst.stats()
+        assert stats['peak_size'] == 5000 and stats['allocs'] > 0
+        if not hasattr(cls, 'capacity'):
+            # Everything a linked list allocated has been freed, bar the
+            # node an empty BTreeList keeps as its root.
+            assert 0 <= stats['allocs'] - stats['frees'] <= 1, stats
+print()
+
+print('Iterators')
+for cls in LIST_TYPES:
+    items = [float(i) if cls is Float64ArrayList else i for i in range(300)]
+    lst = make(cls, items)
+    assert list(lst) == items and list(iter(lst)) == items
+    it = iter(lst)
+    assert iter(it) is it and next(it) == items[0]
+    del lst
+    assert list(it) == items[1:]
+    for mutate in [lambda lst: lst.append(1), lambda lst: lst.set(0, 2),
+                   lambda lst: lst.remove(0), lambda lst: lst.clear()]:
+        lst = make(cls, items)
+        it = iter(lst)
+        next(it)
+        mutate(lst)
+        try:
+            next(it)
+        except RuntimeError:
+            pass
+        else:
+            raise AssertionError(cls.__name__ + ' iterator missed a mutation')
+        assert list(it) == []
+    lst = make(cls, items[:3])
+    it = iter(lst)
+    assert list(it) == items[:3]
+    lst.append(1)
+    assert list(it) == []
+    print(cls.__name__, 'iterators are fail-fast')
+print()